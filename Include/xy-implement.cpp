@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2021 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * Compiles the implementation of xy on its own, so that it can be built once into a static library and shared by every target.
+ * Add this file to a build instead of defining XY_IMPLEMENT in one of the app's own source files.
+ * The platform headers (windows.h, Cocoa, JNI) are only parsed here.
+ */
+
+#define XY_IMPLEMENT
+#include "xy.h"
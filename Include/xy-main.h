@@ -39,19 +39,18 @@ extern int xyMain( void );
 #if defined( XY_OS_WINDOWS )
 
 #include <windows.h>
-#include <clocale>
 
 int main( int ArgC, char** ppArgV )
 {
 	xyContext& rContext      = xyGetContext();
 	rContext.CommandLineArgs = std::span< char* >( ppArgV, ArgC );
 	rContext.pPlatformImpl   = std::make_unique< xyPlatformImpl >();
-	rContext.UIMode          = XY_UI_MODE_DESKTOP;
+	rContext.UIMode          = xyPlatform::SingleUIMode ? xyPlatform::SupportedUIModes : XY_UI_MODE_DESKTOP;
 
 	// Store the handle to the application instance
 	rContext.pPlatformImpl->ApplicationInstanceHandle = GetModuleHandle( NULL );
 
-	std::setlocale( LC_ALL, "en_US.utf8" );
+	xyMarkStartupPhase( "xyMain" );
 
 	return xyMain();
 
@@ -62,12 +61,12 @@ INT WINAPI WinMain( _In_ HINSTANCE Instance, _In_opt_ HINSTANCE /*PrevInstance*/
 	xyContext& rContext      = xyGetContext();
 	rContext.CommandLineArgs = std::span< char* >( __argv, __argc );
 	rContext.pPlatformImpl   = std::make_unique< xyPlatformImpl >();
-	rContext.UIMode          = XY_UI_MODE_DESKTOP;
+	rContext.UIMode          = xyPlatform::SingleUIMode ? xyPlatform::SupportedUIModes : XY_UI_MODE_DESKTOP;
 
 	// Store the handle to the application instance
 	rContext.pPlatformImpl->ApplicationInstanceHandle = Instance;
 
-	std::setlocale( LC_ALL, "en_US.utf8" );
+	xyMarkStartupPhase( "xyMain" );
 
 	return xyMain();
 
@@ -75,15 +74,13 @@ INT WINAPI WinMain( _In_ HINSTANCE Instance, _In_opt_ HINSTANCE /*PrevInstance*/
 
 #elif defined( XY_OS_MACOS ) // XY_OS_WINDOWS
 
-#include <locale.h>
-
 int main( int ArgC, char** ppArgV )
 {
 	xyContext& rContext      = xyGetContext();
 	rContext.CommandLineArgs = std::span< char* >( ppArgV, ArgC );
-	rContext.UIMode          = XY_UI_MODE_DESKTOP;
+	rContext.UIMode          = xyPlatform::SingleUIMode ? xyPlatform::SupportedUIModes : XY_UI_MODE_DESKTOP;
 
-	setlocale( LC_CTYPE, "UTF-8" );
+	xyMarkStartupPhase( "xyMain" );
 
 	return xyMain();
 
@@ -102,21 +99,18 @@ int main( int ArgC, char** ppArgV )
 
 	// Store the activity data
 	rContext.pPlatformImpl->pNativeActivity = pActivity;
+	rContext.pPlatformImpl->JavaThreadID    = xyGetThreadID();
 
 	// Obtain the configuration
 	rContext.pPlatformImpl->pConfiguration = AConfiguration_new();
 	AConfiguration_fromAssetManager( rContext.pPlatformImpl->pConfiguration, rContext.pPlatformImpl->pNativeActivity->assetManager );
+	xyMarkStartupPhase( "Configuration" );
 
 	// Obtain the UI mode
-	switch( AConfiguration_getUiModeType( rContext.pPlatformImpl->pConfiguration ) )
-	{
-		case ACONFIGURATION_UI_MODE_TYPE_CAR:        { rContext.UIMode = XY_UI_MODE_CAR;      } break;
-		case ACONFIGURATION_UI_MODE_TYPE_TELEVISION: { rContext.UIMode = XY_UI_MODE_TV;       } break;
-		case ACONFIGURATION_UI_MODE_TYPE_APPLIANCE:  { rContext.UIMode = XY_UI_MODE_HEADLESS; } break;
-		case ACONFIGURATION_UI_MODE_TYPE_WATCH:      { rContext.UIMode = XY_UI_MODE_WATCH;    } break;
-		case ACONFIGURATION_UI_MODE_TYPE_VR_HEADSET: { rContext.UIMode = XY_UI_MODE_VR;       } break;
-		default:                                     { rContext.UIMode = XY_UI_MODE_PHONE;    } break; // Default to phone UI
-	}
+	rContext.UIMode = xyGetUIMode( rContext.pPlatformImpl->pConfiguration );
+
+	// Keep the configuration up to date and notify subscribers when it changes
+	pActivity->callbacks->onConfigurationChanged = &xyOnConfigurationChanged;
 
 	// Obtain the looper for the main thread
 	ALooper* pMainLooper = ALooper_forThread();
@@ -129,15 +123,18 @@ int main( int ArgC, char** ppArgV )
 		xyRunnable* pRunnable;
 		if( read( Read, &pRunnable, sizeof( pRunnable ) ) == sizeof( pRunnable ) )
 		{
-			pRunnable->Execute();
+			// Null runnables are pings from the watchdog
+			if( pRunnable ) pRunnable->Execute();
+			else            xyGetContext().pPlatformImpl->JavaThreadBeat.store( 1, std::memory_order_relaxed );
 		}
 
 		// Keep listening
 		return 1;
 
 	}, nullptr );
+	xyMarkStartupPhase( "Looper" );
 
-	std::thread AppThread( &xyMain );
+	std::thread AppThread( []{ xyMarkStartupPhase( "xyMain" ); xyMain(); } );
 	AppThread.detach();
 
 } // ANativeActivity_onCreate
@@ -166,8 +163,9 @@ int main( int ArgC, char** ppArgV )
 	xyViewController* pViewController = [ [ xyViewController alloc ] init ];
 	pWindow.rootViewController        = pViewController;
 	[ pWindow makeKeyAndVisible ];
+	xyMarkStartupPhase( "Window" );
 
-	std::thread Thread( &xyMain );
+	std::thread Thread( []{ xyMarkStartupPhase( "xyMain" ); xyMain(); } );
 	Thread.detach();
 
 } // didFinishLaunchingWithOptions
@@ -178,9 +176,7 @@ int main( int ArgC, char** ppArgV )
 {
 	xyContext& rContext      = xyGetContext();
 	rContext.CommandLineArgs = std::span< char* >( ppArgV, ArgC );
-	rContext.UIMode          = XY_UI_MODE_PHONE;
-
-	setlocale( LC_CTYPE, "UTF-8" );
+	rContext.UIMode          = xyPlatform::SingleUIMode ? xyPlatform::SupportedUIModes : XY_UI_MODE_PHONE;
 
 	@autoreleasepool
 	{
@@ -195,7 +191,9 @@ int main( int ArgC, char** ppArgV )
 {
 	xyContext& rContext      = xyGetContext();
 	rContext.CommandLineArgs = std::span< char* >( ppArgV, ArgC );
-	rContext.UIMode          = XY_UI_MODE_HEADLESS; // We don't know the UI mode. Might as well assume the worst.
+	rContext.UIMode          = xyPlatform::SingleUIMode ? xyPlatform::SupportedUIModes : XY_UI_MODE_HEADLESS; // Unless the build says otherwise, we don't know the UI mode. Might as well assume the worst.
+
+	xyMarkStartupPhase( "xyMain" );
 
 	return xyMain();
 
@@ -22,21 +22,29 @@
 //////////////////////////////////////////////////////////////////////////
 /// Android-specific includes
 
+#include <atomic>
+#include <mutex>
 #include <thread>
 #include <tuple>
 
 #include <android/configuration.h>
 #include <android/native_activity.h>
 
+#include "xy-jni.h"
+
 
 //////////////////////////////////////////////////////////////////////////
 /// Android-specific data structures
 
 struct xyPlatformImpl
 {
-	ANativeActivity* pNativeActivity     = nullptr;
-	AConfiguration*  pConfiguration      = nullptr;
-	int              JavaThreadPipe[ 2 ] = { };
+	ANativeActivity*        pNativeActivity     = nullptr;
+	AConfiguration*         pConfiguration      = nullptr;
+	int                     JavaThreadPipe[ 2 ] = { };
+	uint32_t                JavaThreadID        = 0;
+	std::atomic< uint32_t > JavaThreadBeat      = 0;
+	xyJNICache              JNICache;
+	std::once_flag          JNICacheFlag;
 
 }; // xyPlatformImpl
 
@@ -49,6 +57,50 @@ struct xyRunnable
 }; // xyRunnable
 
 
+//////////////////////////////////////////////////////////////////////////
+/// Android-specific functions
+
+/**
+ * Obtains the JNI environment of the calling thread, attaching the thread to the Java VM on first use.
+ * The thread stays attached until it exits, so local references must be released with PushLocalFrame and PopLocalFrame.
+ *
+ * @return The JNI environment.
+ */
+extern JNIEnv* xyGetJNIEnv( void );
+
+/**
+ * Obtains the global class references, method IDs and field IDs used by xy, looking them all up on first use.
+ * Members that do not exist on the running API level are null.
+ *
+ * @return The cache.
+ */
+extern const xyJNICache& xyGetJNICache( void );
+
+/**
+ * Translates the UI mode type of a configuration into one of the XY_UI_MODE_* flags.
+ *
+ * @param pConfiguration The configuration.
+ * @return The UI mode.
+ */
+extern uint32_t xyGetUIMode( AConfiguration* pConfiguration );
+
+/**
+ * Refreshes the configuration and posts the changes to the configuration bus.
+ * Installed as the onConfigurationChanged callback of the native activity.
+ *
+ * @param pActivity The native activity.
+ */
+extern void xyOnConfigurationChanged( ANativeActivity* pActivity );
+
+/**
+ * Registers the java thread with the watchdog. Since the java thread runs a looper that xy does not control, the watchdog pings it through the looper and treats the reply as its heartbeat.
+ *
+ * @param Deadline How long the java thread may go without servicing the looper before it is considered stalled.
+ * @return The heartbeat, which unregisters the java thread when it is destroyed.
+ */
+extern xyWatchdogHeartbeat xyWatchJavaThread( std::chrono::milliseconds Deadline );
+
+
 //////////////////////////////////////////////////////////////////////////
 /// Android-specific template functions
 
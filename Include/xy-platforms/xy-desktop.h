@@ -17,11 +17,19 @@
 
 #pragma once
 
-#if XY_UI_MODES & XY_UI_MODE_DESKTOP
+// Headless builds for desktop platforms keep the pointer event queue, since it captures from evdev and replays recordings without a display
+#if XY_PLATFORM_UI_MODES & XY_UI_MODE_DESKTOP
 
 //////////////////////////////////////////////////////////////////////////
 /// Desktop-specific includes
 
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <future>
+#include <span>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 #if defined( XY_OS_WINDOWS )
@@ -29,12 +37,35 @@
 #elif defined( XY_OS_MACOS ) // XY_OS_WINDOWS
 #include <Cocoa/Cocoa.h>
 #include <Foundation/Foundation.h>
-#endif // XY_OS_MACOS
+#elif defined( XY_OS_LINUX ) // XY_OS_MACOS
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif // XY_OS_LINUX
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Desktop-specific enumerators
+
+enum class xyPointerEventType : uint8_t
+{
+	Move,
+	ButtonDown,
+	ButtonUp,
+	Wheel,
+
+}; // xyPointerEventType
 
 
 //////////////////////////////////////////////////////////////////////////
 /// Desktop-specific data structures
 
+#if XY_UI_MODES & XY_UI_MODE_DESKTOP
+
 struct xyMouse
 {
 	operator bool( void ) const { return Active; } // Allows `if(auto m = xyGetMouse()) {...}`
@@ -45,10 +76,24 @@ struct xyMouse
 
 }; // xyMouse
 
+#endif // XY_UI_MODES & XY_UI_MODE_DESKTOP
+
+struct xyPointerEvent
+{
+	int64_t            Timestamp = 0; // Nanoseconds on the steady clock, taken when the device reported the event
+	int32_t            DeltaX    = 0; // Relative motion in device units for Move, and in notches for Wheel
+	int32_t            DeltaY    = 0;
+	uint32_t           Button    = 0; // 0 is the primary button, 1 the secondary, 2 the middle and 3-4 the side buttons
+	xyPointerEventType Type      = xyPointerEventType::Move;
+
+}; // xyPointerEvent
+
 
 //////////////////////////////////////////////////////////////////////////
 /// Desktop-specific functions
 
+#if XY_UI_MODES & XY_UI_MODE_DESKTOP
+
 /*
  * Obtain the desktop mouse pointer.
  *
@@ -56,6 +101,41 @@ struct xyMouse
  */
 extern xyMouse xyGetMouse( void );
 
+#endif // XY_UI_MODES & XY_UI_MODE_DESKTOP
+
+/**
+ * Starts capturing pointer events at the rate that the devices report them, on a background thread.
+ * Events are read from raw input on Windows and from evdev on Linux, which requires read access to /dev/input.
+ * Alternatively, events can be replayed from a file written by xyRecordInputEvents, which works on any platform and without a display.
+ *
+ * @param ReplayPath The recording to replay, or an empty string to capture live events.
+ * @param RealTime Whether a replay keeps the original pacing. Otherwise every event is delivered as soon as there is room for it.
+ * @return True if capturing was started.
+ */
+extern bool xyStartInputCapture( std::string_view ReplayPath = { }, bool RealTime = true );
+
+/**
+ * Stops capturing pointer events. Events that have not been polled yet are discarded.
+ */
+extern void xyStopInputCapture( void );
+
+/**
+ * Drains all pointer events that have been captured since the last call, in the order they occurred.
+ * Meant to be called once per frame. The storage is reused, so the events are only valid until the next call.
+ *
+ * @param Coalesce Whether to merge consecutive motion events, and consecutive wheel events, into one. Button events are never merged.
+ * @return The events of this frame.
+ */
+extern std::span< const xyPointerEvent > xyPollInputEvents( bool Coalesce = false );
+
+/**
+ * Starts writing every event returned by xyPollInputEvents to a file, before coalescing.
+ *
+ * @param Path The file to write to, or an empty string to stop recording.
+ * @return True if recording was started.
+ */
+extern bool xyRecordInputEvents( std::string_view Path );
+
 
 //////////////////////////////////////////////////////////////////////////
 /*
@@ -72,6 +152,8 @@ extern xyMouse xyGetMouse( void );
 //////////////////////////////////////////////////////////////////////////
 /// Desktop-specific functions
 
+#if XY_UI_MODES & XY_UI_MODE_DESKTOP
+
 xyMouse xyGetMouse( void )
 {
 
@@ -91,11 +173,459 @@ xyMouse xyGetMouse( void )
 
 	return { .X=MouseLocation.x, .Y=MouseLocation.y, .Active=true };
 
-#endif // XY_OS_MACOS
+#else // XY_OS_MACOS
+
+	// Without a display server connection there is no cursor to ask for
+	return { .Active=false };
+
+#endif // !XY_OS_WINDOWS && !XY_OS_MACOS
 
 } // xyGetMouse
 
+#endif // XY_UI_MODES & XY_UI_MODE_DESKTOP
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyInputCapture
+{
+	static constexpr size_t   RingSize    = 4096;
+	static constexpr uint32_t FileMagic   = 0x4E495958; // "XYIN"
+	static constexpr uint32_t FileVersion = 1;
+
+	~xyInputCapture( void ) { Stop(); if( pRecording ) std::fclose( pRecording ); }
+
+	bool Push     ( const xyPointerEvent& rEvent );
+	void Stop     ( void );
+	void Replay   ( std::FILE* pFile, bool RealTime, std::promise< bool >& rStarted );
+	void Capture  ( std::promise< bool >& rStarted );
+
+	std::array< xyPointerEvent, RingSize > Ring;
+	alignas( 64 ) std::atomic< uint64_t >  Head       = 0; // Written by the polling thread
+	alignas( 64 ) std::atomic< uint64_t >  Tail       = 0; // Written by the capture thread
+	std::atomic< bool >                    Running    = false;
+	std::mutex                             StopMutex;
+	std::condition_variable                StopRequested; // Wakes a paced replay as soon as it is stopped
+	std::thread                            Thread;
+	std::vector< xyPointerEvent >          Frame;
+	std::FILE*                             pRecording = nullptr;
+
+#if defined( XY_OS_WINDOWS )
+	DWORD                                  ThreadId   = 0;
+#elif defined( XY_OS_LINUX ) // XY_OS_WINDOWS
+	int                                    StopEvent  = -1;
+#endif // XY_OS_LINUX
+
+}; // xyInputCapture
+
+//////////////////////////////////////////////////////////////////////////
+
+static xyInputCapture& xyGetInputCapture( void )
+{
+	static xyInputCapture InputCapture;
+	return InputCapture;
+
+} // xyGetInputCapture
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyInputCapture::Push( const xyPointerEvent& rEvent )
+{
+	const uint64_t Index = Tail.load( std::memory_order_relaxed );
+	if( Index - Head.load( std::memory_order_acquire ) == RingSize )
+		return false;
+
+	Ring[ Index % RingSize ] = rEvent;
+	Tail.store( Index + 1, std::memory_order_release );
+
+	return true;
+
+} // Push
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyInputCapture::Stop( void )
+{
+	if( !Thread.joinable() )
+		return;
+
+	{
+		std::lock_guard Lock( StopMutex );
+		Running.store( false, std::memory_order_relaxed );
+	}
+
+	StopRequested.notify_all();
+
+#if defined( XY_OS_WINDOWS )
+	if( ThreadId )
+		PostThreadMessageW( ThreadId, WM_QUIT, 0, 0 );
+#elif defined( XY_OS_LINUX ) // XY_OS_WINDOWS
+	if( StopEvent >= 0 )
+		eventfd_write( StopEvent, 1 );
+#endif // XY_OS_LINUX
+
+	Thread.join();
+
+#if defined( XY_OS_WINDOWS )
+	ThreadId = 0;
+#elif defined( XY_OS_LINUX ) // XY_OS_WINDOWS
+	if( StopEvent >= 0 )
+		close( StopEvent );
+	StopEvent = -1;
+#endif // XY_OS_LINUX
+
+	Head.store( Tail.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+
+} // Stop
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyInputCapture::Replay( std::FILE* pFile, bool RealTime, std::promise< bool >& rStarted )
+{
+	uint32_t Header[ 4 ];
+	if( std::fread( Header, sizeof( Header ), 1, pFile ) != 1 || Header[ 0 ] != FileMagic || Header[ 1 ] != FileVersion || Header[ 2 ] != sizeof( xyPointerEvent ) )
+	{
+		std::fclose( pFile );
+		rStarted.set_value( false );
+		return;
+	}
+
+	rStarted.set_value( true );
+
+	const auto     Start          = std::chrono::steady_clock::now();
+	const int64_t  StartTimestamp = std::chrono::duration_cast< std::chrono::nanoseconds >( Start.time_since_epoch() ).count();
+	int64_t        FirstTimestamp = -1;
+	xyPointerEvent Event;
+
+	while( Running.load( std::memory_order_relaxed ) && std::fread( &Event, sizeof( Event ), 1, pFile ) == 1 )
+	{
+		// Shift the recording onto the current clock
+		if( FirstTimestamp < 0 )
+			FirstTimestamp = Event.Timestamp;
+
+		const int64_t Elapsed = Event.Timestamp - FirstTimestamp;
+		Event.Timestamp       = StartTimestamp + Elapsed;
+
+		if( RealTime )
+		{
+			std::unique_lock Lock( StopMutex );
+			if( StopRequested.wait_until( Lock, Start + std::chrono::nanoseconds( Elapsed ), [ this ] { return !Running.load( std::memory_order_relaxed ); } ) )
+				break;
+		}
+
+		while( !Push( Event ) && Running.load( std::memory_order_relaxed ) )
+			std::this_thread::yield();
+	}
+
+	std::fclose( pFile );
+
+} // Replay
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyInputCapture::Capture( std::promise< bool >& rStarted )
+{
+
+#if defined( XY_OS_WINDOWS )
+
+	// Raw input is delivered to a window, so create an invisible message-only one on this thread
+	const WNDCLASSEXW WindowClass = { .cbSize=sizeof( WNDCLASSEXW ), .lpfnWndProc=DefWindowProcW, .hInstance=GetModuleHandleW( NULL ), .lpszClassName=L"xyRawInput" };
+	RegisterClassExW( &WindowClass );
+
+	HWND                  Window = CreateWindowExW( 0, WindowClass.lpszClassName, NULL, 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, WindowClass.hInstance, NULL );
+	const RAWINPUTDEVICE  Device = { .usUsagePage=0x01, .usUsage=0x02, .dwFlags=RIDEV_INPUTSINK, .hwndTarget=Window }; // Generic desktop page, mouse usage
+
+	if( Window == NULL || !RegisterRawInputDevices( &Device, 1, sizeof( Device ) ) )
+	{
+		if( Window )
+			DestroyWindow( Window );
+
+		rStarted.set_value( false );
+		return;
+	}
+
+	ThreadId = GetCurrentThreadId();
+	rStarted.set_value( true );
+
+	std::vector< BYTE > Buffer;
+	MSG                 Message;
+
+	while( GetMessageW( &Message, NULL, 0, 0 ) > 0 )
+	{
+		if( Message.message != WM_INPUT )
+		{
+			DispatchMessageW( &Message );
+			continue;
+		}
+
+		const int64_t Timestamp = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+		UINT          Size      = 0;
+
+		GetRawInputData( ( HRAWINPUT )Message.lParam, RID_INPUT, NULL, &Size, sizeof( RAWINPUTHEADER ) );
+		Buffer.resize( Size );
+
+		if( GetRawInputData( ( HRAWINPUT )Message.lParam, RID_INPUT, Buffer.data(), &Size, sizeof( RAWINPUTHEADER ) ) != Size )
+			continue;
+
+		const RAWINPUT& rInput = *reinterpret_cast< const RAWINPUT* >( Buffer.data() );
+		if( rInput.header.dwType != RIM_TYPEMOUSE )
+			continue;
+
+		const RAWMOUSE& rMouse = rInput.data.mouse;
+
+		if( !( rMouse.usFlags & MOUSE_MOVE_ABSOLUTE ) && ( rMouse.lLastX || rMouse.lLastY ) )
+			Push( { .Timestamp=Timestamp, .DeltaX=rMouse.lLastX, .DeltaY=rMouse.lLastY, .Type=xyPointerEventType::Move } );
+
+		// Each button has a down flag followed by an up flag, starting with the primary button
+		for( uint32_t Button = 0; Button < 5; ++Button )
+		{
+			if( rMouse.usButtonFlags & ( 1 << ( Button * 2 ) ) )     Push( { .Timestamp=Timestamp, .Button=Button, .Type=xyPointerEventType::ButtonDown } );
+			if( rMouse.usButtonFlags & ( 1 << ( Button * 2 + 1 ) ) ) Push( { .Timestamp=Timestamp, .Button=Button, .Type=xyPointerEventType::ButtonUp } );
+		}
+
+		if( rMouse.usButtonFlags & RI_MOUSE_WHEEL )  Push( { .Timestamp=Timestamp, .DeltaY=static_cast< SHORT >( rMouse.usButtonData ) / WHEEL_DELTA, .Type=xyPointerEventType::Wheel } );
+		if( rMouse.usButtonFlags & RI_MOUSE_HWHEEL ) Push( { .Timestamp=Timestamp, .DeltaX=static_cast< SHORT >( rMouse.usButtonData ) / WHEEL_DELTA, .Type=xyPointerEventType::Wheel } );
+	}
+
+	const RAWINPUTDEVICE Remove = { .usUsagePage=0x01, .usUsage=0x02, .dwFlags=RIDEV_REMOVE, .hwndTarget=NULL };
+	RegisterRawInputDevices( &Remove, 1, sizeof( Remove ) );
+	DestroyWindow( Window );
+
+#elif defined( XY_OS_LINUX ) // XY_OS_WINDOWS
+
+	struct Device
+	{
+		int     File   = -1;
+		int32_t DeltaX = 0;
+		int32_t DeltaY = 0;
+
+	}; // Device
+
+	std::vector< Device > Devices;
+
+	// Open every device that reports relative motion, which is what mice do
+	if( DIR* pDirectory = opendir( "/dev/input" ) )
+	{
+		while( dirent* pEntry = readdir( pDirectory ) )
+		{
+			if( std::string_view( pEntry->d_name ).substr( 0, 5 ) != "event" )
+				continue;
+
+			const std::string Path = std::string( "/dev/input/" ) + pEntry->d_name;
+			const int         File = open( Path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC );
+			if( File < 0 )
+				continue;
+
+			unsigned long RelativeBits = 0;
+			if( ioctl( File, EVIOCGBIT( EV_REL, sizeof( RelativeBits ) ), &RelativeBits ) < 0 || !( RelativeBits & ( 1ul << REL_X ) ) )
+			{
+				close( File );
+				continue;
+			}
+
+			// Match the timestamps to the steady clock
+			int ClockId = CLOCK_MONOTONIC;
+			ioctl( File, EVIOCSCLOCKID, &ClockId );
+
+			Devices.push_back( { .File=File } );
+		}
+
+		closedir( pDirectory );
+	}
+
+	StopEvent = eventfd( 0, EFD_CLOEXEC );
+
+	if( Devices.empty() || StopEvent < 0 )
+	{
+		for( Device& rDevice : Devices )
+			close( rDevice.File );
+
+		rStarted.set_value( false );
+		return;
+	}
+
+	rStarted.set_value( true );
+
+	std::vector< pollfd > PollFiles;
+	for( Device& rDevice : Devices )
+		PollFiles.push_back( { .fd=rDevice.File, .events=POLLIN, .revents=0 } );
+	PollFiles.push_back( { .fd=StopEvent, .events=POLLIN, .revents=0 } );
+
+	input_event Events[ 64 ];
+
+	while( Running.load( std::memory_order_relaxed ) && poll( PollFiles.data(), PollFiles.size(), -1 ) >= 0 )
+	{
+		for( size_t i = 0; i < Devices.size(); ++i )
+		{
+			if( !( PollFiles[ i ].revents & POLLIN ) )
+				continue;
+
+			Device& rDevice = Devices[ i ];
+			ssize_t Size;
+
+			while( ( Size = read( rDevice.File, Events, sizeof( Events ) ) ) > 0 )
+			{
+				for( const input_event& rEvent : std::span( Events, Size / sizeof( input_event ) ) )
+				{
+					const int64_t Timestamp = static_cast< int64_t >( rEvent.input_event_sec ) * 1000000000 + static_cast< int64_t >( rEvent.input_event_usec ) * 1000;
+
+					switch( rEvent.type )
+					{
+						case EV_REL:
+						{
+							switch( rEvent.code )
+							{
+								case REL_X:      rDevice.DeltaX += rEvent.value; break;
+								case REL_Y:      rDevice.DeltaY += rEvent.value; break;
+								case REL_WHEEL:  Push( { .Timestamp=Timestamp, .DeltaY=rEvent.value, .Type=xyPointerEventType::Wheel } ); break;
+								case REL_HWHEEL: Push( { .Timestamp=Timestamp, .DeltaX=rEvent.value, .Type=xyPointerEventType::Wheel } ); break;
+							}
+						} break;
+
+						case EV_KEY:
+						{
+							if( rEvent.code >= BTN_LEFT && rEvent.code <= BTN_EXTRA && rEvent.value != 2 )
+							{
+								// BTN_LEFT, BTN_RIGHT and BTN_MIDDLE are already in the order used by xyPointerEvent
+								Push( { .Timestamp=Timestamp, .Button=static_cast< uint32_t >( rEvent.code - BTN_LEFT ), .Type=rEvent.value ? xyPointerEventType::ButtonDown : xyPointerEventType::ButtonUp } );
+							}
+						} break;
+
+						case EV_SYN:
+						{
+							// The axes of one motion are reported separately and terminated by a sync event
+							if( rEvent.code == SYN_REPORT && ( rDevice.DeltaX || rDevice.DeltaY ) )
+							{
+								Push( { .Timestamp=Timestamp, .DeltaX=rDevice.DeltaX, .DeltaY=rDevice.DeltaY, .Type=xyPointerEventType::Move } );
+								rDevice.DeltaX = 0;
+								rDevice.DeltaY = 0;
+							}
+						} break;
+					}
+				}
+			}
+		}
+	}
+
+	for( Device& rDevice : Devices )
+		close( rDevice.File );
+
+#else // XY_OS_LINUX
+
+	rStarted.set_value( false );
+
+#endif // !XY_OS_WINDOWS && !XY_OS_LINUX
+
+} // Capture
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyStartInputCapture( std::string_view ReplayPath, bool RealTime )
+{
+	xyInputCapture& rCapture = xyGetInputCapture();
+	if( rCapture.Thread.joinable() )
+		return false;
+
+	std::FILE* pReplay = nullptr;
+	if( !ReplayPath.empty() && ( pReplay = std::fopen( std::string( ReplayPath ).c_str(), "rb" ) ) == nullptr )
+		return false;
+
+	std::promise< bool > Started;
+	std::future< bool >  Result = Started.get_future();
+
+	rCapture.Running.store( true, std::memory_order_relaxed );
+	rCapture.Thread = std::thread( [ &rCapture, &Started, pReplay, RealTime ]
+	{
+		if( pReplay ) rCapture.Replay( pReplay, RealTime, Started );
+		else          rCapture.Capture( Started );
+	} );
+
+	if( !Result.get() )
+	{
+		rCapture.Stop();
+		return false;
+	}
+
+	return true;
+
+} // xyStartInputCapture
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyStopInputCapture( void )
+{
+	xyGetInputCapture().Stop();
+
+} // xyStopInputCapture
+
+//////////////////////////////////////////////////////////////////////////
+
+std::span< const xyPointerEvent > xyPollInputEvents( bool Coalesce )
+{
+	xyInputCapture& rCapture = xyGetInputCapture();
+	uint64_t        Head     = rCapture.Head.load( std::memory_order_relaxed );
+	const uint64_t  Tail     = rCapture.Tail.load( std::memory_order_acquire );
+
+	rCapture.Frame.clear();
+
+	for( ; Head != Tail; ++Head )
+		rCapture.Frame.push_back( rCapture.Ring[ Head % xyInputCapture::RingSize ] );
+
+	rCapture.Head.store( Head, std::memory_order_release );
+
+	if( rCapture.pRecording && !rCapture.Frame.empty() )
+		std::fwrite( rCapture.Frame.data(), sizeof( xyPointerEvent ), rCapture.Frame.size(), rCapture.pRecording );
+
+	if( Coalesce && !rCapture.Frame.empty() )
+	{
+		auto Last = rCapture.Frame.begin();
+
+		for( auto It = Last + 1; It != rCapture.Frame.end(); ++It )
+		{
+			if( It->Type == Last->Type && ( It->Type == xyPointerEventType::Move || It->Type == xyPointerEventType::Wheel ) )
+			{
+				Last->Timestamp  = It->Timestamp;
+				Last->DeltaX    += It->DeltaX;
+				Last->DeltaY    += It->DeltaY;
+			}
+			else
+			{
+				*( ++Last ) = *It;
+			}
+		}
+
+		rCapture.Frame.erase( Last + 1, rCapture.Frame.end() );
+	}
+
+	return rCapture.Frame;
+
+} // xyPollInputEvents
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyRecordInputEvents( std::string_view Path )
+{
+	xyInputCapture& rCapture = xyGetInputCapture();
+
+	if( rCapture.pRecording )
+	{
+		std::fclose( rCapture.pRecording );
+		rCapture.pRecording = nullptr;
+	}
+
+	if( Path.empty() )
+		return true;
+
+	if( ( rCapture.pRecording = std::fopen( std::string( Path ).c_str(), "wb" ) ) == nullptr )
+		return false;
+
+	const uint32_t Header[ 4 ] = { xyInputCapture::FileMagic, xyInputCapture::FileVersion, sizeof( xyPointerEvent ), 0 };
+	std::fwrite( Header, sizeof( Header ), 1, rCapture.pRecording );
+
+	return true;
+
+} // xyRecordInputEvents
+
 
 #endif // XY_IMPLEMENT
 
-#endif // XY_UI_MODES & XY_UI_MODE_DESKTOP
+#endif // XY_PLATFORM_UI_MODES & XY_UI_MODE_DESKTOP
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2021 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+// The parts of the Android layer that only depend on JNI.
+// They are kept apart so that they can also be built against the jni.h of a desktop JDK, such as by Tools/xy-jni-bench.
+
+//////////////////////////////////////////////////////////////////////////
+/// JNI-specific includes
+
+#include <jni.h>
+
+
+//////////////////////////////////////////////////////////////////////////
+/// JNI-specific data structures
+
+struct xyJNICache
+{
+	jmethodID ContextGetSystemService             = nullptr;
+	jclass    BuildClass                          = nullptr;
+	jfieldID  BuildManufacturer                   = nullptr;
+	jfieldID  BuildModel                          = nullptr;
+	jobject   BatteryManager                      = nullptr;
+	jmethodID BatteryManagerGetIntProperty        = nullptr;
+	jint      BatteryPropertyCapacity             = 0;
+	jint      BatteryPropertyStatus               = 0;
+	jint      BatteryStatusCharging               = 0;
+	jobject   DisplayManager                      = nullptr;
+	jmethodID DisplayManagerGetDisplays           = nullptr;
+	jmethodID DisplayGetName                      = nullptr;
+	jmethodID DisplayGetRectSize                  = nullptr;
+	jmethodID DisplayGetCutout                    = nullptr;
+	jclass    RectClass                           = nullptr;
+	jfieldID  RectLeft                            = nullptr;
+	jfieldID  RectTop                             = nullptr;
+	jfieldID  RectRight                           = nullptr;
+	jfieldID  RectBottom                          = nullptr;
+	jmethodID DisplayCutoutGetSafeInsetLeft       = nullptr;
+	jmethodID DisplayCutoutGetSafeInsetTop        = nullptr;
+	jmethodID DisplayCutoutGetSafeInsetRight      = nullptr;
+	jmethodID DisplayCutoutGetSafeInsetBottom     = nullptr;
+	jobject   PowerManager                        = nullptr;
+	jmethodID PowerManagerGetCurrentThermalStatus = nullptr;
+	jmethodID SpinnerGetSelectedItemPosition      = nullptr;
+	jmethodID FutureTaskGet                       = nullptr;
+
+}; // xyJNICache
+
+
+//////////////////////////////////////////////////////////////////////////
+/// JNI-specific functions
+
+/**
+ * Looks up the global class references, method IDs and field IDs that xy uses.
+ * Members that do not exist are left null, and the exceptions raised by looking them up are cleared.
+ *
+ * @param pJNI The JNI environment of the calling thread.
+ * @param Activity The activity, through which the system services are obtained.
+ * @param rCache The cache to fill in.
+ */
+extern void xyLoadJNICache( JNIEnv* pJNI, jobject Activity, xyJNICache& rCache );
+
+
+
+//////////////////////////////////////////////////////////////////////////
+/*
+
+██╗███╗   ███╗██████╗ ██╗     ███████╗███╗   ███╗███████╗███╗   ██╗████████╗ █████╗ ████████╗██╗ ██████╗ ███╗   ██╗
+██║████╗ ████║██╔══██╗██║     ██╔════╝████╗ ████║██╔════╝████╗  ██║╚══██╔══╝██╔══██╗╚══██╔══╝██║██╔═══██╗████╗  ██║
+██║██╔████╔██║██████╔╝██║     █████╗  ██╔████╔██║█████╗  ██╔██╗ ██║   ██║   ███████║   ██║   ██║██║   ██║██╔██╗ ██║
+██║██║╚██╔╝██║██╔═══╝ ██║     ██╔══╝  ██║╚██╔╝██║██╔══╝  ██║╚██╗██║   ██║   ██╔══██║   ██║   ██║██║   ██║██║╚██╗██║
+██║██║ ╚═╝ ██║██║     ███████╗███████╗██║ ╚═╝ ██║███████╗██║ ╚████║   ██║   ██║  ██║   ██║   ██║╚██████╔╝██║ ╚████║
+╚═╝╚═╝     ╚═╝╚═╝     ╚══════╝╚══════╝╚═╝     ╚═╝╚══════╝╚═╝  ╚═══╝   ╚═╝   ╚═╝  ╚═╝   ╚═╝   ╚═╝ ╚═════╝ ╚═╝  ╚═══╝
+*/
+#if defined( XY_IMPLEMENT )
+
+//////////////////////////////////////////////////////////////////////////
+/// JNI-specific functions
+
+void xyLoadJNICache( JNIEnv* pJNI, jobject Activity, xyJNICache& rCache )
+{
+	pJNI->PushLocalFrame( 32 );
+
+	// Members that don't exist on the running API level are left null, and the exception that the lookup raised is cleared
+	auto Class          = [ pJNI ]( const char* pName )                                    { jclass    Local = pJNI->FindClass( pName );                            if( !Local ) pJNI->ExceptionClear(); return Local ? static_cast< jclass >( pJNI->NewGlobalRef( Local ) ) : nullptr; };
+	auto Method         = [ pJNI ]( jclass Class, const char* pName, const char* pSignature ) { jmethodID ID    = Class ? pJNI->GetMethodID( Class, pName, pSignature ) : nullptr; if( !ID )    pJNI->ExceptionClear(); return ID; };
+	auto Field          = [ pJNI ]( jclass Class, const char* pName, const char* pSignature ) { jfieldID  ID    = Class ? pJNI->GetFieldID( Class, pName, pSignature ) : nullptr;  if( !ID )    pJNI->ExceptionClear(); return ID; };
+	auto StaticField    = [ pJNI ]( jclass Class, const char* pName, const char* pSignature ) { jfieldID  ID    = Class ? pJNI->GetStaticFieldID( Class, pName, pSignature ) : nullptr; if( !ID ) pJNI->ExceptionClear(); return ID; };
+	auto StaticIntField = [ & ]( jclass Class, const char* pName )                         { jfieldID  ID    = StaticField( Class, pName, "I" ); return ID ? pJNI->GetStaticIntField( Class, ID ) : 0; };
+
+	jclass ContextClass            = Class( "android/content/Context" );
+	rCache.ContextGetSystemService = Method( ContextClass, "getSystemService", "(Ljava/lang/String;)Ljava/lang/Object;" );
+
+	auto Service = [ & ]( const char* pName ) -> jobject
+	{
+		jobject Local = rCache.ContextGetSystemService ? pJNI->CallObjectMethod( Activity, rCache.ContextGetSystemService, pJNI->NewStringUTF( pName ) ) : nullptr;
+		return Local ? pJNI->NewGlobalRef( Local ) : nullptr;
+	};
+
+	rCache.BuildClass        = Class( "android/os/Build" );
+	rCache.BuildManufacturer = StaticField( rCache.BuildClass, "MANUFACTURER", "Ljava/lang/String;" );
+	rCache.BuildModel        = StaticField( rCache.BuildClass, "MODEL",        "Ljava/lang/String;" );
+
+	jclass BatteryManagerClass          = Class( "android/os/BatteryManager" );
+	rCache.BatteryManager               = Service( "batterymanager" );
+	rCache.BatteryManagerGetIntProperty = Method( BatteryManagerClass, "getIntProperty", "(I)I" );
+	rCache.BatteryPropertyCapacity      = StaticIntField( BatteryManagerClass, "BATTERY_PROPERTY_CAPACITY" );
+	rCache.BatteryPropertyStatus        = StaticIntField( BatteryManagerClass, "BATTERY_PROPERTY_STATUS" );
+	rCache.BatteryStatusCharging        = StaticIntField( BatteryManagerClass, "BATTERY_STATUS_CHARGING" );
+
+	rCache.DisplayManager            = Service( "display" );
+	rCache.DisplayManagerGetDisplays = Method( Class( "android/hardware/display/DisplayManager" ), "getDisplays", "()[Landroid/view/Display;" );
+
+	jclass DisplayClass       = Class( "android/view/Display" );
+	rCache.DisplayGetName     = Method( DisplayClass, "getName",     "()Ljava/lang/String;" );
+	rCache.DisplayGetRectSize = Method( DisplayClass, "getRectSize", "(Landroid/graphics/Rect;)V" );
+	rCache.DisplayGetCutout   = Method( DisplayClass, "getCutout",   "()Landroid/view/DisplayCutout;" );
+
+	rCache.RectClass  = Class( "android/graphics/Rect" );
+	rCache.RectLeft   = Field( rCache.RectClass, "left",   "I" );
+	rCache.RectTop    = Field( rCache.RectClass, "top",    "I" );
+	rCache.RectRight  = Field( rCache.RectClass, "right",  "I" );
+	rCache.RectBottom = Field( rCache.RectClass, "bottom", "I" );
+
+	jclass DisplayCutoutClass              = Class( "android/view/DisplayCutout" );
+	rCache.DisplayCutoutGetSafeInsetLeft   = Method( DisplayCutoutClass, "getSafeInsetLeft",   "()I" );
+	rCache.DisplayCutoutGetSafeInsetTop    = Method( DisplayCutoutClass, "getSafeInsetTop",    "()I" );
+	rCache.DisplayCutoutGetSafeInsetRight  = Method( DisplayCutoutClass, "getSafeInsetRight",  "()I" );
+	rCache.DisplayCutoutGetSafeInsetBottom = Method( DisplayCutoutClass, "getSafeInsetBottom", "()I" );
+
+	rCache.PowerManager                        = Service( "power" );
+	rCache.PowerManagerGetCurrentThermalStatus = Method( Class( "android/os/PowerManager" ), "getCurrentThermalStatus", "()I" );
+
+	rCache.SpinnerGetSelectedItemPosition = Method( Class( "android/widget/Spinner" ), "getSelectedItemPosition", "()I" );
+	rCache.FutureTaskGet                  = Method( Class( "java/util/concurrent/FutureTask" ), "get", "()Ljava/lang/Object;" );
+
+	pJNI->PopLocalFrame( nullptr );
+
+} // xyLoadJNICache
+
+
+#endif // XY_IMPLEMENT
@@ -22,6 +22,8 @@
 //////////////////////////////////////////////////////////////////////////
 /// Windows-specific includes
 
+// Has to come before windows.h, which would otherwise pull in the older winsock.h
+#include <winsock2.h>
 #include <windows.h>
 
 
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2021 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * Module interface for xy, allowing source files to 'import xy;' instead of parsing xy.h every time.
+ * The implementation still has to be compiled once, either by xy-implement.cpp or by defining XY_IMPLEMENT before including xy.h in one source file.
+ *
+ * The declarations are exported from the global module, so they link against the same definitions as the header-only path.
+ *
+ * Tools/xy-compile-bench measures how much faster importing is than including, and checks that the module links.
+ *
+ * Note: Modules cannot export macros, so source files that need the XY_* flags or platform defines have to include xy.h as well.
+ */
+
+module;
+
+// GCC before version 14 ignores the extern "C++" below and attaches the declarations to the module, so they would not link against xy-implement.cpp
+#if defined( __GNUC__ ) && !defined( __clang__ ) && ( __GNUC__ < 14 )
+#error "The xy module requires GCC 14 or newer. Include xy.h instead."
+#endif // __GNUC__ && !__clang__ && __GNUC__ < 14
+
+// Everything that xy.h includes has to be in the global module fragment, so that it isn't exported along with xy
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined( __APPLE__ )
+#include <TargetConditionals.h>
+#endif // __APPLE__
+
+export module xy;
+
+export extern "C++"
+{
+#include "xy.h"
+}
@@ -20,11 +20,27 @@
 //////////////////////////////////////////////////////////////////////////
 /// Includes
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <initializer_list>
+#include <iterator>
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 
@@ -39,11 +55,29 @@
 #define XY_UI_MODE_CAR      0x20
 #define XY_UI_MODE_HEADLESS 0x40
 
+#define XY_MEMORY_TRANSPARENT_HUGE_PAGES 0x01
+#define XY_MEMORY_EXPLICIT_HUGE_PAGES    0x02
+#define XY_MEMORY_PREFAULT               0x04
+#define XY_MEMORY_NUMA_LOCAL             0x08
+
+#define XY_LOG_SINK_STDOUT 0x01
+#define XY_LOG_SINK_FILE   0x02
+#define XY_LOG_SINK_LOGCAT 0x04 // Android only
+
+#define XY_NETWORK_OFFLOAD_RX_CHECKSUM 0x01
+#define XY_NETWORK_OFFLOAD_TX_CHECKSUM 0x02
+#define XY_NETWORK_OFFLOAD_TSO         0x04 // TCP segmentation in the hardware
+#define XY_NETWORK_OFFLOAD_GSO         0x08 // Generic segmentation in the driver
+#define XY_NETWORK_OFFLOAD_GRO         0x10 // Generic receive coalescing
+
+#define XY_PROCESS_STATS_PSS        0x01 // Walks every memory mapping of the process, so it costs far more than the other stats
+#define XY_PROCESS_STATS_OPEN_FILES 0x02 // Lists every open file descriptor or handle
+
 #if defined( _WIN32 )
 /// Windows
 
 #define XY_OS_WINDOWS
-#define XY_UI_MODES ( XY_UI_MODE_DESKTOP )
+#define XY_PLATFORM_UI_MODES ( XY_UI_MODE_DESKTOP )
 
 #elif defined( __APPLE__ ) // _WIN32
 /// Apple
@@ -52,16 +86,16 @@
 
 #if TARGET_OS_OSX
 	#define XY_OS_MACOS
-	#define XY_UI_MODES ( XY_UI_MODE_DESKTOP )
+	#define XY_PLATFORM_UI_MODES ( XY_UI_MODE_DESKTOP )
 #elif TARGET_OS_IOS // TARGET_OS_OSX
 	#define XY_OS_IOS
-	#define XY_UI_MODES ( XY_UI_MODE_PHONE )
+	#define XY_PLATFORM_UI_MODES ( XY_UI_MODE_PHONE )
 #elif TARGET_OS_WATCH // TARGET_OS_IOS
 	#define XY_OS_WATCHOS
-	#define XY_UI_MODES ( XY_UI_MODE_WATCH )
+	#define XY_PLATFORM_UI_MODES ( XY_UI_MODE_WATCH )
 #elif TARGET_OS_TV // TARGET_OS_WATCH
 	#define XY_OS_TVOS
-	#define XY_UI_MODES ( XY_UI_MODE_TV )
+	#define XY_PLATFORM_UI_MODES ( XY_UI_MODE_TV )
 #endif // TARGET_OS_TV
 
 #elif defined( __ANDROID__ ) // __APPLE__
@@ -71,16 +105,21 @@
 // Since there is no way to detect at compile time what UI mode we are targeting, we have to define all possible environments
 // List of UI modes can be found at https://developer.android.google.cn/guide/topics/resources/providing-resources.html#UiModeQualifier
 // (Appliance corresponds to Headless)
-#define XY_UI_MODES ( XY_UI_MODE_PHONE | XY_UI_MODE_WATCH | XY_UI_MODE_TV | XY_UI_MODE_VR | XY_UI_MODE_CAR | XY_UI_MODE_HEADLESS )
+#define XY_PLATFORM_UI_MODES ( XY_UI_MODE_PHONE | XY_UI_MODE_WATCH | XY_UI_MODE_TV | XY_UI_MODE_VR | XY_UI_MODE_CAR | XY_UI_MODE_HEADLESS )
 
 #elif defined( __linux__ ) // __ANDROID__
 /// Linux
 
 #define XY_OS_LINUX
-#define XY_UI_MODES ( XY_UI_MODE_DESKTOP | XY_UI_MODE_HEADLESS )
+#define XY_PLATFORM_UI_MODES ( XY_UI_MODE_DESKTOP | XY_UI_MODE_HEADLESS )
 
 #endif // __linux__
 
+// Can be defined up front to build for fewer UI modes than the platform supports, such as only XY_UI_MODE_HEADLESS for servers
+#if !defined( XY_UI_MODES )
+#define XY_UI_MODES XY_PLATFORM_UI_MODES
+#endif // !XY_UI_MODES
+
 
 //////////////////////////////////////////////////////////////////////////
 /// Enumerators
@@ -118,883 +157,10183 @@ enum class xyMessageResult
 
 }; // xyMessageResult
 
+enum class xyAccessPattern
+{
+	Normal,
+	Sequential,
+	Random,
 
-//////////////////////////////////////////////////////////////////////////
-/// Data structures
+}; // xyAccessPattern
 
-struct xyPlatformImpl;
+enum class xyFileMode
+{
+	Read,
+	Write,     // Creates the file if it does not exist
+	ReadWrite, // Creates the file if it does not exist
 
-struct xyContext
+}; // xyFileMode
+
+enum class xyFileEventType
 {
-	std::span< char* >                CommandLineArgs;
-	std::unique_ptr< xyPlatformImpl > pPlatformImpl;
-	uint32_t                          UIMode = 0x0;
+	Created,
+	Modified,
+	Removed,
 
-}; // xyContext
+}; // xyFileEventType
 
-struct xyRect
+enum class xyLogLevel
 {
-	int32_t Left   = 0;
-	int32_t Top    = 0;
-	int32_t Right  = 0;
-	int32_t Bottom = 0;
+	Debug,
+	Info,
+	Warning,
+	Error,
 
-}; // xyRect
+}; // xyLogLevel
 
-struct xyDevice
+enum class xyLogFormat
 {
-	std::string Name;
+	Text,
+	Binary, // Compact records that are turned into text offline with xyDecodeLog
 
-}; // xyDevice
+}; // xyLogFormat
 
-struct xyDisplayAdapter
+enum class xyLogArgument : uint8_t
 {
-	std::string Name;
-	xyRect      FullRect;
-	xyRect      WorkRect;
+	Signed,
+	Unsigned,
+	Floating,
+	String,
+	Pointer,
 
-}; // xyDisplayAdapter
+}; // xyLogArgument
 
-struct xyLanguage
+enum class xyConfigurationChange : uint8_t
 {
-	std::string LocaleName;
+	Theme,
+	Language,
+	Displays,
+	UIMode,
+	Network,
 
-}; // xyLanguage
+}; // xyConfigurationChange
 
-struct xyBatteryState
+enum class xyDuplex
 {
-	operator bool( void ) const { return Valid; }
+	Unknown,
+	Half,
+	Full,
 
-	uint8_t CapacityPercentage = 100;
-	bool    Charging           = false;
-	bool    Valid              = false;
+}; // xyDuplex
 
-}; // xyPowerStatus
+enum class xyThermalStatus
+{
+	None,
+	Light,
+	Moderate,
+	Severe,
+	Critical,
+	Emergency,
+	Shutdown,
+
+}; // xyThermalStatus
+
+enum class xyPerformanceTier
+{
+	Full,
+	Balanced,
+	Reduced,
+	Minimal,
+
+}; // xyPerformanceTier
 
 
 //////////////////////////////////////////////////////////////////////////
-/// Functions
+/// Containers
 
 /**
- * Obtains the internal xy context where all the global data is stored
- *
- * @return A reference to the context data.
+ * Vector that stores up to InlineCapacity elements inside the object itself and only moves to the heap beyond that.
+ * Mirrors the subset of the std::vector interface used by xy, and converts implicitly to std::vector and std::span.
  */
-extern xyContext& xyGetContext( void );
+template< typename T, size_t InlineCapacity >
+struct xySmallVector
+{
+	using value_type     = T;
+	using size_type      = size_t;
+	using iterator       = T*;
+	using const_iterator = const T*;
 
-/**
- * Convert a unicode string to UTF-8.
- *
- * @return A UTF-8 string.
- */
-extern std::string xyUTF( std::wstring_view String );
+	xySmallVector( void ) = default;
 
-/**
- * Convert a UTF-8 to Unicode.
- *
- * @return A Unicode string.
- */
-extern std::wstring xyUnicode( std::string_view String );
+	xySmallVector( std::initializer_list< T > List )
+	{
+		reserve( List.size() );
 
-/**
- * Prompts a system message box containing a user-defined message and a set of options in the form of buttons.
- * The current thread is blocked until a selection has been made.
- *
- * @param Title The title of the message box window.
- * @param Message The content of the message text box.
- * @param Buttons The range of button options to present.
- * @return The result that was selected.
- */
-extern xyMessageResult xyMessageBox( std::string_view Title, std::string_view Message, xyMessageButtons Buttons );
+		for( const T& rElement : List )
+			push_back( rElement );
 
-/**
- * Prompts a system message box containing a user-defined message and an 'OK' button.
- * The current thread is blocked until the message box is closed.
- *
- * @param Title The title of the message box window.
- * @param Message The content of the message text box.
- */
-extern void xyMessageBox( std::string_view Title, std::string_view Message );
+	} // xySmallVector
 
-/**
- * Obtains information about the current device.
- *
- * @return The device data.
- */
-extern xyDevice xyGetDevice( void );
+	xySmallVector( const xySmallVector& rOther )
+	{
+		reserve( rOther.Size );
 
-/**
- * Obtains the preferred theme of this device.
- *
- * @return The theme enumerator.
- */
-extern xyTheme xyGetPreferredTheme( void );
+		for( const T& rElement : rOther )
+			push_back( rElement );
 
-/**
- * Obtains the system language.
- *
- * @return The language code.
- */
-extern xyLanguage xyGetLanguage( void );
+	} // xySmallVector
 
-/**
- * Obtains the state of the battery power source on this device.
- *
- * Note: The battery state has a Valid field that is set to true if battery information was successfully obtained.
- * If it is false, that either means that the device is only using electric power, or that an error occurred.
- * Either way, the battery state provides a boolean operator that allows you to write code like this:
- * 
- * if( xyBatteryState State = xyGetBatteryState() )
- * {
- *     // Successfully obtained the battery state!
- * }
- *
- * @return The battery state.
- */
-extern xyBatteryState xyGetBatteryState( void );
+	xySmallVector( xySmallVector&& rrOther ) noexcept( std::is_nothrow_move_constructible_v< T > )
+	{
+		MoveFrom( rrOther );
 
-/**
- * Obtains the display adapters connected to the device.
- *
- * @return A vector of display adapters.
- */
-extern std::vector< xyDisplayAdapter > xyGetDisplayAdapters( void );
+	} // xySmallVector
 
-//////////////////////////////////////////////////////////////////////////
-/*
+	~xySmallVector( void )
+	{
+		clear();
+		FreeHeap();
 
-██╗███╗   ███╗██████╗ ██╗     ███████╗███╗   ███╗███████╗███╗   ██╗████████╗ █████╗ ████████╗██╗ ██████╗ ███╗   ██╗
-██║████╗ ████║██╔══██╗██║     ██╔════╝████╗ ████║██╔════╝████╗  ██║╚══██╔══╝██╔══██╗╚══██╔══╝██║██╔═══██╗████╗  ██║
-██║██╔████╔██║██████╔╝██║     █████╗  ██╔████╔██║█████╗  ██╔██╗ ██║   ██║   ███████║   ██║   ██║██║   ██║██╔██╗ ██║
-██║██║╚██╔╝██║██╔═══╝ ██║     ██╔══╝  ██║╚██╔╝██║██╔══╝  ██║╚██╗██║   ██║   ██╔══██║   ██║   ██║██║   ██║██║╚██╗██║
-██║██║ ╚═╝ ██║██║     ███████╗███████╗██║ ╚═╝ ██║███████╗██║ ╚████║   ██║   ██║  ██║   ██║   ██║╚██████╔╝██║ ╚████║
-╚═╝╚═╝     ╚═╝╚═╝     ╚══════╝╚══════╝╚═╝     ╚═╝╚══════╝╚═╝  ╚═══╝   ╚═╝   ╚═╝  ╚═╝   ╚═╝   ╚═╝ ╚═════╝ ╚═╝  ╚═══╝
-*/
-#if defined( XY_IMPLEMENT )
+	} // ~xySmallVector
 
-//////////////////////////////////////////////////////////////////////////
-/// Includes
+	xySmallVector& operator=( const xySmallVector& rOther )
+	{
+		if( this != &rOther )
+		{
+			clear();
+			reserve( rOther.Size );
 
-#include "xy-platforms/xy-android.h"
-#include "xy-platforms/xy-desktop.h"
-#include "xy-platforms/xy-ios.h"
-#include "xy-platforms/xy-macos.h"
-#include "xy-platforms/xy-tvos.h"
-#include "xy-platforms/xy-watchos.h"
-#include "xy-platforms/xy-windows.h"
+			for( const T& rElement : rOther )
+				push_back( rElement );
+		}
 
-#if defined( XY_OS_WINDOWS )
-#include <windows.h>
-#include <lmcons.h>
-#elif defined( XY_OS_MACOS ) // XY_OS_WINDOWS
-#include <Cocoa/Cocoa.h>
-#include <Foundation/Foundation.h>
-#elif defined( XY_OS_ANDROID ) // XY_OS_MACOS
-#include <android/configuration.h>
-#include <android/native_activity.h>
-#include <uchar.h>
-#include <unistd.h>
-#elif defined( XY_OS_IOS ) // XY_OS_ANDROID
-#include <UIKit/UIKit.h>
-#endif // XY_OS_IOS
+		return *this;
 
+	} // operator=
 
-//////////////////////////////////////////////////////////////////////////
-/// Functions
+	xySmallVector& operator=( xySmallVector&& rrOther ) noexcept( std::is_nothrow_move_constructible_v< T > )
+	{
+		if( this != &rrOther )
+		{
+			clear();
+			FreeHeap();
+			MoveFrom( rrOther );
+		}
 
-xyContext& xyGetContext( void )
-{
-	static xyContext Context;
+		return *this;
+
+	} // operator=
+
+	operator std::vector< T >( void ) const & { return std::vector< T >( begin(), end() ); }
+	operator std::vector< T >( void ) &&      { return std::vector< T >( std::make_move_iterator( begin() ), std::make_move_iterator( end() ) ); }
+	operator std::span< T >( void )           { return { pData, Size }; }
+	operator std::span< const T >( void ) const { return { pData, Size }; }
+
+	T&       operator[]( size_t Index )       { return pData[ Index ]; }
+	const T& operator[]( size_t Index ) const { return pData[ Index ]; }
+
+	T*       begin( void )          { return pData; }
+	const T* begin( void ) const    { return pData; }
+	T*       end  ( void )          { return pData + Size; }
+	const T* end  ( void ) const    { return pData + Size; }
+	T*       data ( void )          { return pData; }
+	const T* data ( void ) const    { return pData; }
+	T&       front( void )          { return pData[ 0 ]; }
+	const T& front( void ) const    { return pData[ 0 ]; }
+	T&       back ( void )          { return pData[ Size - 1 ]; }
+	const T& back ( void ) const    { return pData[ Size - 1 ]; }
+	size_t   size    ( void ) const { return Size; }
+	size_t   capacity( void ) const { return Capacity; }
+	bool     empty   ( void ) const { return Size == 0; }
+	bool     is_inline( void ) const { return pData == InlineData(); }
+
+	template< typename... Args >
+	T& emplace_back( Args&&... rrArgs )
+	{
+		if( Size < Capacity )
+			return *new( pData + Size++ ) T( std::forward< Args >( rrArgs )... );
 
-	return Context;
+		// Construct the new element before relocating the old ones, in case the arguments refer to an existing element
+		const size_t NewCapacity = Capacity * 2;
+		T*           pNewData    = std::allocator< T >().allocate( NewCapacity );
+		T*           pElement    = new( pNewData + Size ) T( std::forward< Args >( rrArgs )... );
 
-} // xyGetContext
+		Relocate( pNewData );
+		pData    = pNewData;
+		Capacity = NewCapacity;
+		++Size;
 
-//////////////////////////////////////////////////////////////////////////
+		return *pElement;
 
-std::string xyUTF( std::wstring_view String )
-{
-	std::string    UTFString;
-	size_t         Size;
-	const wchar_t* pSrc = String.data();
-	mbstate_t      State{};
+	} // emplace_back
 
-#if defined( XY_OS_WINDOWS )
-	if( wcsrtombs_s( &Size, nullptr, 0, &pSrc, String.size(), &State ) == 0 )
+	void push_back( const T& rElement ) { emplace_back( rElement ); }
+	void push_back( T&& rrElement )     { emplace_back( std::move( rrElement ) ); }
+	void pop_back ( void )              { pData[ --Size ].~T(); }
+
+	void clear( void )
 	{
-		UTFString.resize( Size );
-		wcsrtombs_s( &Size, &UTFString[ 0 ], Size, &pSrc, String.size(), &State );
-	}
-#else // XY_OS_WINDOWS
-	if( ( Size = wcsrtombs( nullptr, &pSrc, String.size(), &State ) ) > 0 )
+		std::destroy( pData, pData + Size );
+		Size = 0;
+
+	} // clear
+
+	void reserve( size_t NewCapacity )
 	{
-		UTFString.resize( Size );
-		wcsrtombs( &UTFString[ 0 ], &pSrc, String.size(), &State );
-	}
-#endif // !XY_OS_WINDOWS
+		if( NewCapacity <= Capacity )
+			return;
 
-	return UTFString;
+		T* pNewData = std::allocator< T >().allocate( NewCapacity );
+		Relocate( pNewData );
+		pData    = pNewData;
+		Capacity = NewCapacity;
 
-} // xyUTF
+	} // reserve
 
-//////////////////////////////////////////////////////////////////////////
+private:
 
-std::wstring xyUnicode( std::string_view String )
-{
-	std::wstring Result;
-	size_t       Size;
-	const char*  pSrc = String.data();
-	mbstate_t    MultiByteState{ };
+	T*       InlineData( void )       { return reinterpret_cast< T* >( InlineStorage ); }
+	const T* InlineData( void ) const { return reinterpret_cast< const T* >( InlineStorage ); }
 
-#if defined( XY_OS_WINDOWS )
-	if( mbsrtowcs_s( &Size, nullptr, 0, &pSrc, String.size(), &MultiByteState ) == 0 )
+	void Relocate( T* pNewData )
 	{
-		Result.resize( Size );
-		mbsrtowcs_s( &Size, &Result[ 0 ], Size, &pSrc, String.size(), &MultiByteState );
-	}
-#else // XY_OS_WINDOWS
-	if( ( Size = mbsrtowcs( nullptr, &pSrc, String.size(), &MultiByteState ) ) > 0 )
-	{
-		Result.resize( Size );
-		mbsrtowcs( &Result[ 0 ], &pSrc, String.size(), &MultiByteState );
-	}
-#endif // !XY_OS_WINDOWS
-
-	return Result;
+		std::uninitialized_move( pData, pData + Size, pNewData );
+		std::destroy( pData, pData + Size );
+		FreeHeap();
 
-} // xyUnicode
+	} // Relocate
 
-//////////////////////////////////////////////////////////////////////////
+	void FreeHeap( void )
+	{
+		if( pData != InlineData() )
+			std::allocator< T >().deallocate( pData, Capacity );
 
-xyMessageResult xyMessageBox( std::string_view Title, std::string_view Message, xyMessageButtons Buttons )
-{
+		pData    = InlineData();
+		Capacity = InlineCapacity;
 
-#if defined( XY_OS_WINDOWS )
+	} // FreeHeap
 
-	const UINT MessageType = [ Buttons ]
+	void MoveFrom( xySmallVector& rOther )
 	{
-		switch( Buttons )
+		if( rOther.pData != rOther.InlineData() )
 		{
-			default:
-			case xyMessageButtons::Ok:                     return MB_OK;
-			case xyMessageButtons::OkCancel:               return MB_OKCANCEL;
-			case xyMessageButtons::YesNo:                  return MB_YESNO;
-			case xyMessageButtons::YesNoCancel:            return MB_YESNOCANCEL;
-			case xyMessageButtons::AbortRetryIgnore:       return MB_ABORTRETRYIGNORE;
-			case xyMessageButtons::CancelTryagainContinue: return MB_CANCELTRYCONTINUE;
-			case xyMessageButtons::RetryCancel:            return MB_RETRYCANCEL;
+			// Steal the heap buffer
+			pData    = rOther.pData;
+			Size     = rOther.Size;
+			Capacity = rOther.Capacity;
+
+			rOther.pData    = rOther.InlineData();
+			rOther.Size     = 0;
+			rOther.Capacity = InlineCapacity;
+		}
+		else
+		{
+			std::uninitialized_move( rOther.pData, rOther.pData + rOther.Size, pData );
+			Size = rOther.Size;
+			rOther.clear();
 		}
-	}();
 
-	// The ANSI version of MessageBox doesn't support UTF-8 strings so we convert it into Unicode and use the Unicode version instead
-	const std::wstring UnicodeTitle   = xyUnicode( Title );
-	const std::wstring UnicodeMessage = xyUnicode( Message );
+	} // MoveFrom
 
-	int Result;
-	if( !UnicodeMessage.empty() ) Result = MessageBoxW( NULL, UnicodeMessage.data(), UnicodeTitle.data(), MessageType | MB_ICONINFORMATION | MB_TASKMODAL );
-	else                          Result = MessageBoxA( NULL, Message       .data(), Title       .data(), MessageType | MB_ICONINFORMATION | MB_TASKMODAL );
+	alignas( T ) std::byte InlineStorage[ sizeof( T ) * InlineCapacity ];
+	T*                     pData    = InlineData();
+	size_t                 Size     = 0;
+	size_t                 Capacity = InlineCapacity;
 
-	switch( Result )
+}; // xySmallVector
+
+/**
+ * Fixed-capacity string stored inside the object itself. Strings that do not fit are truncated at a UTF-8 character boundary.
+ * Converts implicitly to std::string_view and std::string.
+ */
+template< size_t Capacity >
+struct xyInlineString
+{
+	xyInlineString( void ) = default;
+
+	template< typename String >
+	requires std::is_convertible_v< const String&, std::string_view >
+	xyInlineString( const String& rString )
 	{
-		default:
-		case IDOK:       return xyMessageResult::Ok;
-		case IDCANCEL:   return xyMessageResult::Cancel;
-		case IDABORT:    return xyMessageResult::Abort;
-		case IDRETRY:    return xyMessageResult::Retry;
-		case IDIGNORE:   return xyMessageResult::Ignore;
-		case IDYES:      return xyMessageResult::Yes;
-		case IDNO:       return xyMessageResult::No;
-		case IDTRYAGAIN: return xyMessageResult::Tryagain;
-		case IDCONTINUE: return xyMessageResult::Continue;
-	}
+		assign( std::string_view( rString ) );
 
-#elif defined( XY_OS_MACOS ) // XY_OS_WINDOWS
+	} // xyInlineString
+
+	operator std::string_view( void ) const { return { Buffer, Length }; }
+	operator std::string     ( void ) const { return { Buffer, Length }; }
+
+	char&       operator[]( size_t Index )       { return Buffer[ Index ]; }
+	const char& operator[]( size_t Index ) const { return Buffer[ Index ]; }
+
+	friend bool operator==( const xyInlineString& rLhs, std::string_view Rhs ) { return std::string_view( rLhs ) == Rhs; }
+
+	xyInlineString& assign( std::string_view String )
+	{
+		Length = 0;
+
+		return append( String );
+
+	} // assign
+
+	xyInlineString& assign( const char* pString, size_t Count ) { return assign( std::string_view( pString, Count ) ); }
+
+	xyInlineString& append( std::string_view String )
+	{
+		size_t Count = std::min( String.size(), Capacity - Length );
+
+		// Avoid leaving half of a multi-byte character behind when truncating
+		if( Count < String.size() )
+		{
+			while( Count > 0 && ( static_cast< unsigned char >( String[ Count ] ) & 0xC0 ) == 0x80 )
+				--Count;
+		}
+
+		String.copy( Buffer + Length, Count );
+		Length          += Count;
+		Buffer[ Length ] = '\0';
+
+		return *this;
+
+	} // append
+
+	void clear( void )
+	{
+		Length      = 0;
+		Buffer[ 0 ] = '\0';
+
+	} // clear
+
+	const char* c_str   ( void ) const { return Buffer; }
+	const char* data    ( void ) const { return Buffer; }
+	char*       data    ( void )       { return Buffer; }
+	char*       begin   ( void )       { return Buffer; }
+	const char* begin   ( void ) const { return Buffer; }
+	char*       end     ( void )       { return Buffer + Length; }
+	const char* end     ( void ) const { return Buffer + Length; }
+	size_t      size    ( void ) const { return Length; }
+	size_t      length  ( void ) const { return Length; }
+	bool        empty   ( void ) const { return Length == 0; }
+
+	static constexpr size_t capacity( void ) { return Capacity; }
+
+private:
+
+	size_t Length                 = 0;
+	char   Buffer[ Capacity + 1 ] = { };
+
+}; // xyInlineString
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Data structures
+
+struct xyPlatformImpl;
+struct xyMessageBoxQueue;
+
+struct xyStartupPhase
+{
+	const char*              pName;
+	std::chrono::nanoseconds Time; // Since the entry point was called
+
+}; // xyStartupPhase
+
+struct xyStartupProfile
+{
+	std::optional< std::chrono::nanoseconds > BeforeEntry; // From process creation to the entry point, including loading and static initialization, if the platform reports it
+	std::chrono::nanoseconds                  ToMain;      // From the entry point to the first line of xyMain
+	xySmallVector< xyStartupPhase, 8 >        Phases;
+
+}; // xyStartupProfile
+
+/**
+ * What the target platform and build support, known at compile time.
+ * Lets code use if constexpr where it would otherwise test xyContext::UIMode or write another #if chain.
+ */
+struct xyPlatform
+{
+	static constexpr uint32_t SupportedUIModes = XY_UI_MODES;
+	static constexpr bool     SingleUIMode     = std::has_single_bit( SupportedUIModes ); // The UI mode is known without asking the platform
+	static constexpr bool     HasDisplays      = ( SupportedUIModes & ~XY_UI_MODE_HEADLESS ) != 0;
+
+#if defined( XY_OS_WINDOWS ) || defined( XY_OS_MACOS ) || defined( XY_OS_IOS ) || defined( XY_OS_ANDROID ) || defined( XY_OS_LINUX )
+	static constexpr bool     HasBattery       = true;
+#else // XY_OS_WINDOWS || XY_OS_MACOS || XY_OS_IOS || XY_OS_ANDROID || XY_OS_LINUX
+	static constexpr bool     HasBattery       = false;
+#endif // !XY_OS_WINDOWS && !XY_OS_MACOS && !XY_OS_IOS && !XY_OS_ANDROID && !XY_OS_LINUX
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+	static constexpr bool     HasSysfs         = true;
+#else // XY_OS_LINUX || XY_OS_ANDROID
+	static constexpr bool     HasSysfs         = false;
+#endif // !XY_OS_LINUX && !XY_OS_ANDROID
+
+	static_assert( SupportedUIModes != 0 && ( SupportedUIModes & ~( XY_PLATFORM_UI_MODES | XY_UI_MODE_HEADLESS ) ) == 0, "XY_UI_MODES contains a UI mode that the platform does not support" );
+
+}; // xyPlatform
+
+struct xyContext
+{
+	std::span< char* >                    CommandLineArgs;
+	std::unique_ptr< xyPlatformImpl >     pPlatformImpl;
+	uint32_t                              UIMode    = 0x0;
+	std::chrono::steady_clock::time_point StartTime = std::chrono::steady_clock::now(); // The context is created by the first line of the entry point
+	xySmallVector< xyStartupPhase, 8 >    StartupPhases;
+	std::unique_ptr< xyMessageBoxQueue >  pMessageBoxQueue; // Serves xyMessageBoxAsync. Started on first use, and stopped before the platform is torn down.
+
+}; // xyContext
+
+struct xyRect
+{
+	int32_t Left   = 0;
+	int32_t Top    = 0;
+	int32_t Right  = 0;
+	int32_t Bottom = 0;
+
+}; // xyRect
+
+struct xyDevice
+{
+	std::string Name;
+
+}; // xyDevice
+
+struct xyInlineDevice
+{
+	xyInlineString< 128 > Name;
+
+}; // xyInlineDevice
+
+struct xyPmrDevice
+{
+	std::pmr::string Name;
+
+}; // xyPmrDevice
+
+struct xyDisplayAdapter
+{
+	std::string Name;
+	xyRect      FullRect;
+	xyRect      WorkRect;
+
+}; // xyDisplayAdapter
+
+struct xyInlineDisplayAdapter
+{
+	xyInlineString< 128 > Name;
+	xyRect                FullRect;
+	xyRect                WorkRect;
+
+}; // xyInlineDisplayAdapter
+
+struct xyPmrDisplayAdapter
+{
+	std::pmr::string Name;
+	xyRect           FullRect;
+	xyRect           WorkRect;
+
+}; // xyPmrDisplayAdapter
+
+struct xyLanguage
+{
+	std::string LocaleName;
+
+}; // xyLanguage
+
+struct xyInlineLanguage
+{
+	xyInlineString< 96 > LocaleName;
+
+}; // xyInlineLanguage
+
+struct xyPmrLanguage
+{
+	std::pmr::string LocaleName;
+
+}; // xyPmrLanguage
+
+struct xyBatteryState
+{
+	operator bool( void ) const { return Valid; }
+
+	uint8_t CapacityPercentage = 100;
+	bool    Charging           = false;
+	bool    Valid              = false;
+
+}; // xyPowerStatus
+
+struct xyThermalZone
+{
+	xyInlineString< 32 > Type;        // Such as "x86_pkg_temp" or "cpu-0-0-usr"
+	float                Temperature; // In degrees Celsius
+
+}; // xyThermalZone
+
+struct xyCpuFrequency
+{
+	uint32_t CurrentKHz = 0;
+	uint32_t MinKHz     = 0; // What the hardware supports
+	uint32_t MaxKHz     = 0; // What the hardware supports
+	uint32_t LimitKHz   = 0; // What the core is currently allowed to run at. Below MaxKHz when the core is capped.
+
+}; // xyCpuFrequency
+
+struct xyThermalState
+{
+	operator bool( void ) const { return Valid; }
+
+	xySmallVector< xyThermalZone, 8 >   Zones;
+	xySmallVector< xyCpuFrequency, 16 > Cores;
+	xyThermalStatus                     Status     = xyThermalStatus::None;
+	bool                                Throttling = false; // Whether any cooling device is active or any core is capped below its maximum frequency
+	bool                                Valid      = false;
+
+}; // xyThermalState
+
+struct xyStorageVolume
+{
+	std::string          MountPoint;        // Such as "/home" or "C:\\"
+	std::string          Device;            // Such as "/dev/nvme0n1p2" or "\\Device\\HarddiskVolume3"
+	xyInlineString< 32 > FileSystem;        // Such as "ext4", "apfs" or "NTFS"
+	uint64_t             TotalBytes    = 0;
+	uint64_t             FreeBytes     = 0; // Available to the app, which excludes space reserved for the system
+	uint32_t             OptimalIOSize = 0; // Preferred request size in bytes. Falls back to the block size of the file system when the device does not report one.
+	uint32_t             MinimumIOSize = 0; // Smallest request size in bytes that avoids a read-modify-write, usually the physical sector size
+	uint32_t             QueueDepth    = 0; // How many requests the device queue holds, or zero if unknown
+	bool                 Rotational    = false;
+	bool                 DirectIO      = false; // Whether files can be opened with O_DIRECT, FILE_FLAG_NO_BUFFERING or F_NOCACHE
+	bool                 Discard       = false; // Whether the device supports discard or TRIM
+	bool                 ReadOnly      = false;
+
+}; // xyStorageVolume
+
+struct xyNetworkAddress
+{
+	xyInlineString< 47 > Address;          // Such as "192.168.1.2" or "fe80::1"
+	uint8_t              PrefixLength = 0; // Of the subnet, such as 24 for a netmask of 255.255.255.0
+	bool                 IPv6         = false;
+
+}; // xyNetworkAddress
+
+struct xyNetworkInterface
+{
+	std::string                          Name;              // Such as "eth0" or "Ethernet 2"
+	xySmallVector< xyNetworkAddress, 4 > Addresses;
+	uint32_t                             MTU       = 0;
+	uint32_t                             SpeedMbps = 0;     // Negotiated link speed, or zero if unknown
+	xyDuplex                             Duplex    = xyDuplex::Unknown;
+	uint32_t                             RxQueues  = 0;     // Zero if unknown
+	uint32_t                             TxQueues  = 0;     // Zero if unknown
+	uint32_t                             Offloads  = 0x0;   // XY_NETWORK_OFFLOAD_* flags
+	bool                                 Up        = false; // Whether the interface is enabled
+	bool                                 Running   = false; // Whether the link is established
+	bool                                 Loopback  = false;
+
+}; // xyNetworkInterface
+
+struct xyProcessStats
+{
+	operator bool( void ) const { return Valid; }
+
+	std::chrono::nanoseconds UserTime            = { };
+	std::chrono::nanoseconds SystemTime          = { };
+	uint64_t                 ResidentBytes       = 0;
+	uint64_t                 ProportionalBytes   = 0; // Resident memory with shared pages divided among the processes that map them. Only with XY_PROCESS_STATS_PSS.
+	uint64_t                 MajorFaults         = 0; // Page faults that had to wait for I/O
+	uint64_t                 MinorFaults         = 0;
+	uint64_t                 VoluntarySwitches   = 0; // Context switches where a thread blocked
+	uint64_t                 InvoluntarySwitches = 0; // Context switches where a thread was preempted
+	uint32_t                 OpenFiles           = 0; // Only with XY_PROCESS_STATS_OPEN_FILES
+	bool                     Valid               = false;
+
+}; // xyProcessStats
+
+struct xyThreadStats
+{
+	operator bool( void ) const { return Valid; }
+
+	uint32_t                 ThreadID            = 0;
+	std::chrono::nanoseconds UserTime            = { };
+	std::chrono::nanoseconds SystemTime          = { };
+	std::chrono::nanoseconds RunDelay            = { }; // Time spent ready to run but waiting for a CPU
+	uint64_t                 MajorFaults         = 0;
+	uint64_t                 MinorFaults         = 0;
+	uint64_t                 VoluntarySwitches   = 0;
+	uint64_t                 InvoluntarySwitches = 0;
+	bool                     Valid               = false;
+
+}; // xyThreadStats
+
+struct xyWatchdogStall
+{
+	xyInlineString< 31 >           Name;
+	uint32_t                       ThreadID  = 0;
+	std::chrono::nanoseconds       Duration  = { };    // Since the last heartbeat. When recovered, this is how long the stall lasted in total.
+	bool                           Recovered = false;  // Whether the thread has started beating again after a stall that was already reported
+	xySmallVector< uintptr_t, 32 > Frames;             // Return addresses at the time the stall was detected, innermost first. Empty if the stack could not be captured.
+
+}; // xyWatchdogStall
+
+using xyWatchdogCallback = void( * )( const xyWatchdogStall& rStall, void* pUserData );
+
+struct xyWatchdogThreadImpl;
+
+struct xyWatchdogHeartbeat
+{
+	operator bool( void ) const { return pImpl != nullptr; }
+
+	std::shared_ptr< xyWatchdogThreadImpl > pImpl;
+	std::atomic< uint32_t >*                pBeat = nullptr; // Cached, so that a heartbeat does not have to reach into the implementation
+
+}; // xyWatchdogHeartbeat
+
+struct xyPowerPolicy
+{
+	std::array< uint8_t, 3 >  BatteryPercentages    = { 50, 20, 10 };          // On battery power, the tier drops to Balanced, Reduced and Minimal at or below these levels
+	std::array< float, 3 >    Temperatures          = { 70.0f, 80.0f, 90.0f }; // The tier drops to Balanced, Reduced and Minimal when the hottest thermal zone reaches these temperatures, in degrees Celsius
+	float                     TemperatureHysteresis = 5.0f;                    // How far the temperature has to fall below a threshold before the tier recovers
+	std::array< float, 4 >    TickRateScales        = { 1.0f, 0.75f, 0.5f, 0.25f }; // Fraction of the full tick rate to run at in each tier
+	std::array< float, 4 >    WorkerScales          = { 1.0f, 0.5f, 0.25f, 0.0f };  // Fraction of the xy worker threads to keep running in each tier. At least one is always kept. With io_uring, this limits the file requests in flight instead.
+	std::chrono::milliseconds PollInterval          = std::chrono::seconds( 2 );
+
+}; // xyPowerPolicy
+
+struct xyPowerState
+{
+	xyPerformanceTier       Tier = xyPerformanceTier::Full;
+	xyBatteryState          Battery;
+	std::optional< float >  Temperature; // Of the hottest thermal zone, in degrees Celsius, if it could be read
+
+}; // xyPowerState
+
+using xyPowerCallback = void( * )( const xyPowerState& rState, void* pUserData );
+
+struct xyConfigurationEvent
+{
+	xyConfigurationChange Type;
+	xyTheme               Theme  = xyTheme::Light; // The new theme, for Theme changes
+	uint32_t              UIMode = 0x0;            // The new UI mode, for UIMode changes. Also stored in xyContext::UIMode.
+
+}; // xyConfigurationEvent
+
+using xyConfigurationCallback = void( * )( const xyConfigurationEvent& rEvent, void* pUserData );
+
+struct xyConfigurationSubscriptionImpl;
+
+struct xyConfigurationSubscription
+{
+	operator bool( void ) const { return pImpl != nullptr; }
+
+	std::shared_ptr< xyConfigurationSubscriptionImpl > pImpl;
+
+}; // xyConfigurationSubscription
+
+/**
+ * Interface that the device, theme, language, battery, thermal and display getters are routed through once installed with xySetBackend.
+ * Allows code that depends on platform behavior to run against a simulated or recorded platform.
+ */
+struct xyBackend
+{
+	virtual ~xyBackend( void ) = default;
+
+	virtual xyPmrDevice                             GetDevice         ( std::pmr::memory_resource* pMemoryResource ) = 0;
+	virtual xyTheme                                 GetPreferredTheme ( void ) = 0;
+	virtual xyPmrLanguage                           GetLanguage       ( std::pmr::memory_resource* pMemoryResource ) = 0;
+	virtual xyBatteryState                          GetBatteryState   ( void ) = 0;
+	virtual xyThermalState                          GetThermalState   ( void ) = 0;
+	virtual std::pmr::vector< xyPmrDisplayAdapter > GetDisplayAdapters( std::pmr::memory_resource* pMemoryResource ) = 0;
+
+	// Backends have no change notifications, so configuration subscribers compare the getters at this interval instead
+	virtual std::chrono::milliseconds               GetPollInterval   ( void ) { return std::chrono::seconds( 1 ); }
+
+}; // xyBackend
+
+struct xySimulatedSample
+{
+	std::chrono::milliseconds Time;
+	float                     Value;
+
+}; // xySimulatedSample
+
+struct xySimulatedPlatform
+{
+	std::string                       DeviceName        = "xy Simulator";
+	std::string                       LocaleName        = "en-US";
+	uint32_t                          DisplayCount      = 1;
+	int32_t                           DisplayWidth      = 1920;                      // Displays are placed side by side
+	int32_t                           DisplayHeight     = 1080;
+	int32_t                           WorkAreaInset     = 40;                        // Taken off the bottom of each display to form the work area
+	std::vector< xySimulatedSample >  BatteryCurve;                                  // Capacity percentage over time, charging while rising. No battery if empty.
+	std::vector< xySimulatedSample >  TemperatureCurve;                              // Degrees Celsius over time. No thermal zones if empty.
+	bool                              LoopCurves        = true;                      // Whether to start over after the last sample, or hold it
+	xyTheme                           Theme             = xyTheme::Light;
+	std::chrono::milliseconds         ThemeFlipInterval = std::chrono::milliseconds( 0 ); // How often to switch between light and dark, or 0 for never
+	std::chrono::microseconds         Latency           = std::chrono::microseconds( 0 ); // How long each getter takes to return
+	std::chrono::microseconds         LatencyJitter     = std::chrono::microseconds( 0 ); // Up to this much is added to the latency, pseudo-randomly
+	uint64_t                          Seed              = 1;                         // Seeds the jitter, so that a run can be repeated exactly
+	bool                              RealTime          = true;                      // Whether time passes on its own, or only through xySimulatedBackend::Advance
+	std::chrono::milliseconds         PollInterval      = std::chrono::milliseconds( 100 );
+
+}; // xySimulatedPlatform
+
+struct xySimulatedBackendImpl;
+
+/**
+ * Deterministic stand-in for the platform, for load testing code that polls or subscribes to the getters on any host.
+ * Presents a configurable number of displays and follows scripted battery and temperature curves over time.
+ */
+struct xySimulatedBackend : xyBackend
+{
+	explicit xySimulatedBackend( const xySimulatedPlatform& rPlatform = { } );
+
+	xyPmrDevice                             GetDevice         ( std::pmr::memory_resource* pMemoryResource ) override;
+	xyTheme                                 GetPreferredTheme ( void ) override;
+	xyPmrLanguage                           GetLanguage       ( std::pmr::memory_resource* pMemoryResource ) override;
+	xyBatteryState                          GetBatteryState   ( void ) override;
+	xyThermalState                          GetThermalState   ( void ) override;
+	std::pmr::vector< xyPmrDisplayAdapter > GetDisplayAdapters( std::pmr::memory_resource* pMemoryResource ) override;
+	std::chrono::milliseconds               GetPollInterval   ( void ) override;
+
+	/**
+	 * Replaces the simulated platform while it is in use, such as to plug in a display. The simulated time is kept.
+	 */
+	void Configure( const xySimulatedPlatform& rPlatform );
+
+	/**
+	 * Moves the simulated time forward. This is the only way time passes when RealTime is false.
+	 */
+	void Advance( std::chrono::milliseconds Duration );
+
+	/**
+	 * @return How many times the getters have been called, for measuring how often the code under test polls.
+	 */
+	uint64_t GetCallCount( void ) const;
+
+	std::shared_ptr< xySimulatedBackendImpl > pImpl;
+
+}; // xySimulatedBackend
+
+struct xyTelemetryCounter
+{
+	xyInlineString< 31 > Name;
+	int64_t              Value = 0;
+
+}; // xyTelemetryCounter
+
+struct xyTelemetryThread
+{
+	xyInlineString< 15 >     Name;
+	uint32_t                 ID      = 0;
+	char                     State   = '?';                          // As reported by /proc, such as 'R' for running and 'S' for sleeping
+	std::chrono::nanoseconds CpuTime = std::chrono::nanoseconds( 0 ); // User and kernel time combined
+
+}; // xyTelemetryThread
+
+struct xyTelemetrySnapshot
+{
+	uint32_t                                ProcessID                   = 0;
+	uint64_t                                Updates                     = 0; // How many times the segment has been published
+	std::chrono::nanoseconds                Uptime                      = std::chrono::nanoseconds( 0 ); // Since the entry point was called
+	xyBatteryState                          Battery;
+	std::optional< float >                  Temperature;                     // Of the hottest thermal zone, in degrees Celsius
+	xyThermalStatus                         ThermalStatus               = xyThermalStatus::None;
+	xyPerformanceTier                       Tier                        = xyPerformanceTier::Full;
+	uint64_t                                LogBacklog                  = 0; // Bytes written to the thread log buffers but not yet drained
+	uint64_t                                LogDropped                  = 0; // Messages dropped because a thread log buffer was full
+	uint32_t                                PendingFileRequests         = 0;
+	uint32_t                                PendingConfigurationChanges = 0;
+	xySmallVector< xyTelemetryCounter, 16 > Counters;
+	xySmallVector< xyTelemetryThread, 16 >  Threads;
+
+}; // xyTelemetrySnapshot
+
+struct xyChannelMessage
+{
+	std::span< std::byte > Data;         // Where the message is to be written, directly in shared memory. Empty if there was no room.
+	uint64_t               Position = 0;
+
+}; // xyChannelMessage
+
+struct xyChannelImpl;
+
+struct xyChannel
+{
+	operator bool( void ) const { return pImpl != nullptr; }
+
+	std::shared_ptr< xyChannelImpl > pImpl;
+
+}; // xyChannel
+
+struct xyChannelListenerImpl;
+
+struct xyChannelListener
+{
+	operator bool( void ) const { return pImpl != nullptr; }
+
+	std::shared_ptr< xyChannelListenerImpl > pImpl;
+
+}; // xyChannelListener
+
+/**
+ * Hashes a string with 64-bit FNV-1a. Usable in constant expressions.
+ *
+ * @param String The string.
+ * @return The hash.
+ */
+constexpr uint64_t xyHashString( std::string_view String )
+{
+	uint64_t Hash = 0xCBF29CE484222325ull;
+
+	for( char Character : String )
+		Hash = ( Hash ^ static_cast< uint8_t >( Character ) ) * 0x100000001B3ull;
+
+	return Hash;
+
+} // xyHashString
+
+struct xyLocalizationKey
+{
+	// String literals are hashed at compile time
+	template< size_t Size >
+	consteval xyLocalizationKey( const char( &rKey )[ Size ] ) : Name( rKey, Size - 1 ), Hash( xyHashString( Name ) ) { }
+
+	explicit constexpr xyLocalizationKey( std::string_view Key ) : Name( Key ), Hash( xyHashString( Key ) ) { }
+
+	std::string_view Name; // Returned by xyLocalize when the catalog has no text for the key
+	uint64_t         Hash;
+
+}; // xyLocalizationKey
+
+struct xyLocalizationEntry
+{
+	std::string_view Key;
+	std::string_view Text;
+
+}; // xyLocalizationEntry
+
+struct xyTelemetryViewImpl;
+
+struct xyTelemetryView
+{
+	operator bool( void ) const { return pImpl != nullptr; }
+
+	std::shared_ptr< xyTelemetryViewImpl > pImpl;
+
+}; // xyTelemetryView
+
+using xyMessageCallback = void( * )( xyMessageResult Result, void* pUserData );
+
+/**
+ * Bump allocator that hands out memory from a chain of large blocks.
+ * Deallocation is a no-op; all memory is reclaimed at once by calling Reset, after which the blocks are reused.
+ * This makes it suitable for per-frame allocations where nothing outlives the frame.
+ */
+struct xyArena : std::pmr::memory_resource
+{
+	explicit xyArena( size_t BlockSize = 64 * 1024, std::pmr::memory_resource* pUpstream = std::pmr::new_delete_resource() );
+	        ~xyArena( void ) override;
+
+	xyArena( const xyArena& ) = delete;
+	xyArena& operator=( const xyArena& ) = delete;
+
+	/**
+	 * Rewinds the arena to the beginning of its first block. Every allocation made before this call becomes invalid.
+	 * The blocks themselves are kept, so a steady-state workload stops hitting the upstream resource.
+	 */
+	void Reset( void );
+
+	/**
+	 * @return The number of bytes handed out since the last reset, including alignment padding.
+	 */
+	size_t GetBytesUsed( void ) const;
+
+	/**
+	 * @return The total size of all blocks obtained from the upstream resource.
+	 */
+	size_t GetBytesReserved( void ) const;
+
+protected:
+
+	void* do_allocate  ( size_t Bytes, size_t Alignment ) override;
+	void  do_deallocate( void* pPointer, size_t Bytes, size_t Alignment ) override;
+	bool  do_is_equal  ( const std::pmr::memory_resource& rOther ) const noexcept override;
+
+private:
+
+	struct Block
+	{
+		Block* pNext;
+		size_t Size;
+
+	}; // Block
+
+	std::pmr::memory_resource* pUpstream;
+	Block*                     pFirstBlock   = nullptr;
+	Block*                     pCurrentBlock = nullptr;
+	std::byte*                 pCursor       = nullptr;
+	std::byte*                 pEnd          = nullptr;
+	size_t                     BlockSize;
+	size_t                     BytesUsedInPreviousBlocks = 0;
+
+}; // xyArena
+
+struct xyMemoryReservation
+{
+	operator bool( void ) const { return pAddress != nullptr; }
+
+	std::byte* pAddress = nullptr;
+	size_t     Size     = 0;
+	size_t     PageSize = 0;
+	uint32_t   Flags    = 0x0; // The XY_MEMORY_* flags that were actually honored. Huge pages fall back to regular pages when unavailable.
+
+}; // xyMemoryReservation
+
+struct xyMappedFile
+{
+	xyMappedFile( void ) = default;
+	xyMappedFile( xyMappedFile&& rrOther ) noexcept;
+	~xyMappedFile( void );
+
+	xyMappedFile& operator=( xyMappedFile&& rrOther ) noexcept;
+
+	operator bool( void ) const { return Data.data() != nullptr; }
+	operator std::span< const std::byte >( void ) const { return Data; }
+
+	std::span< const std::byte > Data;
+	void*                        pAsset = nullptr; // AAsset* when the data comes from the Android asset manager
+
+}; // xyMappedFile
+
+struct xyFile
+{
+	operator bool( void ) const { return NativeHandle != -1; }
+
+	intptr_t NativeHandle = -1; // File descriptor on POSIX systems, HANDLE on Windows
+
+}; // xyFile
+
+struct xyFileCompletion
+{
+	operator bool( void ) const { return Result >= 0; }
+
+	std::span< std::byte > Buffer;
+	uint64_t               Offset    = 0;
+	int64_t                Result    = 0;       // The number of bytes transferred, or a negated system error code
+	void*                  pUserData = nullptr;
+
+}; // xyFileCompletion
+
+using xyFileCallback = void( * )( const xyFileCompletion& rCompletion );
+
+struct xyFileEvent
+{
+	std::string_view Path; // Relative to the watched directory, using forward slashes
+	xyFileEventType  Type;
+
+}; // xyFileEvent
+
+using xyFileEventCallback = void( * )( std::span< const xyFileEvent > Events, void* pUserData );
+
+struct xyDirectoryWatchImpl;
+
+struct xyDirectoryWatch
+{
+	operator bool( void ) const { return pImpl != nullptr; }
+
+	std::shared_ptr< xyDirectoryWatchImpl > pImpl;
+
+}; // xyDirectoryWatch
+
+struct xyPreferencesImpl;
+
+struct xyPreferences
+{
+	operator bool( void ) const { return pImpl != nullptr; }
+
+	std::shared_ptr< xyPreferencesImpl > pImpl;
+
+}; // xyPreferences
+
+struct xyPreferenceValue
+{
+	xyPreferenceValue( void ) = default;
+	xyPreferenceValue( xyPreferenceValue&& rrOther ) noexcept;
+	~xyPreferenceValue( void );
+
+	xyPreferenceValue& operator=( xyPreferenceValue&& rrOther ) noexcept;
+
+	operator bool( void ) const { return pReaders != nullptr; }
+	operator std::string_view( void ) const { return Value; }
+
+	std::string_view         Value;
+	std::atomic< uint32_t >* pReaders = nullptr; // Counts the values that point into the same mapping of the log, which is kept until they have all been released
+
+}; // xyPreferenceValue
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Functions
+
+/**
+ * Obtains the internal xy context where all the global data is stored
+ *
+ * @return A reference to the context data.
+ */
+extern xyContext& xyGetContext( void );
+
+/**
+ * Records how long it took to reach a point during startup. Used by the entry points, and by apps that want to profile their own startup, such as up to the first frame.
+ * Not synchronized, since startup runs on one thread at a time.
+ *
+ * @param pName The name of the phase that just completed. Has to outlive the context, such as a string literal.
+ */
+extern void xyMarkStartupPhase( const char* pName );
+
+/**
+ * Obtains the timestamps recorded during startup, for tracking how long it takes before the app can do anything.
+ *
+ * @return The startup profile.
+ */
+extern xyStartupProfile xyGetStartupProfile( void );
+
+/**
+ * Convert a unicode string to UTF-8.
+ *
+ * @return A UTF-8 string.
+ */
+extern std::string xyUTF( std::wstring_view String );
+
+/**
+ * Convert a UTF-8 to Unicode.
+ *
+ * @return A Unicode string.
+ */
+extern std::wstring xyUnicode( std::string_view String );
+
+/**
+ * Prompts a system message box containing a user-defined message and a set of options in the form of buttons.
+ * The current thread is blocked until a selection has been made.
+ *
+ * @param Title The title of the message box window.
+ * @param Message The content of the message text box.
+ * @param Buttons The range of button options to present.
+ * @return The result that was selected.
+ */
+extern xyMessageResult xyMessageBox( std::string_view Title, std::string_view Message, xyMessageButtons Buttons );
+
+/**
+ * Prompts a system message box containing a user-defined message and an 'OK' button.
+ * The current thread is blocked until the message box is closed.
+ *
+ * @param Title The title of the message box window.
+ * @param Message The content of the message text box.
+ */
+extern void xyMessageBox( std::string_view Title, std::string_view Message );
+
+/**
+ * Prompts a system message box without blocking the current thread.
+ * The message box is served by a worker thread owned by the context, and prompts that are opened while another one is open are shown in turn.
+ * When the context is destroyed, prompts that have not been shown yet are given the default answer. So is a terminal prompt that is still waiting for input on Linux, while the open prompt is waited for on other platforms.
+ *
+ * @param Title The title of the message box window.
+ * @param Message The content of the message text box.
+ * @param Buttons The range of button options to present.
+ * @return A future that becomes ready once a selection has been made.
+ */
+extern std::future< xyMessageResult > xyMessageBoxAsync( std::string_view Title, std::string_view Message, xyMessageButtons Buttons );
+
+/**
+ * Prompts a system message box without blocking the current thread.
+ *
+ * @param Title The title of the message box window.
+ * @param Message The content of the message text box.
+ * @param Buttons The range of button options to present.
+ * @param Callback The function that receives the result. It is invoked on the thread that served the message box.
+ * @param pUserData An optional pointer that is passed along to the callback.
+ */
+extern void xyMessageBoxAsync( std::string_view Title, std::string_view Message, xyMessageButtons Buttons, xyMessageCallback Callback, void* pUserData = nullptr );
+
+/**
+ * Sets the answer that message boxes give when nobody can answer them, such as when stdin is not a terminal on a headless Linux system.
+ * If the answer is not one of the options of a message box, or if none is set, the first option is picked.
+ *
+ * @param Result The default answer, or nothing to pick the first option.
+ */
+extern void xySetDefaultMessageResult( std::optional< xyMessageResult > Result );
+
+/**
+ * Obtains the arena belonging to the calling thread.
+ * Pass it to the memory resource overloads of the getters below and call Reset once per frame.
+ *
+ * @return A reference to the thread-local arena.
+ */
+extern xyArena& xyGetThreadArena( void );
+
+/**
+ * Obtains information about the current device.
+ *
+ * @return The device data.
+ */
+extern xyDevice xyGetDevice( void );
+
+/**
+ * Obtains information about the current device.
+ *
+ * @param pMemoryResource The memory resource that the strings are allocated from.
+ * @return The device data.
+ */
+extern xyPmrDevice xyGetDevice( std::pmr::memory_resource* pMemoryResource );
+
+/**
+ * Obtains information about the current device without allocating.
+ * Names that do not fit are truncated at a UTF-8 character boundary.
+ *
+ * @param rDevice The device data.
+ */
+extern void xyGetDevice( xyInlineDevice& rDevice );
+
+/**
+ * Obtains the preferred theme of this device.
+ *
+ * @return The theme enumerator.
+ */
+extern xyTheme xyGetPreferredTheme( void );
+
+/**
+ * Obtains the system language.
+ *
+ * @return The language code.
+ */
+extern xyLanguage xyGetLanguage( void );
+
+/**
+ * Obtains the system language.
+ *
+ * @param pMemoryResource The memory resource that the strings are allocated from.
+ * @return The language code.
+ */
+extern xyPmrLanguage xyGetLanguage( std::pmr::memory_resource* pMemoryResource );
+
+/**
+ * Obtains the system language without allocating.
+ * Names that do not fit are truncated at a UTF-8 character boundary.
+ *
+ * @param rLanguage The language code.
+ */
+extern void xyGetLanguage( xyInlineLanguage& rLanguage );
+
+/**
+ * Obtains the state of the battery power source on this device.
+ *
+ * Note: The battery state has a Valid field that is set to true if battery information was successfully obtained.
+ * If it is false, that either means that the device is only using electric power, or that an error occurred.
+ * Either way, the battery state provides a boolean operator that allows you to write code like this:
+ * 
+ * if( xyBatteryState State = xyGetBatteryState() )
+ * {
+ *     // Successfully obtained the battery state!
+ * }
+ *
+ * @return The battery state.
+ */
+extern xyBatteryState xyGetBatteryState( void );
+
+/**
+ * Obtains the temperature of every thermal zone, the frequency of every CPU core and whether the system is throttling.
+ * Sysfs attributes are opened on the first call and kept open, so polling only costs one pread per value.
+ *
+ * Note: Zones and cores are read from sysfs on Linux and Android. Android additionally reports the PowerManager thermal status,
+ * Windows reports core frequencies and Apple platforms report the thermal state of NSProcessInfo.
+ *
+ * @return The thermal state, which evaluates to false if nothing could be read.
+ */
+extern xyThermalState xyGetThermalState( void );
+
+/**
+ * Reads sysfs from a different root directory, so that the thermal state can be fed from a fixture that mimics /sys.
+ * Any open attributes are closed, and reopened under the new root on the next call to xyGetThermalState.
+ *
+ * @param Root The directory that contains the fake sys directory, or an empty string for the real one.
+ */
+extern void xySetSysfsRoot( std::string_view Root );
+
+/**
+ * Obtains the mounted storage volumes along with the I/O characteristics of the devices behind them.
+ * Pseudo file systems without any capacity, such as proc and sysfs, are left out.
+ *
+ * Note: On Linux and Android, device characteristics are read from the queue attributes in sysfs, which honors xySetSysfsRoot.
+ * Windows does not report the queue depth, and Apple platforms do not report rotational devices or discard support.
+ *
+ * @return A vector of storage volumes.
+ */
+extern std::vector< xyStorageVolume > xyGetStorageVolumes( void );
+
+/**
+ * Obtains the storage volume that holds a path, such as where the app keeps its data.
+ *
+ * @param Path A path to an existing file or directory.
+ * @return The volume, or nothing if it could not be determined.
+ */
+extern std::optional< xyStorageVolume > xyGetStorageVolume( std::string_view Path );
+
+/**
+ * Obtains the network interfaces of the device along with their addresses and link characteristics.
+ * Subscribe to xyConfigurationChange::Network to find out when interfaces come and go, or when their addresses or links change.
+ *
+ * Note: Link speed and duplex are read from sysfs and offloads from ethtool on Linux and Android.
+ * Windows reports speed but not duplex, queues or offloads, and Apple platforms only report the MTU and speed.
+ *
+ * @return A vector of network interfaces.
+ */
+extern std::vector< xyNetworkInterface > xyGetNetworkInterfaces( void );
+
+/**
+ * Samples the resource usage of the process. Cheap enough to call at 100 Hz in production builds, unless optional stats are requested.
+ * Counters are cumulative since the process started, so take the difference between two samples to get a rate.
+ *
+ * Note: Windows counts every page fault as minor and does not report context switches.
+ * Apple platforms do not report open files, and proportional memory is only reported on Linux and Android.
+ *
+ * @param Flags XY_PROCESS_STATS_* flags for optional stats that cost more to gather.
+ * @return The stats, which evaluate to false if they could not be read.
+ */
+extern xyProcessStats xyGetProcessStats( uint32_t Flags = 0x0 );
+
+/**
+ * Samples the resource usage of the calling thread.
+ *
+ * @return The stats, which evaluate to false if they could not be read.
+ */
+extern xyThreadStats xyGetThreadStats( void );
+
+/**
+ * Samples the resource usage of another thread in the process.
+ * On Linux and Android, the proc files of the thread are opened on the first call and kept open. Once the thread has exited, they are closed by a later call to this or xyGetProcessStats.
+ *
+ * @param ThreadID The ID of the thread, as returned by xyGetThreadID on that thread.
+ * @return The stats, which evaluate to false if the thread does not exist.
+ */
+extern xyThreadStats xyGetThreadStats( uint32_t ThreadID );
+
+/**
+ * @return The system-wide ID of the calling thread, as shown by debuggers and profilers.
+ */
+extern uint32_t xyGetThreadID( void );
+
+/**
+ * Starts a thread that checks the heartbeats of the registered threads and reports the ones that miss their deadlines.
+ * The callback is called on the watchdog thread, once when a stall is detected and once more when the thread recovers.
+ *
+ * Note: Stacks are only captured on Linux and Android, by interrupting the stalled thread with the XY_WATCHDOG_SIGNAL real-time signal.
+ * The unwinder is not async-signal-safe, so a capture that does not finish in time is given up on. No more stacks are captured until it does finish.
+ *
+ * @param Callback The function that is called for every stall.
+ * @param pUserData Optional data that gets passed to the callback.
+ * @param CheckInterval How often heartbeats are checked, which bounds how late a stall is detected.
+ * @return Whether the watchdog was started. Fails if it is already running.
+ */
+extern bool xyStartWatchdog( xyWatchdogCallback Callback, void* pUserData = nullptr, std::chrono::milliseconds CheckInterval = std::chrono::milliseconds( 100 ) );
+
+/**
+ * Stops the watchdog thread. Registered threads stay registered.
+ */
+extern void xyStopWatchdog( void );
+
+/**
+ * Registers the calling thread with the watchdog. The thread then has to call xyHeartbeat more often than the deadline, such as once per frame or loop iteration.
+ * No thread is registered automatically, including the one that runs xyMain. To watch it, call this from xyMain and keep the heartbeat for as long as xyMain runs.
+ *
+ * @param Name A name for the thread that is passed on in stall reports.
+ * @param Deadline How long the thread may go without a heartbeat before it is considered stalled.
+ * @return The heartbeat, which unregisters the thread when it is destroyed.
+ */
+extern xyWatchdogHeartbeat xyRegisterWatchdogThread( std::string_view Name, std::chrono::milliseconds Deadline );
+
+/**
+ * Obtains the display adapters connected to the device.
+ *
+ * @return A vector of display adapters.
+ */
+extern std::vector< xyDisplayAdapter > xyGetDisplayAdapters( void );
+
+/**
+ * Obtains the display adapters connected to the device.
+ *
+ * @param pMemoryResource The memory resource that the vector and the strings are allocated from.
+ * @return A vector of display adapters.
+ */
+extern std::pmr::vector< xyPmrDisplayAdapter > xyGetDisplayAdapters( std::pmr::memory_resource* pMemoryResource );
+
+/**
+ * Obtains the display adapters connected to the device. Up to four adapters are stored without allocating.
+ * Names that do not fit are truncated at a UTF-8 character boundary.
+ *
+ * @param rDisplayAdapters The vector that the display adapters are stored in. Any previous contents are replaced.
+ */
+extern void xyGetDisplayAdapters( xySmallVector< xyInlineDisplayAdapter, 4 >& rDisplayAdapters );
+
+/**
+ * Routes the device, theme, language, battery, thermal and display getters through a backend instead of the platform.
+ * Should be installed before subscribing to configuration changes, so that the subscription polls the backend.
+ *
+ * @param pBackend The backend, which has to outlive its use. Pass nullptr to go back to the platform.
+ */
+extern void xySetBackend( xyBackend* pBackend );
+
+/**
+ * @return The backend installed with xySetBackend, or nullptr if the getters talk to the platform.
+ */
+extern xyBackend* xyGetBackend( void );
+
+/**
+ * Reserves a range of virtual address space without backing it with physical memory.
+ * The range never moves, so buffers built on top of it can grow in place by committing more of it.
+ *
+ * @param Size The number of bytes to reserve. Rounded up to a multiple of the page size.
+ * @param Flags A combination of XY_MEMORY_* flags.
+ * @return The reservation, which evaluates to false on failure.
+ */
+extern xyMemoryReservation xyReserveMemory( size_t Size, uint32_t Flags = 0x0 );
+
+/**
+ * Backs a part of a reservation with readable and writable memory.
+ *
+ * @param rReservation The reservation returned by xyReserveMemory.
+ * @param Offset The byte offset into the reservation. Rounded down to a page boundary.
+ * @param Size The number of bytes to commit. Rounded up to a page boundary.
+ * @return True if the memory was committed. Pages in the range that were already committed keep their contents.
+ */
+extern bool xyCommitMemory( const xyMemoryReservation& rReservation, size_t Offset, size_t Size );
+
+/**
+ * Returns the physical memory behind a part of a reservation to the system, while keeping the address range reserved.
+ *
+ * @param rReservation The reservation returned by xyReserveMemory.
+ * @param Offset The byte offset into the reservation. Rounded up to a page boundary.
+ * @param Size The number of bytes to decommit. Rounded down to a page boundary.
+ * @return True if the memory was decommitted.
+ */
+extern bool xyDecommitMemory( const xyMemoryReservation& rReservation, size_t Offset, size_t Size );
+
+/**
+ * Releases the entire address range of a reservation.
+ *
+ * @param rReservation The reservation returned by xyReserveMemory. It is reset to an empty state.
+ */
+extern void xyReleaseMemory( xyMemoryReservation& rReservation );
+
+/**
+ * Maps a file into memory for reading. The data is paged in on demand and is never copied.
+ * On Android, relative paths are looked up in the application's assets.
+ *
+ * Note: Empty files can not be mapped and produce an invalid mapping.
+ *
+ * @param Path The path of the file.
+ * @param AccessPattern A hint about how the data is going to be read, which steers read-ahead.
+ * @return The mapped file, which evaluates to false on failure. The mapping is released when it is destroyed.
+ */
+extern xyMappedFile xyMapFile( std::string_view Path, xyAccessPattern AccessPattern = xyAccessPattern::Normal );
+
+/**
+ * Asks the system to start reading a range of a mapped file into memory ahead of time.
+ *
+ * @param rFile The mapped file.
+ * @param Offset The byte offset of the range.
+ * @param Size The number of bytes in the range. Clamped to the end of the file.
+ */
+extern void xyPrefetchMappedFile( const xyMappedFile& rFile, size_t Offset = 0, size_t Size = SIZE_MAX );
+
+/**
+ * Opens a file for use with the asynchronous file functions.
+ *
+ * @param Path The path of the file.
+ * @param Mode Whether the file is going to be read from, written to, or both.
+ * @return The file, which evaluates to false on failure.
+ */
+extern xyFile xyOpenFile( std::string_view Path, xyFileMode Mode );
+
+/**
+ * Closes a file opened with xyOpenFile. There must not be any requests in flight for it.
+ *
+ * @param rFile The file. It is reset to an invalid state.
+ */
+extern void xyCloseFile( xyFile& rFile );
+
+/**
+ * Queues an asynchronous read. Queued requests are not started until xySubmitFileRequests is called,
+ * which allows a whole batch of requests to be handed to the system at once.
+ *
+ * Note: On Linux, requests are executed by io_uring when the kernel supports it. Otherwise they are executed by a small pool of worker threads.
+ *
+ * @param rFile The file to read from.
+ * @param Offset The byte offset in the file to start reading at.
+ * @param Buffer The destination. It must stay alive until the completion has been delivered.
+ * @param Callback The function that gets called from xyPollFileCompletions once the read has finished.
+ * @param pUserData An optional pointer that is passed along to the callback.
+ */
+extern void xyReadFileAsync( const xyFile& rFile, uint64_t Offset, std::span< std::byte > Buffer, xyFileCallback Callback, void* pUserData = nullptr );
+
+/**
+ * Queues an asynchronous write. See xyReadFileAsync.
+ *
+ * @param rFile The file to write to.
+ * @param Offset The byte offset in the file to start writing at.
+ * @param Buffer The source data. It must stay alive until the completion has been delivered.
+ * @param Callback The function that gets called from xyPollFileCompletions once the write has finished.
+ * @param pUserData An optional pointer that is passed along to the callback.
+ */
+extern void xyWriteFileAsync( const xyFile& rFile, uint64_t Offset, std::span< const std::byte > Buffer, xyFileCallback Callback, void* pUserData = nullptr );
+
+/**
+ * Hands all queued requests to the system in as few calls as possible.
+ * Requests that do not fit in the submission queue stay queued and are submitted by a later call.
+ *
+ * @return The number of requests that were submitted.
+ */
+extern size_t xySubmitFileRequests( void );
+
+/**
+ * Delivers finished requests by invoking their callbacks on the calling thread.
+ * Requests that were waiting for room in the submission queue are submitted afterwards.
+ *
+ * @param Wait Whether to block until at least one request has finished, if any are in flight.
+ * @return The number of completions that were delivered.
+ */
+extern size_t xyPollFileCompletions( bool Wait = false );
+
+/**
+ * Registers a set of buffers with the I/O engine, replacing any previous set.
+ * Requests whose buffers lie within a registered buffer skip the per-request page pinning of the kernel.
+ * There must not be any requests in flight when calling this.
+ *
+ * @param Buffers The buffers to register. Pass an empty span to unregister all buffers.
+ * @return True if the buffers were registered with the kernel. The set is still used for bookkeeping if this returns false.
+ */
+extern bool xyRegisterFileBuffers( std::span< const std::span< std::byte > > Buffers );
+
+/**
+ * Starts watching a directory for changes on a background thread.
+ * Events are collected for the duration of the coalescing window, starting at the first event, and are then made available as one batch.
+ * Multiple events for the same path within a batch are merged into one.
+ * The watch stops once the last copy of the returned handle is destroyed.
+ *
+ * Note: Implemented using inotify on Linux and Android, and ReadDirectoryChangesW on Windows. Apple platforms are not supported and always get an invalid handle.
+ *
+ * @param Path The directory to watch.
+ * @param Recursive Whether to watch subdirectories as well.
+ * @param CoalescingWindow How long to wait for more events before making a batch available.
+ * @return The watch handle, which evaluates to false on failure.
+ */
+extern xyDirectoryWatch xyWatchDirectory( std::string_view Path, bool Recursive = true, std::chrono::milliseconds CoalescingWindow = std::chrono::milliseconds( 100 ) );
+
+/**
+ * Delivers the batch of events that has been collected since the last call, by invoking a callback on the calling thread.
+ * The event storage is reused between batches, so the paths are only valid during the callback.
+ *
+ * @param rWatch The watch handle.
+ * @param Callback The function that receives the batch. It is not called if there are no events.
+ * @param pUserData An optional pointer that is passed along to the callback.
+ * @param Wait Whether to block until a batch becomes available.
+ * @return The number of events that were delivered.
+ */
+extern size_t xyDispatchDirectoryEvents( const xyDirectoryWatch& rWatch, xyFileEventCallback Callback, void* pUserData = nullptr, bool Wait = false );
+
+/**
+ * Opens a persistent key-value store, creating it if it does not exist.
+ * The store is a memory-mapped append-only log of checksummed records. A write appends one record without rewriting the file,
+ * and a torn record left behind by a killed process is detected and discarded the next time the store is opened.
+ *
+ * The file is placed in the application's files directory on Android, the Application Support directory on Apple platforms,
+ * %APPDATA% on Windows and $XDG_CONFIG_HOME (or ~/.config) on Linux.
+ *
+ * @param Name The name of the store, or an absolute path to the file.
+ * @param Capacity The largest size the log may grow to before it has to be compacted.
+ * @return The store, which evaluates to false on failure.
+ */
+extern xyPreferences xyOpenPreferences( std::string_view Name, size_t Capacity = 4 * 1024 * 1024 );
+
+/**
+ * Looks up a value without taking any locks or copying any data.
+ * The returned value points straight into the mapped log. It stays valid while it is held, even if the log is compacted in the meantime, but must not outlive the store.
+ * Release it once done with it, since a replaced log remains mapped for as long as a value points into it.
+ *
+ * @param rPreferences The store.
+ * @param Key The key to look up.
+ * @return The value, which evaluates to false if the key is not set.
+ */
+extern xyPreferenceValue xyGetPreference( const xyPreferences& rPreferences, std::string_view Key );
+
+/**
+ * Sets a value by appending a record to the log.
+ * The log is compacted first if the record would not fit.
+ *
+ * @param rPreferences The store.
+ * @param Key The key to set.
+ * @param Value The value. It may contain arbitrary bytes.
+ * @return True if the value was stored.
+ */
+extern bool xySetPreference( const xyPreferences& rPreferences, std::string_view Key, std::string_view Value );
+
+/**
+ * Removes a value by appending a tombstone record to the log.
+ *
+ * @param rPreferences The store.
+ * @param Key The key to remove.
+ * @return True if the key existed and was removed.
+ */
+extern bool xyRemovePreference( const xyPreferences& rPreferences, std::string_view Key );
+
+/**
+ * Rewrites the log without overwritten and removed records, and atomically replaces the old file with it.
+ * Readers may keep running. The old log stays mapped until the values that xyGetPreference returned from it have been released.
+ *
+ * @param rPreferences The store.
+ * @return True if the log was compacted.
+ */
+extern bool xyCompactPreferences( const xyPreferences& rPreferences );
+
+/**
+ * Flushes the log to storage. Not needed to survive the process being killed, but needed to survive a power loss.
+ *
+ * @param rPreferences The store.
+ */
+extern void xyFlushPreferences( const xyPreferences& rPreferences );
+
+/**
+ * Starts the background thread that formats and writes log messages.
+ *
+ * @param Sinks A combination of XY_LOG_SINK_* flags.
+ * @param FilePath The file that is written to if XY_LOG_SINK_FILE is set. It is overwritten if it exists.
+ * @param FileFormat The format of the log file. The other sinks always receive text.
+ * @param ThreadBufferSize The size of the buffer that each logging thread writes its messages to. Rounded up to a power of two.
+ * @return True if logging was started.
+ */
+extern bool xyStartLogging( uint32_t Sinks = XY_LOG_SINK_STDOUT, std::string_view FilePath = { }, xyLogFormat FileFormat = xyLogFormat::Text, size_t ThreadBufferSize = 64 * 1024 );
+
+/**
+ * Writes out all pending messages and stops the background thread.
+ */
+extern void xyStopLogging( void );
+
+/**
+ * Blocks until every message that was logged before the call has been written out.
+ */
+extern void xyFlushLog( void );
+
+/**
+ * Sets the least severe level that is logged. Messages below it are discarded before any arguments are captured.
+ *
+ * @param Level The minimum level.
+ */
+extern void xySetLogLevel( xyLogLevel Level );
+
+/**
+ * Turns a log file that was written in the binary format into text.
+ *
+ * @param Data The contents of the log file.
+ * @return The decoded messages, one per line.
+ */
+extern std::string xyDecodeLog( std::span< const std::byte > Data );
+
+/**
+ * Starts monitoring the battery and thermal state on a background thread, and derives a recommended performance tier from it.
+ * The tier is the lowest of what the battery level and the temperature call for. Running on external power never lowers it.
+ * Whenever the tier changes, the xy worker threads are throttled according to the policy, and the callback is invoked from the monitoring thread.
+ * When file I/O goes through io_uring, the number of requests in flight is throttled instead.
+ *
+ * @param Policy The thresholds and scales to apply.
+ * @param Callback An optional function that is notified when the tier changes, and once with the initial tier.
+ * @param pUserData An optional pointer that is passed along to the callback.
+ * @return True if monitoring was started.
+ */
+extern bool xyStartPowerPolicy( const xyPowerPolicy& Policy = { }, xyPowerCallback Callback = nullptr, void* pUserData = nullptr );
+
+/**
+ * Stops monitoring and lifts all throttling.
+ */
+extern void xyStopPowerPolicy( void );
+
+/**
+ * Obtains the current recommended performance tier. Cheap enough to call every frame.
+ *
+ * @return The tier, or Full if the power policy is not running.
+ */
+extern xyPerformanceTier xyGetPerformanceTier( void );
+
+/**
+ * Scales a tick interval by the tick rate of the current performance tier.
+ *
+ * @param FullSpeedInterval The interval to use at full performance.
+ * @return The interval to use in the current tier.
+ */
+extern std::chrono::nanoseconds xyGetTickInterval( std::chrono::nanoseconds FullSpeedInterval );
+
+/**
+ * Subscribes to changes of the theme, language, displays and UI mode, so that the getters don't need to be polled.
+ * Changes are detected by onConfigurationChanged on Android, a hidden window that receives WM_SETTINGCHANGE and WM_DISPLAYCHANGE on Windows,
+ * DRM hotplug uevents on Linux, and by comparing the getters once per second on Apple platforms.
+ * While a backend is installed with xySetBackend, the getters are compared at the interval that the backend asks for instead.
+ * The subscription ends once the last copy of the returned handle is destroyed.
+ * If that happens while xyDispatchConfigurationChanges runs on another thread, the callback may still receive the events of that dispatch.
+ *
+ * @param Callback The function that receives the events. It is invoked from xyDispatchConfigurationChanges.
+ * @param pUserData An optional pointer that is passed along to the callback.
+ * @return The subscription handle.
+ */
+extern xyConfigurationSubscription xySubscribeConfigurationChanges( xyConfigurationCallback Callback, void* pUserData = nullptr );
+
+/**
+ * Delivers the changes that have occurred since the last call to every subscriber, on the calling thread.
+ * Multiple changes of the same type are merged into the latest one. Cheap enough to call every frame.
+ *
+ * @param Wait Whether to block until a change occurs.
+ * @return The number of events that were delivered to each subscriber.
+ */
+extern size_t xyDispatchConfigurationChanges( bool Wait = false );
+
+/**
+ * Queues a change for delivery to all subscribers. Used by the platform backends, and by apps that detect changes on their own.
+ *
+ * @param Event The change.
+ */
+extern void xyPostConfigurationChange( const xyConfigurationEvent& Event );
+
+/**
+ * Claims a channel name so that other processes can connect to it with xyConnectChannel.
+ * Only one process at a time can listen on a name, which makes this a single-instance check as well: if it fails, another instance is running.
+ * The name is released automatically when the process exits, even if it crashes.
+ *
+ * Note: Channels are only implemented on Linux and Android.
+ *
+ * @param Name The name of the channel.
+ * @param Capacity How many bytes of messages each direction can hold before senders have to wait.
+ * @return The listener, which evaluates to false if the name is taken.
+ */
+extern xyChannelListener xyListenChannel( std::string_view Name, size_t Capacity = 1024 * 1024 );
+
+/**
+ * Accepts a connection from another process. The shared memory is created here and handed to the other process over the socket.
+ *
+ * @param rListener The listener.
+ * @param Wait Whether to block until a process connects.
+ * @return The channel, which evaluates to false if no process connected.
+ */
+extern xyChannel xyAcceptChannel( const xyChannelListener& rListener, bool Wait = true );
+
+/**
+ * Connects to a process that is listening on a channel name.
+ *
+ * @param Name The name of the channel.
+ * @return The channel, which evaluates to false if nothing is listening on the name.
+ */
+extern xyChannel xyConnectChannel( std::string_view Name );
+
+/**
+ * Reserves room for a message directly in the shared memory, so that it can be built without copying.
+ * Any number of threads may send on the same channel; messages are received in the order they were reserved.
+ *
+ * @param rChannel The channel.
+ * @param Size The size of the message. At most half the capacity of the channel.
+ * @param Wait Whether to block until there is room, rather than return an empty message.
+ * @return The message, which has to be passed to xyCommitChannelMessage once written.
+ */
+extern xyChannelMessage xyBeginChannelMessage( const xyChannel& rChannel, size_t Size, bool Wait = true );
+
+/**
+ * Makes a message reserved by xyBeginChannelMessage visible to the other process, and wakes it up if it is waiting.
+ */
+extern void xyCommitChannelMessage( const xyChannel& rChannel, const xyChannelMessage& rMessage );
+
+/**
+ * Copies a message into the channel. Shorthand for xyBeginChannelMessage and xyCommitChannelMessage.
+ *
+ * @return Whether the message was sent.
+ */
+extern bool xySendChannelMessage( const xyChannel& rChannel, std::span< const std::byte > Message, bool Wait = true );
+
+/**
+ * Obtains the next message from the other process, without copying it out of shared memory.
+ * Only one thread may receive on a channel. The message stays valid until xyReleaseChannelMessage is called.
+ *
+ * @param rChannel The channel.
+ * @param Wait Whether to block until a message arrives.
+ * @return The message, or nothing if there was none or the other process has disconnected.
+ */
+extern std::optional< std::span< const std::byte > > xyReceiveChannelMessage( const xyChannel& rChannel, bool Wait = true );
+
+/**
+ * Hands the space of the message obtained by xyReceiveChannelMessage back to the sender.
+ */
+extern void xyReleaseChannelMessage( const xyChannel& rChannel );
+
+/**
+ * @return Whether the other process is still connected.
+ */
+extern bool xyIsChannelConnected( const xyChannel& rChannel );
+
+/**
+ * Maps the localization catalog that best matches a locale, such as "sv-SE.xyloc" or else "sv.xyloc".
+ * Catalogs are compiled ahead of time with xyCompileLocalizationCatalog, or the xy-catalog tool, and are never parsed at runtime.
+ * When following the system language, the catalog is switched whenever a language change is dispatched from the configuration bus.
+ *
+ * @param Directory The directory that holds the catalogs. On Android, relative paths are looked up in the application's assets.
+ * @param LocaleName The locale to use, or empty to follow the language of the system.
+ * @return Whether a catalog was found.
+ */
+extern bool xyLoadLocalization( std::string_view Directory, std::string_view LocaleName = { } );
+
+/**
+ * Looks up the localized text of a key in the current catalog. Never allocates.
+ * Texts stay valid for the lifetime of the process, even after the catalog has been switched.
+ *
+ * @param Key The key, which is hashed at compile time when given as a string literal.
+ * @return The text, or the name of the key if the catalog has no text for it.
+ */
+extern std::string_view xyLocalize( xyLocalizationKey Key );
+
+/**
+ * Builds a localization catalog, to be written to a file that xyLoadLocalization can map.
+ *
+ * @param Entries The keys and their texts.
+ * @return The contents of the catalog file, or nothing if two keys are duplicates or share a hash.
+ */
+extern std::vector< std::byte > xyCompileLocalizationCatalog( std::span< const xyLocalizationEntry > Entries );
+
+/**
+ * Publishes the registered counters, the state of every thread, the depth of the xy queues and the battery and thermal state into a named shared memory segment.
+ * A background thread refreshes it at the given interval, guarded by a sequence lock, so that tools such as xy-top can inspect the process while it runs.
+ * Nothing in the process waits on the segment, and readers never block the writer.
+ *
+ * Note: Not available on Android, which lacks named shared memory.
+ *
+ * @param Name The name of the segment, or an empty string to use "xy-<process ID>".
+ * @param Interval How often the segment is refreshed.
+ * @return Whether the segment was created.
+ */
+extern bool xyStartTelemetry( std::string_view Name = { }, std::chrono::milliseconds Interval = std::chrono::milliseconds( 500 ) );
+
+/**
+ * Stops publishing and removes the segment.
+ */
+extern void xyStopTelemetry( void );
+
+/**
+ * Adds a counter to the published telemetry. The counter is only read by the publishing thread, so updating it costs no more than updating any other atomic.
+ * Up to 64 counters can be registered.
+ *
+ * @param Name The name that the counter is shown with. Truncated to 31 bytes.
+ * @param rValue The counter, which has to outlive the telemetry.
+ */
+extern void xyRegisterTelemetryCounter( std::string_view Name, const std::atomic< int64_t >& rValue );
+
+/**
+ * Opens the telemetry segment of another process for reading.
+ *
+ * @param Name The name that the process passed to xyStartTelemetry, or its process ID if it used the default name.
+ * @return The view, which evaluates to false if the segment does not exist or is not compatible.
+ */
+extern xyTelemetryView xyOpenTelemetry( std::string_view Name );
+
+/**
+ * Copies the latest published state out of a telemetry segment.
+ *
+ * @param rView The view of the segment.
+ * @param rSnapshot Where the state is copied to.
+ * @return Whether a consistent copy could be made.
+ */
+extern bool xyReadTelemetry( const xyTelemetryView& rView, xyTelemetrySnapshot& rSnapshot );
+
+/**
+ * @return The names of the telemetry segments that currently exist. Only Linux can enumerate them; elsewhere the list is always empty.
+ */
+extern std::vector< std::string > xyListTelemetry( void );
+
+/**
+ * Obtains the UI mode that the app is running in.
+ * Builds that only support one UI mode get it as a constant, without reading the context.
+ *
+ * @return One of the XY_UI_MODE_* flags.
+ */
+inline uint32_t xyGetUIMode( void )
+{
+	if constexpr( xyPlatform::SingleUIMode ) return xyPlatform::SupportedUIModes;
+	else                                     return xyGetContext().UIMode;
+
+} // xyGetUIMode
+
+/**
+ * Checks whether the app is running in a given UI mode.
+ * Compiles to false for UI modes that the build does not support, and to true when it is the only one.
+ *
+ * @return Whether the UI mode is active.
+ */
+template< uint32_t Mode >
+bool xyIsUIMode( void )
+{
+	if constexpr( ( xyPlatform::SupportedUIModes & Mode ) == 0 ) return false;
+	else if constexpr( xyPlatform::SingleUIMode )                 return true;
+	else                                                          return ( xyGetContext().UIMode & Mode ) != 0;
+
+} // xyIsUIMode
+
+/**
+ * Tells the watchdog that the thread is alive. Costs a single relaxed store.
+ *
+ * @param rHeartbeat The heartbeat obtained from xyRegisterWatchdogThread on the calling thread.
+ */
+inline void xyHeartbeat( const xyWatchdogHeartbeat& rHeartbeat )
+{
+	rHeartbeat.pBeat->store( 1, std::memory_order_relaxed );
+
+} // xyHeartbeat
+
+/**
+ * Reserves space for a message in the calling thread's log buffer. Used by xyLog.
+ *
+ * @return Where the arguments are to be written, or nullptr if the message is to be discarded.
+ */
+extern std::byte* xyBeginLogRecord( xyLogLevel Level, const char* pFormat, size_t ArgumentsSize );
+
+/**
+ * Makes the message reserved by xyBeginLogRecord visible to the background thread. Used by xyLog.
+ */
+extern void xyEndLogRecord( void );
+
+/**
+ * Finds the conversion character of each argument in a format string, or zero for arguments the format does not consume. Used by xyLog.
+ */
+extern void xyGetLogConversions( const char* pFormat, std::span< char > Conversions );
+
+template< typename T >
+inline constexpr bool xyIsLogCharacterPointer = std::is_pointer_v< T > && std::is_same_v< std::remove_cv_t< std::remove_pointer_t< T > >, char >;
+
+template< typename T >
+std::string_view xyLogString( const T& rArgument )
+{
+	if constexpr( xyIsLogCharacterPointer< T > ) return rArgument ? std::string_view( rArgument ) : std::string_view( "(null)" );
+	else                                         return std::string_view( rArgument );
+
+} // xyLogString
+
+template< typename T >
+size_t xyLogArgumentSize( const T& rArgument, char Conversion )
+{
+	if constexpr( xyIsLogCharacterPointer< T > )                             return Conversion == 's' ? 1 + sizeof( uint32_t ) + xyLogString( rArgument ).size() : 1 + sizeof( uint64_t );
+	else if constexpr( std::is_convertible_v< const T&, std::string_view > ) return 1 + sizeof( uint32_t ) + std::string_view( rArgument ).size();
+	else                                                                     return 1 + sizeof( uint64_t );
+
+} // xyLogArgumentSize
+
+template< typename T >
+std::byte* xyEncodeLogArgument( std::byte* pOut, const T& rArgument, char Conversion )
+{
+	auto Store = [ & ]( xyLogArgument Type, const auto Value )
+	{
+		*pOut = static_cast< std::byte >( Type );
+		std::memcpy( pOut + 1, &Value, sizeof( Value ) );
+		return pOut + 1 + sizeof( Value );
+	};
+
+	// Character pointers are only read as strings when the format asks for one, so that they can be logged with %p as well
+	if constexpr( xyIsLogCharacterPointer< T > )
+	{
+		if( Conversion != 's' )
+			return Store( xyLogArgument::Pointer, reinterpret_cast< uint64_t >( static_cast< const void* >( rArgument ) ) );
+	}
+
+	if constexpr( std::is_convertible_v< const T&, std::string_view > )
+	{
+		const std::string_view String = xyLogString( rArgument );
+
+		pOut = Store( xyLogArgument::String, static_cast< uint32_t >( String.size() ) );
+		std::memcpy( pOut, String.data(), String.size() );
+
+		return pOut + String.size();
+	}
+	else if constexpr( std::is_enum_v< T > )                                 return xyEncodeLogArgument( pOut, static_cast< std::underlying_type_t< T > >( rArgument ), Conversion );
+	else if constexpr( std::is_floating_point_v< T > )                       return Store( xyLogArgument::Floating, static_cast< double >( rArgument ) );
+	else if constexpr( std::is_pointer_v< T > || std::is_null_pointer_v< T > ) return Store( xyLogArgument::Pointer, reinterpret_cast< uint64_t >( static_cast< const void* >( rArgument ) ) );
+	else if constexpr( std::is_signed_v< T > )                               return Store( xyLogArgument::Signed, static_cast< int64_t >( rArgument ) );
+	else                                                                     return Store( xyLogArgument::Unsigned, static_cast< uint64_t >( rArgument ) );
+
+} // xyEncodeLogArgument
+
+/**
+ * Logs a printf-style message without formatting it on the calling thread.
+ * Only the format string pointer and the raw arguments are copied into a lock-free buffer owned by the calling thread.
+ * Formatting and writing happen later on the background thread started by xyStartLogging.
+ * If the buffer is full, the message is dropped rather than blocking the caller.
+ *
+ * @param Level The severity of the message.
+ * @param pFormat The format string. Must outlive the logger, which string literals do.
+ * @param rArguments Integers, floating point numbers, enums, pointers and strings. Strings are copied, as are character pointers formatted with %s. Null ones are logged as "(null)".
+ */
+template< typename... Arguments >
+void xyLog( xyLogLevel Level, const char* pFormat, const Arguments&... rArguments )
+{
+	// The format only has to be scanned on the calling thread if a character pointer could be either a string or a pointer
+	std::array< char, sizeof...( Arguments ) > Conversions{ };
+	if constexpr( ( xyIsLogCharacterPointer< Arguments > || ... ) )
+		xyGetLogConversions( pFormat, Conversions );
+
+	size_t ArgumentsSize = 0;
+	size_t Index         = 0;
+	( ( ArgumentsSize += xyLogArgumentSize( rArguments, Conversions[ Index++ ] ) ), ... );
+
+	if( std::byte* pOut = xyBeginLogRecord( Level, pFormat, ArgumentsSize ) )
+	{
+		Index = 0;
+		( ( pOut = xyEncodeLogArgument( pOut, rArguments, Conversions[ Index++ ] ) ), ... );
+		xyEndLogRecord();
+	}
+
+} // xyLog
+
+//////////////////////////////////////////////////////////////////////////
+/*
+
+██╗███╗   ███╗██████╗ ██╗     ███████╗███╗   ███╗███████╗███╗   ██╗████████╗ █████╗ ████████╗██╗ ██████╗ ███╗   ██╗
+██║████╗ ████║██╔══██╗██║     ██╔════╝████╗ ████║██╔════╝████╗  ██║╚══██╔══╝██╔══██╗╚══██╔══╝██║██╔═══██╗████╗  ██║
+██║██╔████╔██║██████╔╝██║     █████╗  ██╔████╔██║█████╗  ██╔██╗ ██║   ██║   ███████║   ██║   ██║██║   ██║██╔██╗ ██║
+██║██║╚██╔╝██║██╔═══╝ ██║     ██╔══╝  ██║╚██╔╝██║██╔══╝  ██║╚██╗██║   ██║   ██╔══██║   ██║   ██║██║   ██║██║╚██╗██║
+██║██║ ╚═╝ ██║██║     ███████╗███████╗██║ ╚═╝ ██║███████╗██║ ╚████║   ██║   ██║  ██║   ██║   ██║╚██████╔╝██║ ╚████║
+╚═╝╚═╝     ╚═╝╚═╝     ╚══════╝╚══════╝╚═╝     ╚═╝╚══════╝╚═╝  ╚═══╝   ╚═╝   ╚═╝  ╚═╝   ╚═╝   ╚═╝ ╚═════╝ ╚═╝  ╚═══╝
+*/
+#if defined( XY_IMPLEMENT )
+
+//////////////////////////////////////////////////////////////////////////
+/// Includes
+
+#include "xy-platforms/xy-android.h"
+#include "xy-platforms/xy-desktop.h"
+#include "xy-platforms/xy-ios.h"
+#include "xy-platforms/xy-linux.h"
+#include "xy-platforms/xy-macos.h"
+#include "xy-platforms/xy-tvos.h"
+#include "xy-platforms/xy-watchos.h"
+#include "xy-platforms/xy-windows.h"
+
+#if defined( XY_OS_WINDOWS )
+#include <windows.h>
+#include <lmcons.h>
+#include <powerbase.h>
+#include <psapi.h>
+#include <winioctl.h>
+#include <ws2tcpip.h>
+#include <iphlpapi.h>
+#pragma comment( lib, "Iphlpapi.lib" )
+#pragma comment( lib, "PowrProf.lib" )
+#pragma comment( lib, "Ws2_32.lib" )
+#elif defined( XY_OS_MACOS ) // XY_OS_WINDOWS
+#include <Cocoa/Cocoa.h>
+#include <Foundation/Foundation.h>
+#elif defined( XY_OS_ANDROID ) // XY_OS_MACOS
+#include <android/configuration.h>
+#include <android/native_activity.h>
+#include <uchar.h>
+#include <unistd.h>
+#elif defined( XY_OS_IOS ) // XY_OS_ANDROID
+#include <UIKit/UIKit.h>
+#endif // XY_OS_IOS
+
+#if defined( XY_OS_MACOS ) || defined( XY_OS_IOS ) || defined( XY_OS_TVOS ) || defined( XY_OS_WATCHOS )
+#include <mach/mach.h>
+#include <sys/mount.h>
+#include <sys/sysctl.h>
+#include <sys/time.h>
+#endif // XY_OS_MACOS || XY_OS_IOS || XY_OS_TVOS || XY_OS_WATCHOS
+
+#if !defined( XY_OS_WINDOWS )
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // !XY_OS_WINDOWS
+
+#if defined( XY_OS_ANDROID )
+#include <android/asset_manager.h>
+#include <android/log.h>
+#endif // XY_OS_ANDROID
+
+#if ( defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID ) ) && __has_include( <linux/io_uring.h> )
+#define XY_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+#endif // ( XY_OS_LINUX || XY_OS_ANDROID ) && __has_include( <linux/io_uring.h> )
+
+#if defined( XY_OS_LINUX )
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <sys/socket.h>
+#endif // XY_OS_LINUX
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+#include <dirent.h>
+#include <linux/ethtool.h>
+#include <linux/futex.h>
+#include <linux/sockios.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/statvfs.h>
+#include <sys/un.h>
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cctype>
+#include <clocale>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+#include <csignal>
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unwind.h>
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+#if ( defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID ) ) && !defined( XY_WATCHDOG_SIGNAL )
+#define XY_WATCHDOG_SIGNAL ( SIGRTMIN + 7 )
+#endif // ( XY_OS_LINUX || XY_OS_ANDROID ) && !XY_WATCHDOG_SIGNAL
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Functions
+
+xyContext& xyGetContext( void )
+{
+	static xyContext Context;
+
+	return Context;
+
+} // xyGetContext
+
+
+//////////////////////////////////////////////////////////////////////////
+
+xyArena::xyArena( size_t BlockSize, std::pmr::memory_resource* pUpstream )
+	: pUpstream( pUpstream )
+	, BlockSize( BlockSize )
+{
+} // xyArena
+
+//////////////////////////////////////////////////////////////////////////
+
+xyArena::~xyArena( void )
+{
+	while( pFirstBlock )
+	{
+		Block* pNext = pFirstBlock->pNext;
+		pUpstream->deallocate( pFirstBlock, pFirstBlock->Size, alignof( std::max_align_t ) );
+		pFirstBlock = pNext;
+	}
+
+} // ~xyArena
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyArena::Reset( void )
+{
+	pCurrentBlock             = pFirstBlock;
+	pCursor                   = pFirstBlock ? reinterpret_cast< std::byte* >( pFirstBlock + 1 ) : nullptr;
+	pEnd                      = pFirstBlock ? reinterpret_cast< std::byte* >( pFirstBlock ) + pFirstBlock->Size : nullptr;
+	BytesUsedInPreviousBlocks = 0;
+
+} // Reset
+
+//////////////////////////////////////////////////////////////////////////
+
+size_t xyArena::GetBytesUsed( void ) const
+{
+	if( pCurrentBlock == nullptr )
+		return 0;
+
+	return BytesUsedInPreviousBlocks + static_cast< size_t >( pCursor - reinterpret_cast< std::byte* >( pCurrentBlock + 1 ) );
+
+} // GetBytesUsed
+
+//////////////////////////////////////////////////////////////////////////
+
+size_t xyArena::GetBytesReserved( void ) const
+{
+	size_t Bytes = 0;
+
+	for( Block* pBlock = pFirstBlock; pBlock; pBlock = pBlock->pNext )
+		Bytes += pBlock->Size;
+
+	return Bytes;
+
+} // GetBytesReserved
+
+//////////////////////////////////////////////////////////////////////////
+
+void* xyArena::do_allocate( size_t Bytes, size_t Alignment )
+{
+	for( ;; )
+	{
+		if( pCursor )
+		{
+			void*  pAligned  = pCursor;
+			size_t Remaining = static_cast< size_t >( pEnd - pCursor );
+			if( std::align( Alignment, Bytes, pAligned, Remaining ) )
+			{
+				pCursor = static_cast< std::byte* >( pAligned ) + Bytes;
+				return pAligned;
+			}
+		}
+
+		// Move on to the next block. Blocks that were kept after a reset are reused if they are large enough.
+		const size_t RequiredSize = sizeof( Block ) + Bytes + Alignment;
+		Block*       pNext        = pCurrentBlock ? pCurrentBlock->pNext : pFirstBlock;
+
+		if( pNext == nullptr || pNext->Size < RequiredSize )
+		{
+			const size_t Size   = std::max( BlockSize, RequiredSize );
+			Block*       pBlock = static_cast< Block* >( pUpstream->allocate( Size, alignof( std::max_align_t ) ) );
+			pBlock->pNext       = pNext;
+			pBlock->Size        = Size;
+
+			if( pCurrentBlock ) pCurrentBlock->pNext = pBlock;
+			else                pFirstBlock          = pBlock;
+
+			pNext = pBlock;
+		}
+
+		if( pCurrentBlock )
+			BytesUsedInPreviousBlocks += static_cast< size_t >( pCursor - reinterpret_cast< std::byte* >( pCurrentBlock + 1 ) );
+
+		pCurrentBlock = pNext;
+		pCursor       = reinterpret_cast< std::byte* >( pNext + 1 );
+		pEnd          = reinterpret_cast< std::byte* >( pNext ) + pNext->Size;
+	}
+
+} // do_allocate
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyArena::do_deallocate( void* /*pPointer*/, size_t /*Bytes*/, size_t /*Alignment*/ )
+{
+	// Memory is only reclaimed by Reset
+
+} // do_deallocate
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyArena::do_is_equal( const std::pmr::memory_resource& rOther ) const noexcept
+{
+	return this == &rOther;
+
+} // do_is_equal
+
+//////////////////////////////////////////////////////////////////////////
+
+xyArena& xyGetThreadArena( void )
+{
+	thread_local xyArena Arena;
+
+	return Arena;
+
+} // xyGetThreadArena
+
+//////////////////////////////////////////////////////////////////////////
+
+static xyArena& xyGetScratchArena( void )
+{
+	// Separate from the thread arena so that the non-resource getters never invalidate memory owned by the caller
+	thread_local xyArena Arena( 4 * 1024 );
+
+	return Arena;
+
+} // xyGetScratchArena
+
+//////////////////////////////////////////////////////////////////////////
+
+static void xyInitializeLocale( void )
+{
+	// Only the conversion functions depend on the locale, so it is set on first use rather than delaying startup
+	static std::once_flag Once;
+	std::call_once( Once, []
+	{
+
+	#if defined( XY_OS_WINDOWS )
+		std::setlocale( LC_ALL, "en_US.utf8" );
+	#elif defined( XY_OS_MACOS ) || defined( XY_OS_IOS ) // XY_OS_WINDOWS
+		std::setlocale( LC_CTYPE, "UTF-8" );
+	#endif // XY_OS_MACOS || XY_OS_IOS
+
+	} );
+
+} // xyInitializeLocale
+
+//////////////////////////////////////////////////////////////////////////
+
+std::string xyUTF( std::wstring_view String )
+{
+	xyInitializeLocale();
+
+	std::string    UTFString;
+	size_t         Size;
+	const wchar_t* pSrc = String.data();
+	mbstate_t      State{};
+
+#if defined( XY_OS_WINDOWS )
+	if( wcsrtombs_s( &Size, nullptr, 0, &pSrc, String.size(), &State ) == 0 )
+	{
+		UTFString.resize( Size );
+		wcsrtombs_s( &Size, &UTFString[ 0 ], Size, &pSrc, String.size(), &State );
+	}
+#else // XY_OS_WINDOWS
+	if( ( Size = wcsrtombs( nullptr, &pSrc, String.size(), &State ) ) > 0 )
+	{
+		UTFString.resize( Size );
+		wcsrtombs( &UTFString[ 0 ], &pSrc, String.size(), &State );
+	}
+#endif // !XY_OS_WINDOWS
+
+	return UTFString;
+
+} // xyUTF
+
+//////////////////////////////////////////////////////////////////////////
+
+std::wstring xyUnicode( std::string_view String )
+{
+	xyInitializeLocale();
+
+	std::wstring Result;
+	size_t       Size;
+	const char*  pSrc = String.data();
+	mbstate_t    MultiByteState{ };
+
+#if defined( XY_OS_WINDOWS )
+	if( mbsrtowcs_s( &Size, nullptr, 0, &pSrc, String.size(), &MultiByteState ) == 0 )
+	{
+		Result.resize( Size );
+		mbsrtowcs_s( &Size, &Result[ 0 ], Size, &pSrc, String.size(), &MultiByteState );
+	}
+#else // XY_OS_WINDOWS
+	if( ( Size = mbsrtowcs( nullptr, &pSrc, String.size(), &MultiByteState ) ) > 0 )
+	{
+		Result.resize( Size );
+		mbsrtowcs( &Result[ 0 ], &pSrc, String.size(), &MultiByteState );
+	}
+#endif // !XY_OS_WINDOWS
+
+	return Result;
+
+} // xyUnicode
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyMessageOption
+{
+	std::string_view Label;
+	xyMessageResult  Result;
+
+}; // xyMessageOption
+
+//////////////////////////////////////////////////////////////////////////
+
+static std::span< const xyMessageOption > xyGetMessageOptions( xyMessageButtons Buttons )
+{
+	static constexpr xyMessageOption Ok[]                     = { { "OK", xyMessageResult::Ok } };
+	static constexpr xyMessageOption OkCancel[]               = { { "OK", xyMessageResult::Ok }, { "Cancel", xyMessageResult::Cancel } };
+	static constexpr xyMessageOption YesNo[]                  = { { "Yes", xyMessageResult::Yes }, { "No", xyMessageResult::No } };
+	static constexpr xyMessageOption YesNoCancel[]            = { { "Yes", xyMessageResult::Yes }, { "No", xyMessageResult::No }, { "Cancel", xyMessageResult::Cancel } };
+	static constexpr xyMessageOption AbortRetryIgnore[]       = { { "Abort", xyMessageResult::Abort }, { "Retry", xyMessageResult::Retry }, { "Ignore", xyMessageResult::Ignore } };
+	static constexpr xyMessageOption CancelTryagainContinue[] = { { "Cancel", xyMessageResult::Cancel }, { "Try Again", xyMessageResult::Tryagain }, { "Continue", xyMessageResult::Continue } };
+	static constexpr xyMessageOption RetryCancel[]            = { { "Retry", xyMessageResult::Retry }, { "Cancel", xyMessageResult::Cancel } };
+
+	switch( Buttons )
+	{
+		default:
+		case xyMessageButtons::Ok:                     return Ok;
+		case xyMessageButtons::OkCancel:               return OkCancel;
+		case xyMessageButtons::YesNo:                  return YesNo;
+		case xyMessageButtons::YesNoCancel:            return YesNoCancel;
+		case xyMessageButtons::AbortRetryIgnore:       return AbortRetryIgnore;
+		case xyMessageButtons::CancelTryagainContinue: return CancelTryagainContinue;
+		case xyMessageButtons::RetryCancel:            return RetryCancel;
+	}
+
+} // xyGetMessageOptions
+
+//////////////////////////////////////////////////////////////////////////
+
+static std::atomic< int > xyDefaultMessageResult = -1;
+
+// The terminal is shared by all threads, so prompts are shown one at a time.
+// Constant-initialized at namespace scope, so that it outlives the message box queue in the context.
+static std::mutex         xyMessagePromptMutex;
+
+//////////////////////////////////////////////////////////////////////////
+
+#if defined( XY_OS_LINUX )
+
+// Signaled once the message box queue is destroyed, so that a terminal prompt that is still waiting for input gives up. It stays signaled.
+static int xyGetMessagePromptStopEvent( void )
+{
+	static const int StopEvent = eventfd( 0, EFD_CLOEXEC );
+	return StopEvent;
+
+} // xyGetMessagePromptStopEvent
+
+#endif // XY_OS_LINUX
+
+//////////////////////////////////////////////////////////////////////////
+
+static const xyMessageOption& xyGetDefaultMessageOption( xyMessageButtons Buttons )
+{
+	const std::span< const xyMessageOption > Options = xyGetMessageOptions( Buttons );
+	const int                                Default = xyDefaultMessageResult.load( std::memory_order_relaxed );
+
+	for( const xyMessageOption& rOption : Options )
+	{
+		if( static_cast< int >( rOption.Result ) == Default )
+			return rOption;
+	}
+
+	return Options.front();
+
+} // xyGetDefaultMessageOption
+
+//////////////////////////////////////////////////////////////////////////
+
+#if defined( XY_OS_ANDROID )
+
+JNIEnv* xyGetJNIEnv( void )
+{
+	struct Attachment
+	{
+		~Attachment( void ) { if( Attached ) pVM->DetachCurrentThread(); }
+
+		JavaVM* pVM      = nullptr;
+		JNIEnv* pJNI     = nullptr;
+		bool    Attached = false;
+
+	}; // Attachment
+
+	static thread_local Attachment ThisThread;
+
+	if( ThisThread.pJNI == nullptr )
+	{
+		ThisThread.pVM = xyGetContext().pPlatformImpl->pNativeActivity->vm;
+
+		// Threads that were started by Java are already attached, and must not be detached by us
+		if( ThisThread.pVM->GetEnv( reinterpret_cast< void** >( &ThisThread.pJNI ), JNI_VERSION_1_6 ) == JNI_EDETACHED )
+		{
+			ThisThread.pVM->AttachCurrentThread( &ThisThread.pJNI, nullptr );
+			ThisThread.Attached = true;
+		}
+	}
+
+	return ThisThread.pJNI;
+
+} // xyGetJNIEnv
+
+//////////////////////////////////////////////////////////////////////////
+
+const xyJNICache& xyGetJNICache( void )
+{
+	xyPlatformImpl& rPlatformImpl = *xyGetContext().pPlatformImpl;
+
+	std::call_once( rPlatformImpl.JNICacheFlag, [ &rPlatformImpl ]
+	{
+		xyLoadJNICache( xyGetJNIEnv(), rPlatformImpl.pNativeActivity->clazz, rPlatformImpl.JNICache );
+	} );
+
+	return rPlatformImpl.JNICache;
+
+} // xyGetJNICache
+
+#endif // XY_OS_ANDROID
+
+//////////////////////////////////////////////////////////////////////////
+
+xyMessageResult xyMessageBox( std::string_view Title, std::string_view Message, xyMessageButtons Buttons )
+{
+
+#if defined( XY_OS_WINDOWS )
+
+	const UINT MessageType = [ Buttons ]
+	{
+		switch( Buttons )
+		{
+			default:
+			case xyMessageButtons::Ok:                     return MB_OK;
+			case xyMessageButtons::OkCancel:               return MB_OKCANCEL;
+			case xyMessageButtons::YesNo:                  return MB_YESNO;
+			case xyMessageButtons::YesNoCancel:            return MB_YESNOCANCEL;
+			case xyMessageButtons::AbortRetryIgnore:       return MB_ABORTRETRYIGNORE;
+			case xyMessageButtons::CancelTryagainContinue: return MB_CANCELTRYCONTINUE;
+			case xyMessageButtons::RetryCancel:            return MB_RETRYCANCEL;
+		}
+	}();
+
+	// The ANSI version of MessageBox doesn't support UTF-8 strings so we convert it into Unicode and use the Unicode version instead
+	const std::wstring UnicodeTitle   = xyUnicode( Title );
+	const std::wstring UnicodeMessage = xyUnicode( Message );
+
+	int Result;
+	if( !UnicodeMessage.empty() ) Result = MessageBoxW( NULL, UnicodeMessage.data(), UnicodeTitle.data(), MessageType | MB_ICONINFORMATION | MB_TASKMODAL );
+	else                          Result = MessageBoxA( NULL, Message       .data(), Title       .data(), MessageType | MB_ICONINFORMATION | MB_TASKMODAL );
+
+	switch( Result )
+	{
+		default:
+		case IDOK:       return xyMessageResult::Ok;
+		case IDCANCEL:   return xyMessageResult::Cancel;
+		case IDABORT:    return xyMessageResult::Abort;
+		case IDRETRY:    return xyMessageResult::Retry;
+		case IDIGNORE:   return xyMessageResult::Ignore;
+		case IDYES:      return xyMessageResult::Yes;
+		case IDNO:       return xyMessageResult::No;
+		case IDTRYAGAIN: return xyMessageResult::Tryagain;
+		case IDCONTINUE: return xyMessageResult::Continue;
+	}
+
+#elif defined( XY_OS_MACOS ) // XY_OS_WINDOWS
 
 	NSAlert*  pAlert           = [ [ NSAlert alloc ] init ];
 	NSString* pMessageText     = [ NSString stringWithUTF8String:Title.data() ];
 	NSString* pInformativeText = [ NSString stringWithUTF8String:Message.data() ];
 
-	[ pAlert setMessageText:pMessageText ];
-	[ pAlert setInformativeText:pInformativeText ];
-	[ pAlert setAlertStyle:NSAlertStyleInformational ];
+	[ pAlert setMessageText:pMessageText ];
+	[ pAlert setInformativeText:pInformativeText ];
+	[ pAlert setAlertStyle:NSAlertStyleInformational ];
+
+	// Note: Trailing space in "Cancel " is intended
+	// NSAlert has special layouts for common titles (such as "Cancel") that we would like to avoid
+	switch( Buttons )
+	{
+		case xyMessageButtons::Ok:
+			[ pAlert addButtonWithTitle:@"OK" ].tag = ( NSInteger )xyMessageResult::Ok;
+		break;
+
+		case xyMessageButtons::OkCancel:
+			[ pAlert addButtonWithTitle:@"OK"     ].tag = ( NSInteger )xyMessageResult::Ok;
+			[ pAlert addButtonWithTitle:@"Cancel" ].tag = ( NSInteger )xyMessageResult::Cancel;
+		break;
+
+		case xyMessageButtons::YesNo:
+			[ pAlert addButtonWithTitle:@"Yes" ].tag = ( NSInteger )xyMessageResult::Yes;
+			[ pAlert addButtonWithTitle:@"No"  ].tag = ( NSInteger )xyMessageResult::No;
+		break;
+
+		case xyMessageButtons::YesNoCancel:
+			[ pAlert addButtonWithTitle:@"Yes"     ].tag = ( NSInteger )xyMessageResult::Yes;
+			[ pAlert addButtonWithTitle:@"No"      ].tag = ( NSInteger )xyMessageResult::No;
+			[ pAlert addButtonWithTitle:@"Cancel " ].tag = ( NSInteger )xyMessageResult::Cancel;
+		break;
+
+		case xyMessageButtons::AbortRetryIgnore:
+			[ pAlert addButtonWithTitle:@"Abort"  ].tag = ( NSInteger )xyMessageResult::Abort;
+			[ pAlert addButtonWithTitle:@"Retry"  ].tag = ( NSInteger )xyMessageResult::Retry;
+			[ pAlert addButtonWithTitle:@"Ignore" ].tag = ( NSInteger )xyMessageResult::Ignore;
+		break;
+
+		case xyMessageButtons::CancelTryagainContinue:
+			[ pAlert addButtonWithTitle:@"Cancel "   ].tag = ( NSInteger )xyMessageResult::Cancel;
+			[ pAlert addButtonWithTitle:@"Try Again" ].tag = ( NSInteger )xyMessageResult::Tryagain;
+			[ pAlert addButtonWithTitle:@"Continue"  ].tag = ( NSInteger )xyMessageResult::Continue;
+		break;
+
+		case xyMessageButtons::RetryCancel:
+			[ pAlert addButtonWithTitle:@"Retry"   ].tag = ( NSInteger )xyMessageResult::Retry;
+			[ pAlert addButtonWithTitle:@"Cancel " ].tag = ( NSInteger )xyMessageResult::Cancel;
+		break;
+	}
+
+	xyMessageResult Result = ( xyMessageResult )[ pAlert runModal ];
+
+	[ pInformativeText release ];
+	[ pMessageText release ];
+	[ pAlert release ];
+
+	return Result;
+
+#elif defined( XY_OS_ANDROID ) // XY_OS_MACOS
+
+	const auto [ Spinner, Dismissed ] = xyRunOnJavaThread( []( std::string Title, std::string Message, int Buttons )
+	{
+		xyContext& rContext = xyGetContext();
+		JNIEnv*    pJNI     = rContext.pPlatformImpl->pNativeActivity->env;
+
+		// Easy way to tidy up all our local references when we're done
+		pJNI->PushLocalFrame( 32 );
+
+		// Obtain all necessary classes and method IDs
+		jclass    ClassBuilder            = pJNI->FindClass( "android/app/AlertDialog$Builder" );
+		jmethodID CtorBuilder             = pJNI->GetMethodID( ClassBuilder, "<init>", "(Landroid/content/Context;)V" );
+		jmethodID MethodSetTitle          = pJNI->GetMethodID( ClassBuilder, "setTitle", "(Ljava/lang/CharSequence;)Landroid/app/AlertDialog$Builder;" );
+		jmethodID MethodSetMessage        = pJNI->GetMethodID( ClassBuilder, "setMessage", "(Ljava/lang/CharSequence;)Landroid/app/AlertDialog$Builder;" );
+		jmethodID MethodSetNeutralButton  = pJNI->GetMethodID( ClassBuilder, "setNeutralButton", "(Ljava/lang/CharSequence;Landroid/content/DialogInterface$OnClickListener;)Landroid/app/AlertDialog$Builder;" );
+		jmethodID MethodSetNegativeButton = pJNI->GetMethodID( ClassBuilder, "setNegativeButton", "(Ljava/lang/CharSequence;Landroid/content/DialogInterface$OnClickListener;)Landroid/app/AlertDialog$Builder;" );
+		jmethodID MethodSetPositiveButton = pJNI->GetMethodID( ClassBuilder, "setPositiveButton", "(Ljava/lang/CharSequence;Landroid/content/DialogInterface$OnClickListener;)Landroid/app/AlertDialog$Builder;" );
+		jmethodID MethodSetCancelable     = pJNI->GetMethodID( ClassBuilder, "setCancelable", "(Z)Landroid/app/AlertDialog$Builder;" );
+		jmethodID MethodShow              = pJNI->GetMethodID( ClassBuilder, "show", "()Landroid/app/AlertDialog;" );
+		jmethodID MethodSetDismissMessage = pJNI->GetMethodID( pJNI->FindClass( "android/app/Dialog" ), "setDismissMessage", "(Landroid/os/Message;)V" );
+
+		// Create a dummy spinner that will keep track of which button was clicked.
+		// This is done because we need a built-in class that implements DialogInterface.OnClickListener and has an easy way to query which button was clicked
+		jclass    ClassSpinner           = pJNI->FindClass( "android/widget/Spinner" );
+		jmethodID CtorSpinner            = pJNI->GetMethodID( ClassSpinner, "<init>", "(Landroid/content/Context;)V" );
+		jmethodID MethodSetSelection     = pJNI->GetMethodID( ClassSpinner, "setSelection", "(I)V" );
+		jobject   Spinner                = pJNI->NewObject( ClassSpinner, CtorSpinner, rContext.pPlatformImpl->pNativeActivity->clazz );
+		Spinner                          = pJNI->NewGlobalRef( Spinner );
+		pJNI->CallVoidMethod( Spinner, MethodSetSelection, 0 );
+
+		// Create the alert dialog
+		jobject Builder = pJNI->NewObject( ClassBuilder, CtorBuilder, rContext.pPlatformImpl->pNativeActivity->clazz );
+		pJNI->CallObjectMethod( Builder, MethodSetTitle, pJNI->NewStringUTF( Title.data() ) );
+		pJNI->CallObjectMethod( Builder, MethodSetMessage, pJNI->NewStringUTF( Message.data() ) );
+		pJNI->CallObjectMethod( Builder, MethodSetCancelable, false );
+
+		switch( ( xyMessageButtons )Buttons )
+		{
+			case xyMessageButtons::Ok:
+				pJNI->CallObjectMethod( Builder, MethodSetPositiveButton, pJNI->NewStringUTF( "OK" ), Spinner );
+			break;
+
+			case xyMessageButtons::OkCancel:
+				pJNI->CallObjectMethod( Builder, MethodSetNeutralButton,  pJNI->NewStringUTF( "OK" ),     Spinner );
+				pJNI->CallObjectMethod( Builder, MethodSetPositiveButton, pJNI->NewStringUTF( "Cancel" ), Spinner );
+			break;
+
+			case xyMessageButtons::YesNo:
+				pJNI->CallObjectMethod( Builder, MethodSetNeutralButton,  pJNI->NewStringUTF( "Yes" ),  Spinner );
+				pJNI->CallObjectMethod( Builder, MethodSetPositiveButton, pJNI->NewStringUTF( "No" ),   Spinner );
+			break;
+
+			case xyMessageButtons::YesNoCancel:
+				pJNI->CallObjectMethod( Builder, MethodSetNeutralButton,  pJNI->NewStringUTF( "Yes" ),    Spinner );
+				pJNI->CallObjectMethod( Builder, MethodSetNegativeButton, pJNI->NewStringUTF( "No" ),     Spinner );
+				pJNI->CallObjectMethod( Builder, MethodSetPositiveButton, pJNI->NewStringUTF( "Cancel" ), Spinner );
+			break;
+
+			case xyMessageButtons::AbortRetryIgnore:
+				pJNI->CallObjectMethod( Builder, MethodSetNeutralButton,  pJNI->NewStringUTF( "Abort" ),  Spinner );
+				pJNI->CallObjectMethod( Builder, MethodSetNegativeButton, pJNI->NewStringUTF( "Retry" ),  Spinner );
+				pJNI->CallObjectMethod( Builder, MethodSetPositiveButton, pJNI->NewStringUTF( "Ignore" ), Spinner );
+			break;
+
+			case xyMessageButtons::CancelTryagainContinue:
+				pJNI->CallObjectMethod( Builder, MethodSetNeutralButton,  pJNI->NewStringUTF( "Cancel" ),    Spinner );
+				pJNI->CallObjectMethod( Builder, MethodSetNegativeButton, pJNI->NewStringUTF( "Try Again" ), Spinner );
+				pJNI->CallObjectMethod( Builder, MethodSetPositiveButton, pJNI->NewStringUTF( "Continue" ),  Spinner );
+			break;
+
+			case xyMessageButtons::RetryCancel:
+				pJNI->CallObjectMethod( Builder, MethodSetNeutralButton,  pJNI->NewStringUTF( "Retry" ),  Spinner );
+				pJNI->CallObjectMethod( Builder, MethodSetPositiveButton, pJNI->NewStringUTF( "Cancel" ), Spinner );
+			break;
+		}
+
+		// Create a task that the waiting thread can block on until the alert is dismissed.
+		// A thread that is never started does nothing when run, which makes it a built-in no-op runnable for the task to wrap.
+		jclass    ClassThread         = pJNI->FindClass( "java/lang/Thread" );
+		jclass    ClassFutureTask     = pJNI->FindClass( "java/util/concurrent/FutureTask" );
+		jclass    ClassLooper         = pJNI->FindClass( "android/os/Looper" );
+		jclass    ClassHandler        = pJNI->FindClass( "android/os/Handler" );
+		jclass    ClassMessage        = pJNI->FindClass( "android/os/Message" );
+		jobject   NoOperation         = pJNI->NewObject( ClassThread, pJNI->GetMethodID( ClassThread, "<init>", "()V" ) );
+		jobject   Dismissed           = pJNI->NewObject( ClassFutureTask, pJNI->GetMethodID( ClassFutureTask, "<init>", "(Ljava/lang/Runnable;Ljava/lang/Object;)V" ), NoOperation, nullptr );
+		jobject   MainLooper          = pJNI->CallStaticObjectMethod( ClassLooper, pJNI->GetStaticMethodID( ClassLooper, "getMainLooper", "()Landroid/os/Looper;" ) );
+		jobject   Handler             = pJNI->NewObject( ClassHandler, pJNI->GetMethodID( ClassHandler, "<init>", "(Landroid/os/Looper;)V" ), MainLooper );
+		jobject   DismissMessage      = pJNI->CallStaticObjectMethod( ClassMessage, pJNI->GetStaticMethodID( ClassMessage, "obtain", "(Landroid/os/Handler;Ljava/lang/Runnable;)Landroid/os/Message;" ), Handler, Dismissed );
+		Dismissed                     = pJNI->NewGlobalRef( Dismissed );
+
+		// Show the alert. The dismiss message is posted after the click listener has recorded the selection.
+		jobject Dialog = pJNI->CallObjectMethod( Builder, MethodShow );
+		pJNI->CallVoidMethod( Dialog, MethodSetDismissMessage, DismissMessage );
+
+		pJNI->PopLocalFrame( nullptr );
+
+		return std::pair( Spinner, Dismissed );
+
+	}, std::string( Title ), std::string( Message ), ( int )Buttons );
+
+	JNIEnv*           pJNI   = xyGetJNIEnv();
+	const xyJNICache& rCache = xyGetJNICache();
+
+	// Block until the alert is dismissed
+	pJNI->CallObjectMethod( Dismissed, rCache.FutureTaskGet );
+
+	const int Result = pJNI->CallIntMethod( Spinner, rCache.SpinnerGetSelectedItemPosition );
+
+	pJNI->DeleteGlobalRef( Dismissed );
+	pJNI->DeleteGlobalRef( Spinner );
+
+	std::array< xyMessageResult, 3 > ResultTable;
+	switch( Buttons )
+	{
+		default:
+		case xyMessageButtons::Ok:                     ResultTable = { xyMessageResult::Ok,       { },                       { }                     }; break;
+		case xyMessageButtons::OkCancel:               ResultTable = { xyMessageResult::Cancel,   { },                       xyMessageResult::Ok     }; break;
+		case xyMessageButtons::YesNo:                  ResultTable = { xyMessageResult::No,       { },                       xyMessageResult::Yes    }; break;
+		case xyMessageButtons::YesNoCancel:            ResultTable = { xyMessageResult::Cancel,   xyMessageResult::No,       xyMessageResult::Yes    }; break;
+		case xyMessageButtons::AbortRetryIgnore:       ResultTable = { xyMessageResult::Ignore,   xyMessageResult::Retry,    xyMessageResult::Abort  }; break;
+		case xyMessageButtons::CancelTryagainContinue: ResultTable = { xyMessageResult::Continue, xyMessageResult::Tryagain, xyMessageResult::Cancel }; break;
+		case xyMessageButtons::RetryCancel:            ResultTable = { xyMessageResult::Cancel,   { },                       xyMessageResult::Retry  }; break;
+	}
+
+	// Results ranges from -1 to -3
+	return ResultTable[ -( Result + 1 ) ];
+
+#elif defined( XY_OS_IOS ) // XY_OS_ANDROID
+
+	__block int Result = -1;
+
+	dispatch_async_and_wait( dispatch_get_main_queue(), ^
+	{
+		UIApplication*     pApplication     = [ UIApplication sharedApplication ];
+		UIScene*           pScene           = [ [ [ pApplication connectedScenes ] allObjects ] firstObject ];
+		UIViewController*  pViewController  = [ [ [ ( UIWindowScene* )pScene windows ] firstObject ] rootViewController ];
+		NSString*          pTitle           = [ NSString stringWithUTF8String:Title.data() ];
+		NSString*          pMessage         = [ NSString stringWithUTF8String:Message.data() ];
+		UIAlertController* pAlertController = [ UIAlertController alertControllerWithTitle:pTitle message:pMessage preferredStyle:UIAlertControllerStyleAlert ];
+
+		switch( Buttons )
+		{
+			case xyMessageButtons::Ok:
+				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"OK" style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Ok; } ] ];
+			break;
+
+			case xyMessageButtons::OkCancel:
+				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"OK"     style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Ok;     } ] ];
+				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Cancel" style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Cancel; } ] ];
+			break;
+
+			case xyMessageButtons::YesNo:
+				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Yes" style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Yes; } ] ];
+				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"No"  style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::No;  } ] ];
+			break;
+
+			case xyMessageButtons::YesNoCancel:
+				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Yes"    style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Yes;    } ] ];
+				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"No"     style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::No;     } ] ];
+				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Cancel" style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Cancel; } ] ];
+			break;
+
+			case xyMessageButtons::AbortRetryIgnore:
+				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Abort"  style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Abort;  } ] ];
+				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Retry"  style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Retry;  } ] ];
+				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Ignore" style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Ignore; } ] ];
+			break;
+
+			case xyMessageButtons::CancelTryagainContinue:
+				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Cancel"    style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Cancel;   } ] ];
+				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Try Again" style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Tryagain; } ] ];
+				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Continue"  style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Continue; } ] ];
+			break;
+
+			case xyMessageButtons::RetryCancel:
+				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Retry"  style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Retry;  } ] ];
+				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Cancel" style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Cancel; } ] ];
+			break;
+		}
+
+		[ pViewController presentViewController:pAlertController animated:NO completion:^{ } ];
+	} );
+
+	// Sleep until selection has been made
+	while( Result < 0 )
+		std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+	
+	return ( xyMessageResult )Result;
+
+#elif defined( XY_OS_LINUX ) // XY_OS_IOS
+
+	std::lock_guard Lock( xyMessagePromptMutex );
+
+	const std::span< const xyMessageOption > Options = xyGetMessageOptions( Buttons );
+	const xyMessageOption&                   rDefault = xyGetDefaultMessageOption( Buttons );
+
+	std::fprintf( stderr, "\n%.*s\n%.*s\n", static_cast< int >( Title.size() ), Title.data(), static_cast< int >( Message.size() ), Message.data() );
+
+	// Nobody is there to answer, so don't wait for one
+	if( !isatty( STDIN_FILENO ) )
+	{
+		std::fprintf( stderr, "> %.*s (no terminal)\n", static_cast< int >( rDefault.Label.size() ), rDefault.Label.data() );
+		return rDefault.Result;
+	}
+
+	for( ;; )
+	{
+		for( size_t i = 0; i < Options.size(); ++i )
+			std::fprintf( stderr, "[%zu] %.*s  ", i + 1, static_cast< int >( Options[ i ].Label.size() ), Options[ i ].Label.data() );
+
+		std::fprintf( stderr, "(default: %.*s) > ", static_cast< int >( rDefault.Label.size() ), rDefault.Label.data() );
+		std::fflush( stderr );
+
+		// Read the line a byte at a time, so that the wait can be cut short when the program exits with the prompt still open
+		char   Line[ 64 ];
+		size_t Length = 0;
+
+		for( char Character = '\0'; Character != '\n'; )
+		{
+			pollfd PollFiles[ 2 ] = { { .fd=STDIN_FILENO, .events=POLLIN, .revents=0 }, { .fd=xyGetMessagePromptStopEvent(), .events=POLLIN, .revents=0 } };
+			if( poll( PollFiles, 2, -1 ) < 0 )
+			{
+				if( errno == EINTR )
+					continue;
+
+				return rDefault.Result;
+			}
+
+			if( PollFiles[ 1 ].revents & POLLIN )
+			{
+				std::fprintf( stderr, "%.*s (cancelled)\n", static_cast< int >( rDefault.Label.size() ), rDefault.Label.data() );
+				return rDefault.Result;
+			}
+
+			if( read( STDIN_FILENO, &Character, 1 ) != 1 )
+				return rDefault.Result;
+
+			// The rest of a line that is too long is dropped
+			if( Character != '\n' && Length < sizeof( Line ) )
+				Line[ Length++ ] = Character;
+		}
+
+		std::string_view Answer( Line, Length );
+		while( !Answer.empty() && std::isspace( static_cast< unsigned char >( Answer.back() ) ) )  Answer.remove_suffix( 1 );
+		while( !Answer.empty() && std::isspace( static_cast< unsigned char >( Answer.front() ) ) ) Answer.remove_prefix( 1 );
+
+		if( Answer.empty() )
+			return rDefault.Result;
+
+		// Accept either the number of an option or its label
+		for( size_t i = 0; i < Options.size(); ++i )
+		{
+			const std::string_view Label = Options[ i ].Label;
+
+			if( Answer == std::to_string( i + 1 ) || ( Answer.size() == Label.size() && std::equal( Answer.begin(), Answer.end(), Label.begin(), []( char a, char b ) { return std::tolower( static_cast< unsigned char >( a ) ) == std::tolower( static_cast< unsigned char >( b ) ); } ) ) )
+				return Options[ i ].Result;
+		}
+	}
+
+#endif // XY_OS_LINUX
+
+} // xyMessageBox
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyMessageBox( std::string_view Title, std::string_view Message )
+{
+	( void )xyMessageBox( Title, Message, xyMessageButtons::Ok );
+
+} // xyMessageBox
+
+//////////////////////////////////////////////////////////////////////////
+
+std::future< xyMessageResult > xyMessageBoxAsync( std::string_view Title, std::string_view Message, xyMessageButtons Buttons )
+{
+	auto                           pPromise = std::make_unique< std::promise< xyMessageResult > >();
+	std::future< xyMessageResult > Future   = pPromise->get_future();
+
+	xyMessageBoxAsync( Title, Message, Buttons, []( xyMessageResult Result, void* pUserData )
+	{
+		std::unique_ptr< std::promise< xyMessageResult > > pPromise( static_cast< std::promise< xyMessageResult >* >( pUserData ) );
+		pPromise->set_value( Result );
+
+	}, pPromise.release() );
+
+	return Future;
+
+} // xyMessageBoxAsync
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyMessageBoxQueue
+{
+	struct Request
+	{
+		std::string       Title;
+		std::string       Message;
+		xyMessageButtons  Buttons;
+		xyMessageCallback Callback;
+		void*             pUserData;
+
+	}; // Request
+
+	~xyMessageBoxQueue( void );
+
+	void Run( void );
+
+	std::mutex              Mutex;
+	std::condition_variable RequestAvailable;
+	std::deque< Request >   Requests;
+	std::thread             Thread;
+	bool                    Stopping = false;
+
+}; // xyMessageBoxQueue
+
+//////////////////////////////////////////////////////////////////////////
+
+xyMessageBoxQueue::~xyMessageBoxQueue( void )
+{
+	{
+		std::lock_guard Lock( Mutex );
+		Stopping = true;
+	}
+
+	RequestAvailable.notify_one();
+
+#if defined( XY_OS_LINUX )
+	// A terminal prompt that is currently open is given the default answer rather than waiting for input
+	eventfd_write( xyGetMessagePromptStopEvent(), 1 );
+#endif // XY_OS_LINUX
+
+	// Waits for the prompt that is currently open, if any
+	if( Thread.joinable() )
+		Thread.join();
+
+} // ~xyMessageBoxQueue
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyMessageBoxQueue::Run( void )
+{
+	std::unique_lock Lock( Mutex );
+
+	for( ;; )
+	{
+		RequestAvailable.wait( Lock, [ this ] { return Stopping || !Requests.empty(); } );
+
+		if( Requests.empty() )
+			break;
+
+		Request    Next = std::move( Requests.front() );
+		const bool Show = !Stopping;
+		Requests.pop_front();
+
+		Lock.unlock();
+
+		// Prompts that are still queued when the context is destroyed are given the default answer without being shown
+		const xyMessageResult Result = Show ? xyMessageBox( Next.Title, Next.Message, Next.Buttons ) : xyGetDefaultMessageOption( Next.Buttons ).Result;
+		if( Next.Callback )
+			Next.Callback( Result, Next.pUserData );
+
+		Lock.lock();
+	}
+
+} // Run
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyMessageBoxAsync( std::string_view Title, std::string_view Message, xyMessageButtons Buttons, xyMessageCallback Callback, void* pUserData )
+{
+
+#if defined( XY_OS_MACOS )
+
+	// AppKit may only be used from the main thread, so the alert is queued there instead of on a thread of its own
+	__block std::string TitleCopy( Title );
+	__block std::string MessageCopy( Message );
+
+	dispatch_async( dispatch_get_main_queue(), ^
+	{
+		const xyMessageResult Result = xyMessageBox( TitleCopy, MessageCopy, Buttons );
+		if( Callback )
+			Callback( Result, pUserData );
+	} );
+
+#else // XY_OS_MACOS
+
+	// The prompts are served by a single worker thread that is owned by the context, so that it is joined before the program exits
+	static std::once_flag QueueFlag;
+	xyContext&            rContext = xyGetContext();
+
+	std::call_once( QueueFlag, [ &rContext ]
+	{
+		rContext.pMessageBoxQueue         = std::make_unique< xyMessageBoxQueue >();
+		rContext.pMessageBoxQueue->Thread = std::thread( &xyMessageBoxQueue::Run, rContext.pMessageBoxQueue.get() );
+	} );
+
+	xyMessageBoxQueue& rQueue = *rContext.pMessageBoxQueue;
+	{
+		std::lock_guard Lock( rQueue.Mutex );
+		rQueue.Requests.push_back( { .Title=std::string( Title ), .Message=std::string( Message ), .Buttons=Buttons, .Callback=Callback, .pUserData=pUserData } );
+	}
+
+	rQueue.RequestAvailable.notify_one();
+
+#endif // !XY_OS_MACOS
+
+} // xyMessageBoxAsync
+
+//////////////////////////////////////////////////////////////////////////
+
+void xySetDefaultMessageResult( std::optional< xyMessageResult > Result )
+{
+	xyDefaultMessageResult.store( Result ? static_cast< int >( *Result ) : -1, std::memory_order_relaxed );
+
+} // xySetDefaultMessageResult
+
+//////////////////////////////////////////////////////////////////////////
+
+static std::atomic< xyBackend* > xyActiveBackend = nullptr;
+
+//////////////////////////////////////////////////////////////////////////
+
+void xySetBackend( xyBackend* pBackend )
+{
+	xyActiveBackend.store( pBackend, std::memory_order_release );
+
+} // xySetBackend
+
+//////////////////////////////////////////////////////////////////////////
+
+xyBackend* xyGetBackend( void )
+{
+	return xyActiveBackend.load( std::memory_order_acquire );
+
+} // xyGetBackend
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xySimulatedBackendImpl
+{
+	std::chrono::milliseconds Now  ( void ) const;
+	void                      Delay( void );
+
+	static std::optional< float > Sample( std::span< const xySimulatedSample > Curve, std::chrono::milliseconds Time, bool Loop, bool* pRising );
+
+	mutable std::mutex                    Mutex;
+	xySimulatedPlatform                   Platform;
+	std::chrono::steady_clock::time_point Start   = std::chrono::steady_clock::now();
+	std::chrono::milliseconds             Elapsed = std::chrono::milliseconds( 0 ); // Until Start
+	std::atomic< uint64_t >               Calls   = 0;
+
+}; // xySimulatedBackendImpl
+
+//////////////////////////////////////////////////////////////////////////
+
+std::chrono::milliseconds xySimulatedBackendImpl::Now( void ) const
+{
+	if( !Platform.RealTime )
+		return Elapsed;
+
+	return Elapsed + std::chrono::duration_cast< std::chrono::milliseconds >( std::chrono::steady_clock::now() - Start );
+
+} // Now
+
+//////////////////////////////////////////////////////////////////////////
+
+void xySimulatedBackendImpl::Delay( void )
+{
+	const uint64_t            Call = Calls.fetch_add( 1, std::memory_order_relaxed );
+	std::chrono::microseconds Latency;
+
+	{
+		std::lock_guard Lock( Mutex );
+		Latency = Platform.Latency;
+
+		if( const int64_t Jitter = Platform.LatencyJitter.count(); Jitter > 0 )
+		{
+			// SplitMix64 of the call index, so that the same sequence of calls always sees the same delays
+			uint64_t Random = Platform.Seed + ( Call + 1 ) * 0x9E3779B97F4A7C15ull;
+			Random          = ( Random ^ ( Random >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+			Random          = ( Random ^ ( Random >> 27 ) ) * 0x94D049BB133111EBull;
+			Random          =   Random ^ ( Random >> 31 );
+			Latency        += std::chrono::microseconds( Random % static_cast< uint64_t >( Jitter + 1 ) );
+		}
+	}
+
+	if( Latency.count() > 0 )
+		std::this_thread::sleep_for( Latency );
+
+} // Delay
+
+//////////////////////////////////////////////////////////////////////////
+
+std::optional< float > xySimulatedBackendImpl::Sample( std::span< const xySimulatedSample > Curve, std::chrono::milliseconds Time, bool Loop, bool* pRising )
+{
+	if( Curve.empty() )
+		return std::nullopt;
+
+	if( Loop && Curve.back().Time.count() > 0 )
+		Time %= Curve.back().Time;
+
+	auto Next = std::upper_bound( Curve.begin(), Curve.end(), Time, []( std::chrono::milliseconds Time, const xySimulatedSample& rSample ) { return Time < rSample.Time; } );
+	if( Next == Curve.begin() ) { *pRising = false; return Curve.front().Value; }
+	if( Next == Curve.end() )   { *pRising = false; return Curve.back().Value; }
+
+	const xySimulatedSample& rPrevious = *( Next - 1 );
+	const float              Fraction  = static_cast< float >( ( Time - rPrevious.Time ).count() ) / static_cast< float >( ( Next->Time - rPrevious.Time ).count() );
+	*pRising                           = Next->Value > rPrevious.Value;
+
+	return rPrevious.Value + ( Next->Value - rPrevious.Value ) * Fraction;
+
+} // Sample
+
+//////////////////////////////////////////////////////////////////////////
+
+xySimulatedBackend::xySimulatedBackend( const xySimulatedPlatform& rPlatform )
+	: pImpl( std::make_shared< xySimulatedBackendImpl >() )
+{
+	pImpl->Platform = rPlatform;
+
+} // xySimulatedBackend
+
+//////////////////////////////////////////////////////////////////////////
+
+xyPmrDevice xySimulatedBackend::GetDevice( std::pmr::memory_resource* pMemoryResource )
+{
+	pImpl->Delay();
+
+	std::lock_guard Lock( pImpl->Mutex );
+	return { .Name=std::pmr::string( pImpl->Platform.DeviceName, pMemoryResource ) };
+
+} // GetDevice
+
+//////////////////////////////////////////////////////////////////////////
+
+xyTheme xySimulatedBackend::GetPreferredTheme( void )
+{
+	pImpl->Delay();
+
+	std::lock_guard Lock( pImpl->Mutex );
+	const auto      Interval = pImpl->Platform.ThemeFlipInterval;
+	const xyTheme   Theme    = pImpl->Platform.Theme;
+
+	if( Interval.count() <= 0 || ( pImpl->Now() / Interval ) % 2 == 0 )
+		return Theme;
+
+	return Theme == xyTheme::Light ? xyTheme::Dark : xyTheme::Light;
+
+} // GetPreferredTheme
+
+//////////////////////////////////////////////////////////////////////////
+
+xyPmrLanguage xySimulatedBackend::GetLanguage( std::pmr::memory_resource* pMemoryResource )
+{
+	pImpl->Delay();
+
+	std::lock_guard Lock( pImpl->Mutex );
+	return { .LocaleName=std::pmr::string( pImpl->Platform.LocaleName, pMemoryResource ) };
+
+} // GetLanguage
+
+//////////////////////////////////////////////////////////////////////////
+
+xyBatteryState xySimulatedBackend::GetBatteryState( void )
+{
+	pImpl->Delay();
+
+	std::lock_guard Lock( pImpl->Mutex );
+	xyBatteryState  BatteryState;
+	bool            Rising;
+
+	if( const std::optional< float > Capacity = xySimulatedBackendImpl::Sample( pImpl->Platform.BatteryCurve, pImpl->Now(), pImpl->Platform.LoopCurves, &Rising ) )
+	{
+		BatteryState.CapacityPercentage = static_cast< uint8_t >( std::clamp( *Capacity + 0.5f, 0.0f, 100.0f ) );
+		BatteryState.Charging           = Rising;
+		BatteryState.Valid              = true;
+	}
+
+	return BatteryState;
+
+} // GetBatteryState
+
+//////////////////////////////////////////////////////////////////////////
+
+xyThermalState xySimulatedBackend::GetThermalState( void )
+{
+	pImpl->Delay();
+
+	std::lock_guard Lock( pImpl->Mutex );
+	xyThermalState  ThermalState;
+	bool            Rising;
+
+	if( const std::optional< float > Temperature = xySimulatedBackendImpl::Sample( pImpl->Platform.TemperatureCurve, pImpl->Now(), pImpl->Platform.LoopCurves, &Rising ) )
+	{
+		ThermalState.Zones.push_back( { .Type="simulated", .Temperature=*Temperature } );
+
+		if     ( *Temperature >= 100.0f ) ThermalState.Status = xyThermalStatus::Critical;
+		else if( *Temperature >=  90.0f ) ThermalState.Status = xyThermalStatus::Severe;
+		else if( *Temperature >=  80.0f ) ThermalState.Status = xyThermalStatus::Moderate;
+		else if( *Temperature >=  70.0f ) ThermalState.Status = xyThermalStatus::Light;
+
+		ThermalState.Throttling = ThermalState.Status >= xyThermalStatus::Moderate;
+		ThermalState.Valid      = true;
+	}
+
+	return ThermalState;
+
+} // GetThermalState
+
+//////////////////////////////////////////////////////////////////////////
+
+std::pmr::vector< xyPmrDisplayAdapter > xySimulatedBackend::GetDisplayAdapters( std::pmr::memory_resource* pMemoryResource )
+{
+	pImpl->Delay();
+
+	std::lock_guard                         Lock( pImpl->Mutex );
+	const xySimulatedPlatform&              rPlatform = pImpl->Platform;
+	std::pmr::vector< xyPmrDisplayAdapter > DisplayAdapters( pMemoryResource );
+
+	DisplayAdapters.reserve( rPlatform.DisplayCount );
+
+	for( uint32_t i = 0; i < rPlatform.DisplayCount; ++i )
+	{
+		char Name[ 32 ];
+		std::snprintf( Name, sizeof( Name ), "Simulated Display %u", i + 1 );
+
+		const int32_t       Left    = static_cast< int32_t >( i ) * rPlatform.DisplayWidth;
+		xyPmrDisplayAdapter Adapter = { .Name     = std::pmr::string( Name, pMemoryResource ),
+		                                .FullRect = { .Left=Left, .Top=0, .Right=Left + rPlatform.DisplayWidth, .Bottom=rPlatform.DisplayHeight },
+		                                .WorkRect = { .Left=Left, .Top=0, .Right=Left + rPlatform.DisplayWidth, .Bottom=rPlatform.DisplayHeight - rPlatform.WorkAreaInset } };
+
+		DisplayAdapters.emplace_back( std::move( Adapter ) );
+	}
+
+	return DisplayAdapters;
+
+} // GetDisplayAdapters
+
+//////////////////////////////////////////////////////////////////////////
+
+std::chrono::milliseconds xySimulatedBackend::GetPollInterval( void )
+{
+	std::lock_guard Lock( pImpl->Mutex );
+	return pImpl->Platform.PollInterval;
+
+} // GetPollInterval
+
+//////////////////////////////////////////////////////////////////////////
+
+void xySimulatedBackend::Configure( const xySimulatedPlatform& rPlatform )
+{
+	std::lock_guard Lock( pImpl->Mutex );
+
+	// Carry the simulated time over, in case RealTime changes
+	pImpl->Elapsed  = pImpl->Now();
+	pImpl->Start    = std::chrono::steady_clock::now();
+	pImpl->Platform = rPlatform;
+
+} // Configure
+
+//////////////////////////////////////////////////////////////////////////
+
+void xySimulatedBackend::Advance( std::chrono::milliseconds Duration )
+{
+	std::lock_guard Lock( pImpl->Mutex );
+	pImpl->Elapsed += Duration;
+
+} // Advance
+
+//////////////////////////////////////////////////////////////////////////
+
+uint64_t xySimulatedBackend::GetCallCount( void ) const
+{
+	return pImpl->Calls.load( std::memory_order_relaxed );
+
+} // GetCallCount
+
+//////////////////////////////////////////////////////////////////////////
+
+template< typename Device >
+static void xyQueryDevice( Device& rDevice )
+{
+
+#if defined( XY_OS_WINDOWS )
+
+	CHAR  Buffer[ CNLEN + 1 ];
+	DWORD Size = static_cast< DWORD >( std::size( Buffer ) );
+	if( GetComputerNameA( Buffer, &Size ) )
+	{
+		rDevice.Name.assign( Buffer, Size );
+	}
+
+#elif defined( XY_OS_MACOS ) // XY_OS_WINDOWS
+
+	NSString* pName = [ [ NSHost currentHost ] name ];
+
+	rDevice.Name = [ pName UTF8String ];
+
+#elif defined( XY_OS_ANDROID ) // XY_OS_MACOS
+
+	JNIEnv*           pJNI   = xyGetJNIEnv();
+	const xyJNICache& rCache = xyGetJNICache();
+
+	pJNI->PushLocalFrame( 4 );
+
+	jstring     ManufacturerName     = static_cast< jstring >( pJNI->GetStaticObjectField( rCache.BuildClass, rCache.BuildManufacturer ) );
+	jstring     ModelName            = static_cast< jstring >( pJNI->GetStaticObjectField( rCache.BuildClass, rCache.BuildModel ) );
+	const char* pManufacturerNameUTF = pJNI->GetStringUTFChars( ManufacturerName, nullptr );
+	const char* pModelNameUTF        = pJNI->GetStringUTFChars( ModelName, nullptr );
+
+	rDevice.Name.append( pManufacturerNameUTF ).append( " " ).append( pModelNameUTF );
+
+	pJNI->ReleaseStringUTFChars( ModelName, pModelNameUTF );
+	pJNI->ReleaseStringUTFChars( ManufacturerName, pManufacturerNameUTF );
+	pJNI->PopLocalFrame( nullptr );
+
+#elif defined( XY_OS_IOS ) // XY_OS_ANDROID
+
+	NSString* pDeviceName = [ [ UIDevice currentDevice ] name ];
+
+	rDevice.Name = [ pDeviceName UTF8String ];
+
+#else // XY_OS_IOS
+
+	( void )rDevice;
+
+#endif // !XY_OS_WINDOWS && !XY_OS_MACOS && !XY_OS_ANDROID && !XY_OS_IOS
+
+} // xyQueryDevice
+
+//////////////////////////////////////////////////////////////////////////
+
+xyDevice xyGetDevice( void )
+{
+	xyDevice Device;
+
+	if( xyGetBackend() )
+	{
+		xyArena& rScratch = xyGetScratchArena();
+		Device.Name       = xyGetDevice( &rScratch ).Name;
+		rScratch.Reset();
+	}
+	else
+	{
+		xyQueryDevice( Device );
+	}
+
+	return Device;
+
+} // xyGetDevice
+
+//////////////////////////////////////////////////////////////////////////
+
+xyPmrDevice xyGetDevice( std::pmr::memory_resource* pMemoryResource )
+{
+	if( xyBackend* pBackend = xyGetBackend() )
+		return pBackend->GetDevice( pMemoryResource );
+
+	xyPmrDevice Device = { .Name=std::pmr::string( pMemoryResource ) };
+	xyQueryDevice( Device );
+
+	return Device;
+
+} // xyGetDevice
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyGetDevice( xyInlineDevice& rDevice )
+{
+	rDevice.Name.clear();
+
+	if( xyGetBackend() )
+	{
+		xyArena& rScratch = xyGetScratchArena();
+		rDevice.Name      = xyGetDevice( &rScratch ).Name;
+		rScratch.Reset();
+	}
+	else
+	{
+		xyQueryDevice( rDevice );
+	}
+
+} // xyGetDevice
+
+//////////////////////////////////////////////////////////////////////////
+
+xyTheme xyGetPreferredTheme( void )
+{
+	// There is nothing to theme without a display
+	if constexpr( !xyPlatform::HasDisplays )
+	{
+		return xyTheme::Light;
+	}
+	else
+	{
+		if( xyBackend* pBackend = xyGetBackend() )
+			return pBackend->GetPreferredTheme();
+
+		// Default to light theme
+		xyTheme Theme = xyTheme::Light;
+
+#if defined( XY_OS_WINDOWS )
+
+		DWORD AppsUseLightTheme;
+		DWORD DataSize = sizeof( AppsUseLightTheme );
+		if( RegGetValueA( HKEY_CURRENT_USER, "Software\\Microsoft\\Windows\\CurrentVersion\\Themes\\Personalize", "AppsUseLightTheme", RRF_RT_REG_DWORD, NULL, &AppsUseLightTheme, &DataSize ) == ERROR_SUCCESS )
+			Theme = AppsUseLightTheme ? xyTheme::Light : xyTheme::Dark;
+
+#elif defined( XY_OS_MACOS ) // XY_OS_WINDOWS
+
+		NSString* pStyle = [ [ NSUserDefaults standardUserDefaults ] stringForKey:@"AppleInterfaceStyle" ];
+		if( [ pStyle isEqualToString:@"Dark" ] )
+			Theme = xyTheme::Dark;
+
+#elif defined( XY_OS_ANDROID ) // XY_OS_MACOS
+
+		xyContext& rContext = xyGetContext();
+
+		switch( AConfiguration_getUiModeNight( rContext.pPlatformImpl->pConfiguration ) )
+		{
+			case ACONFIGURATION_UI_MODE_NIGHT_NO:  { Theme = xyTheme::Light; } break;
+			case ACONFIGURATION_UI_MODE_NIGHT_YES: { Theme = xyTheme::Dark;  } break;
+
+			default: break;
+		}
+
+#elif defined( XY_OS_IOS ) // XY_OS_ANDROID
+
+		UITraitCollection* pTraitCollection = [ UITraitCollection currentTraitCollection ];
+
+		switch( [ pTraitCollection userInterfaceStyle ] )
+		{
+			case UIUserInterfaceStyleLight: { Theme = xyTheme::Light; } break;
+			case UIUserInterfaceStyleDark:  { Theme = xyTheme::Dark;  } break;
+
+			default: break;
+		}
+
+#endif // XY_OS_IOS
+
+		return Theme;
+	}
+
+} // xyGetPreferredTheme
+
+//////////////////////////////////////////////////////////////////////////
+
+template< typename Language >
+static void xyQueryLanguage( Language& rLanguage )
+{
+
+#if defined( XY_OS_WINDOWS )
+
+	WCHAR     Buffer[ LOCALE_NAME_MAX_LENGTH ];
+	CHAR      UTF8Buffer[ LOCALE_NAME_MAX_LENGTH * 3 ];
+	const int Length     = GetUserDefaultLocaleName( Buffer, static_cast< int >( std::size( Buffer ) ) );
+	const int UTF8Length = Length > 1 ? WideCharToMultiByte( CP_UTF8, 0, Buffer, Length - 1, UTF8Buffer, static_cast< int >( std::size( UTF8Buffer ) ), nullptr, nullptr ) : 0;
+
+	// Converted on the stack, so that every kind of result string can be assigned from it without an intermediate allocation. The returned length includes the null terminator.
+	rLanguage.LocaleName.assign( UTF8Buffer, UTF8Length );
+
+#elif defined( XY_OS_MACOS ) // XY_OS_WINDOWS
+
+	NSString* pLanguageCode = [ [ NSLocale currentLocale ] languageCode ];
+
+	rLanguage.LocaleName = [ pLanguageCode UTF8String ];
+
+#elif defined( XY_OS_ANDROID ) // XY_OS_MACOS
+
+	xyContext& rContext = xyGetContext();
+	char       LanguageCode[ 2 ];
+	AConfiguration_getLanguage( rContext.pPlatformImpl->pConfiguration, LanguageCode );
+
+	rLanguage.LocaleName.assign( LanguageCode, 2 );
+
+#elif defined( XY_OS_IOS ) // XY_OS_ANDROID
+
+	NSString* pLanguage = [ [ NSLocale preferredLanguages ] firstObject ];
+
+	rLanguage.LocaleName = [ pLanguage UTF8String ];
+
+#elif defined( XY_OS_LINUX ) // XY_OS_IOS
+
+	// Same precedence as setlocale for LC_MESSAGES. Values look like "sv_SE.UTF-8@euro", which is trimmed down to "sv-SE".
+	for( const char* pVariable : { "LC_ALL", "LC_MESSAGES", "LANG" } )
+	{
+		const char* pValue = getenv( pVariable );
+		if( pValue == nullptr || *pValue == '\0' )
+			continue;
+
+		std::string_view Value = pValue;
+		Value                  = Value.substr( 0, Value.find_first_of( ".@" ) );
+
+		if( Value != "C" && Value != "POSIX" )
+		{
+			rLanguage.LocaleName = Value;
+			std::replace( rLanguage.LocaleName.begin(), rLanguage.LocaleName.end(), '_', '-' );
+		}
+
+		break;
+	}
+
+#endif // XY_OS_LINUX
+
+} // xyQueryLanguage
+
+//////////////////////////////////////////////////////////////////////////
+
+xyLanguage xyGetLanguage( void )
+{
+	xyLanguage Language;
+
+	if( xyGetBackend() )
+	{
+		xyArena& rScratch   = xyGetScratchArena();
+		Language.LocaleName = xyGetLanguage( &rScratch ).LocaleName;
+		rScratch.Reset();
+	}
+	else
+	{
+		xyQueryLanguage( Language );
+	}
+
+	return Language;
+
+} // xyGetLanguage
+
+//////////////////////////////////////////////////////////////////////////
+
+xyPmrLanguage xyGetLanguage( std::pmr::memory_resource* pMemoryResource )
+{
+	if( xyBackend* pBackend = xyGetBackend() )
+		return pBackend->GetLanguage( pMemoryResource );
+
+	xyPmrLanguage Language = { .LocaleName=std::pmr::string( pMemoryResource ) };
+	xyQueryLanguage( Language );
+
+	return Language;
+
+} // xyGetLanguage
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyGetLanguage( xyInlineLanguage& rLanguage )
+{
+	rLanguage.LocaleName.clear();
+
+	if( xyGetBackend() )
+	{
+		xyArena& rScratch    = xyGetScratchArena();
+		rLanguage.LocaleName = xyGetLanguage( &rScratch ).LocaleName;
+		rScratch.Reset();
+	}
+	else
+	{
+		xyQueryLanguage( rLanguage );
+	}
+
+} // xyGetLanguage
+
+//////////////////////////////////////////////////////////////////////////
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+static std::string_view xyReadSmallFile( const char* pPath, std::span< char > Buffer )
+{
+	const int File = open( pPath, O_RDONLY | O_CLOEXEC );
+	if( File < 0 )
+		return { };
+
+	const ssize_t Size = read( File, Buffer.data(), Buffer.size() );
+	close( File );
+
+	std::string_view Contents( Buffer.data(), Size > 0 ? Size : 0 );
+	while( !Contents.empty() && std::isspace( static_cast< unsigned char >( Contents.back() ) ) )
+		Contents.remove_suffix( 1 );
+
+	return Contents;
+
+} // xyReadSmallFile
+
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyMarkStartupPhase( const char* pName )
+{
+	xyContext& rContext = xyGetContext();
+
+	rContext.StartupPhases.push_back( { .pName=pName, .Time=std::chrono::steady_clock::now() - rContext.StartTime } );
+
+} // xyMarkStartupPhase
+
+//////////////////////////////////////////////////////////////////////////
+
+xyStartupProfile xyGetStartupProfile( void )
+{
+	const xyContext& rContext = xyGetContext();
+	xyStartupProfile Profile  = { .BeforeEntry=std::nullopt, .ToMain=std::chrono::nanoseconds( 0 ), .Phases=rContext.StartupPhases };
+
+	for( const xyStartupPhase& rPhase : rContext.StartupPhases )
+	{
+		if( std::strcmp( rPhase.pName, "xyMain" ) == 0 )
+			Profile.ToMain = rPhase.Time;
+	}
+
+	// How long the process has existed, measured on the same clock as its creation time
+	std::optional< std::chrono::nanoseconds > ProcessAge;
+
+#if defined( XY_OS_WINDOWS )
+
+	FILETIME CreationTime, ExitTime, KernelTime, UserTime, Now;
+	if( GetProcessTimes( GetCurrentProcess(), &CreationTime, &ExitTime, &KernelTime, &UserTime ) )
+	{
+		GetSystemTimePreciseAsFileTime( &Now );
+
+		const uint64_t Created = ( static_cast< uint64_t >( CreationTime.dwHighDateTime ) << 32 ) | CreationTime.dwLowDateTime;
+		const uint64_t Current = ( static_cast< uint64_t >( Now.dwHighDateTime ) << 32 ) | Now.dwLowDateTime;
+		ProcessAge             = std::chrono::nanoseconds( ( Current - Created ) * 100 );
+	}
+
+#elif defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID ) // XY_OS_WINDOWS
+
+	// The start time is the 22nd field, in clock ticks since boot. The second field is the command name, which can contain spaces, so count from the last parenthesis.
+	char             Buffer[ 1024 ];
+	std::string_view Stat = xyReadSmallFile( "/proc/self/stat", Buffer );
+	if( const size_t End = Stat.rfind( ')' ); End != std::string_view::npos )
+	{
+		Stat.remove_prefix( End + 1 );
+
+		unsigned long long StartTicks = 0;
+		timespec           Now;
+		if( std::sscanf( std::string( Stat ).c_str(), " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %*u %*u %*d %*d %*d %*d %*d %*d %llu", &StartTicks ) == 1 && clock_gettime( CLOCK_BOOTTIME, &Now ) == 0 )
+		{
+			const int64_t Started = static_cast< int64_t >( StartTicks ) * 1'000'000'000 / sysconf( _SC_CLK_TCK );
+			ProcessAge            = std::chrono::nanoseconds( static_cast< int64_t >( Now.tv_sec ) * 1'000'000'000 + Now.tv_nsec - Started );
+		}
+	}
+
+#elif defined( XY_OS_MACOS ) || defined( XY_OS_IOS ) || defined( XY_OS_TVOS ) || defined( XY_OS_WATCHOS ) // XY_OS_LINUX || XY_OS_ANDROID
+
+	int        Name[ 4 ] = { CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid() };
+	kinfo_proc Info;
+	size_t     Size      = sizeof( Info );
+	timeval    Now;
+	if( sysctl( Name, 4, &Info, &Size, nullptr, 0 ) == 0 && gettimeofday( &Now, nullptr ) == 0 )
+	{
+		const timeval& rStarted = Info.kp_proc.p_starttime;
+		ProcessAge              = std::chrono::seconds( Now.tv_sec - rStarted.tv_sec ) + std::chrono::microseconds( Now.tv_usec - rStarted.tv_usec );
+	}
+
+#endif // XY_OS_MACOS || XY_OS_IOS || XY_OS_TVOS || XY_OS_WATCHOS
+
+	if( ProcessAge )
+		Profile.BeforeEntry = std::max( *ProcessAge - ( std::chrono::steady_clock::now() - rContext.StartTime ), std::chrono::nanoseconds( 0 ) );
+
+	return Profile;
+
+} // xyGetStartupProfile
+
+//////////////////////////////////////////////////////////////////////////
+
+xyBatteryState xyGetBatteryState( void )
+{
+	if constexpr( !xyPlatform::HasBattery )
+	{
+		return { };
+	}
+	else
+	{
+		if( xyBackend* pBackend = xyGetBackend() )
+			return pBackend->GetBatteryState();
+
+		xyBatteryState BatteryState;
+
+#if defined( XY_OS_WINDOWS )
+
+		SYSTEM_POWER_STATUS SystemPowerStatus;
+		if( GetSystemPowerStatus( &SystemPowerStatus ) && SystemPowerStatus.BatteryFlag ^ 128 )
+		{
+			BatteryState.CapacityPercentage = SystemPowerStatus.BatteryLifePercent;
+			BatteryState.Charging           = SystemPowerStatus.BatteryFlag & 8;
+			BatteryState.Valid              = true;
+		}
+
+#elif defined( XY_OS_MACOS ) // XY_OS_WINDOWS
+
+		CFMutableDictionaryRef Service = IOServiceMatching( "IOPMPowerSource" );
+		if( io_registry_entry_t Entry = IOServiceGetMatchingService( kIOMasterPortDefault, Service ) )
+		{
+			CFMutableDictionaryRef Properties = nullptr;
+			if( IORegistryEntryCreateCFProperties( Entry, &Properties, nullptr, 0 ) == kIOReturnSuccess )
+			{
+				NSDictionary* pRawProperties = ( NSDictionary* )Properties;
+				bool          IsCharging     = [ [ pRawProperties objectForKey:@"IsCharging" ]      boolValue ];
+				double        Capacity       = [ [ pRawProperties objectForKey:@"CurrentCapacity" ] doubleValue ];
+				double        MaxCapacity    = [ [ pRawProperties objectForKey:@"MaxCapacity" ]     doubleValue ];
+
+				BatteryState.CapacityPercentage = static_cast< uint8_t >( 100.0 * Capacity / MaxCapacity );
+				BatteryState.Charging           = IsCharging;
+				BatteryState.Valid              = true;
+			}
+
+			IOObjectRelease( Entry );
+		}
+
+#elif defined( XY_OS_ANDROID ) // XY_OS_MACOS
+
+		JNIEnv*           pEnv   = xyGetJNIEnv();
+		const xyJNICache& rCache = xyGetJNICache();
+
+		if( rCache.BatteryManager )
+		{
+			jint Capacity = pEnv->CallIntMethod( rCache.BatteryManager, rCache.BatteryManagerGetIntProperty, rCache.BatteryPropertyCapacity );
+			jint Status   = pEnv->CallIntMethod( rCache.BatteryManager, rCache.BatteryManagerGetIntProperty, rCache.BatteryPropertyStatus );
+
+			BatteryState.CapacityPercentage = static_cast< uint8_t >( Capacity );
+			BatteryState.Charging           = Status == rCache.BatteryStatusCharging;
+			BatteryState.Valid              = true;
+		}
+
+#elif defined( XY_OS_IOS ) // XY_OS_ANDROID
+		
+		UIDevice*   pDevice = [ UIDevice currentDevice ];
+		const float Level   = [ pDevice batteryLevel ];
+		
+		if( BatteryState.Valid = ( Level >= 0.0f ) )
+		{
+			BatteryState.CapacityPercentage = static_cast< uint8_t >( 100.0f * Level );
+			BatteryState.Charging           = [ pDevice batteryState ] == UIDeviceBatteryStateCharging;
+		}
+
+#elif defined( XY_OS_LINUX ) // XY_OS_IOS
+
+		if( DIR* pDirectory = opendir( "/sys/class/power_supply" ) )
+		{
+			while( dirent* pEntry = readdir( pDirectory ) )
+			{
+				const std::string Path = std::string( "/sys/class/power_supply/" ) + pEntry->d_name;
+				char              Buffer[ 32 ];
+
+				if( pEntry->d_name[ 0 ] == '.' || xyReadSmallFile( ( Path + "/type" ).c_str(), Buffer ) != "Battery" )
+					continue;
+
+				const std::string_view Capacity = xyReadSmallFile( ( Path + "/capacity" ).c_str(), Buffer );
+				if( Capacity.empty() )
+					continue;
+
+				BatteryState.CapacityPercentage = static_cast< uint8_t >( std::clamp( std::atoi( std::string( Capacity ).c_str() ), 0, 100 ) );
+
+				// A full battery is still on external power, which is what matters to callers.
+				// Unknown and "Not charging" are also reported by batteries that run the system, so they don't count.
+				const std::string_view Status = xyReadSmallFile( ( Path + "/status" ).c_str(), Buffer );
+				BatteryState.Charging         = Status == "Charging" || Status == "Full";
+				BatteryState.Valid = true;
+				break;
+			}
+
+			closedir( pDirectory );
+		}
+
+#endif // XY_OS_LINUX
+
+		return BatteryState;
+	}
+
+} // xyGetBatteryState
+
+//////////////////////////////////////////////////////////////////////////
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+struct xySysfsCache
+{
+	struct Zone
+	{
+		xyInlineString< 32 > Type;
+		int                  Temperature = -1;
+
+	}; // Zone
+
+	struct Core
+	{
+		int Current = -1;
+		int Min     = -1;
+		int Max     = -1;
+		int Limit   = -1;
+
+	}; // Core
+
+	~xySysfsCache( void ) { Close(); }
+
+	void Open ( void );
+	void Close( void );
+
+	static int64_t Read( int File );
+
+	std::mutex           Mutex;
+	std::string          Root;
+	bool                 Opened = false;
+	std::vector< Zone >  Zones;
+	std::vector< Core >  Cores;
+	std::vector< int >   CoolingDevices;
+
+}; // xySysfsCache
+
+//////////////////////////////////////////////////////////////////////////
+
+static xySysfsCache& xyGetSysfsCache( void )
+{
+	static xySysfsCache SysfsCache;
+	return SysfsCache;
+
+} // xyGetSysfsCache
+
+//////////////////////////////////////////////////////////////////////////
+
+void xySysfsCache::Open( void )
+{
+	auto OpenAttribute = [ this ]( const std::string& rPath ) { return open( ( Root + rPath ).c_str(), O_RDONLY | O_CLOEXEC ); };
+
+	// Sort the entries of a directory by the number following the prefix, so that zones and cores come out in order
+	auto List = [ this ]( const char* pDirectory, std::string_view Prefix )
+	{
+		std::vector< std::pair< int, std::string > > Entries;
+
+		if( DIR* pHandle = opendir( ( Root + pDirectory ).c_str() ) )
+		{
+			while( dirent* pEntry = readdir( pHandle ) )
+			{
+				const std::string_view Name( pEntry->d_name );
+				if( Name.starts_with( Prefix ) && Name.size() > Prefix.size() && std::all_of( Name.begin() + Prefix.size(), Name.end(), []( char c ) { return c >= '0' && c <= '9'; } ) )
+					Entries.emplace_back( std::atoi( pEntry->d_name + Prefix.size() ), std::string( pDirectory ) + "/" + pEntry->d_name );
+			}
+
+			closedir( pHandle );
+		}
+
+		std::sort( Entries.begin(), Entries.end() );
+		return Entries;
+	};
+
+	for( const auto& [ Index, rPath ] : List( "/sys/class/thermal", "thermal_zone" ) )
+	{
+		char Buffer[ 64 ];
+
+		Zones.push_back( { .Type=xyReadSmallFile( ( Root + rPath + "/type" ).c_str(), Buffer ), .Temperature=OpenAttribute( rPath + "/temp" ) } );
+	}
+
+	for( const auto& [ Index, rPath ] : List( "/sys/class/thermal", "cooling_device" ) )
+		CoolingDevices.push_back( OpenAttribute( rPath + "/cur_state" ) );
+
+	for( const auto& [ Index, rPath ] : List( "/sys/devices/system/cpu", "cpu" ) )
+		Cores.push_back( { .Current=OpenAttribute( rPath + "/cpufreq/scaling_cur_freq" ), .Min=OpenAttribute( rPath + "/cpufreq/cpuinfo_min_freq" ), .Max=OpenAttribute( rPath + "/cpufreq/cpuinfo_max_freq" ), .Limit=OpenAttribute( rPath + "/cpufreq/scaling_max_freq" ) } );
+
+	Opened = true;
+
+} // Open
+
+//////////////////////////////////////////////////////////////////////////
+
+void xySysfsCache::Close( void )
+{
+	auto CloseAttribute = []( int File ) { if( File >= 0 ) close( File ); };
+
+	for( const Zone& rZone : Zones )
+		CloseAttribute( rZone.Temperature );
+
+	for( const Core& rCore : Cores )
+	{
+		CloseAttribute( rCore.Current );
+		CloseAttribute( rCore.Min );
+		CloseAttribute( rCore.Max );
+		CloseAttribute( rCore.Limit );
+	}
+
+	for( int File : CoolingDevices )
+		CloseAttribute( File );
+
+	Zones.clear();
+	Cores.clear();
+	CoolingDevices.clear();
+	Opened = false;
+
+} // Close
+
+//////////////////////////////////////////////////////////////////////////
+
+int64_t xySysfsCache::Read( int File )
+{
+	if( File < 0 )
+		return -1;
+
+	// Sysfs regenerates the contents of an attribute whenever it is read from the start
+	char          Buffer[ 32 ];
+	const ssize_t Size = pread( File, Buffer, sizeof( Buffer ) - 1, 0 );
+	if( Size <= 0 )
+		return -1;
+
+	Buffer[ Size ] = '\0';
+
+	return std::strtoll( Buffer, nullptr, 10 );
+
+} // Read
+
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+//////////////////////////////////////////////////////////////////////////
+
+xyThermalState xyGetThermalState( void )
+{
+	if( xyBackend* pBackend = xyGetBackend() )
+		return pBackend->GetThermalState();
+
+	xyThermalState ThermalState;
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+	xySysfsCache&   rCache = xyGetSysfsCache();
+	std::lock_guard Lock( rCache.Mutex );
+
+	if( !rCache.Opened )
+		rCache.Open();
+
+	for( const xySysfsCache::Zone& rZone : rCache.Zones )
+	{
+		// Reported in millidegrees Celsius
+		if( const int64_t Temperature = xySysfsCache::Read( rZone.Temperature ); Temperature != -1 )
+			ThermalState.Zones.push_back( { .Type=rZone.Type, .Temperature=Temperature / 1000.0f } );
+	}
+
+	for( const xySysfsCache::Core& rCore : rCache.Cores )
+	{
+		const xyCpuFrequency Frequency = { .CurrentKHz=static_cast< uint32_t >( std::max< int64_t >( xySysfsCache::Read( rCore.Current ), 0 ) ),
+		                                   .MinKHz    =static_cast< uint32_t >( std::max< int64_t >( xySysfsCache::Read( rCore.Min ), 0 ) ),
+		                                   .MaxKHz    =static_cast< uint32_t >( std::max< int64_t >( xySysfsCache::Read( rCore.Max ), 0 ) ),
+		                                   .LimitKHz  =static_cast< uint32_t >( std::max< int64_t >( xySysfsCache::Read( rCore.Limit ), 0 ) ) };
+
+		ThermalState.Cores.push_back( Frequency );
+		ThermalState.Throttling |= Frequency.LimitKHz && Frequency.LimitKHz < Frequency.MaxKHz;
+	}
+
+	for( int File : rCache.CoolingDevices )
+		ThermalState.Throttling |= xySysfsCache::Read( File ) > 0;
+
+	ThermalState.Status = ThermalState.Throttling ? xyThermalStatus::Moderate : xyThermalStatus::None;
+	ThermalState.Valid  = !ThermalState.Zones.empty() || !ThermalState.Cores.empty();
+
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+#if defined( XY_OS_WINDOWS )
+
+	// Not declared by the Windows headers
+	struct ProcessorPowerInformation
+	{
+		ULONG Number;
+		ULONG MaxMhz;
+		ULONG CurrentMhz;
+		ULONG MhzLimit;
+		ULONG MaxIdleState;
+		ULONG CurrentIdleState;
+
+	}; // ProcessorPowerInformation
+
+	SYSTEM_INFO SystemInfo;
+	GetSystemInfo( &SystemInfo );
+
+	std::vector< ProcessorPowerInformation > Processors( SystemInfo.dwNumberOfProcessors );
+	if( CallNtPowerInformation( ProcessorInformation, NULL, 0, Processors.data(), static_cast< ULONG >( Processors.size() * sizeof( ProcessorPowerInformation ) ) ) == 0 )
+	{
+		for( const ProcessorPowerInformation& rProcessor : Processors )
+		{
+			ThermalState.Cores.push_back( { .CurrentKHz=rProcessor.CurrentMhz * 1000, .MinKHz=0, .MaxKHz=rProcessor.MaxMhz * 1000, .LimitKHz=rProcessor.MhzLimit * 1000 } );
+			ThermalState.Throttling |= rProcessor.MhzLimit < rProcessor.MaxMhz;
+		}
+
+		ThermalState.Status = ThermalState.Throttling ? xyThermalStatus::Moderate : xyThermalStatus::None;
+		ThermalState.Valid  = true;
+	}
+
+#elif defined( XY_OS_MACOS ) || defined( XY_OS_IOS ) || defined( XY_OS_TVOS ) || defined( XY_OS_WATCHOS ) // XY_OS_WINDOWS
+
+	switch( [ [ NSProcessInfo processInfo ] thermalState ] )
+	{
+		case NSProcessInfoThermalStateNominal:  ThermalState.Status = xyThermalStatus::None;     break;
+		case NSProcessInfoThermalStateFair:     ThermalState.Status = xyThermalStatus::Light;    break;
+		case NSProcessInfoThermalStateSerious:  ThermalState.Status = xyThermalStatus::Severe;   break;
+		case NSProcessInfoThermalStateCritical: ThermalState.Status = xyThermalStatus::Critical; break;
+	}
+
+	ThermalState.Throttling = ThermalState.Status >= xyThermalStatus::Severe;
+	ThermalState.Valid      = true;
+
+#elif defined( XY_OS_ANDROID ) // XY_OS_MACOS || XY_OS_IOS || XY_OS_TVOS || XY_OS_WATCHOS
+
+	JNIEnv*           pEnv   = xyGetJNIEnv();
+	const xyJNICache& rCache = xyGetJNICache();
+
+	// PowerManager.getCurrentThermalStatus was added in API level 29, and its values match xyThermalStatus
+	if( rCache.PowerManager && rCache.PowerManagerGetCurrentThermalStatus )
+	{
+		ThermalState.Status      = static_cast< xyThermalStatus >( std::clamp< jint >( pEnv->CallIntMethod( rCache.PowerManager, rCache.PowerManagerGetCurrentThermalStatus ), 0, 6 ) );
+		ThermalState.Throttling |= ThermalState.Status >= xyThermalStatus::Moderate;
+		ThermalState.Valid       = true;
+	}
+
+#endif // XY_OS_ANDROID
+
+	return ThermalState;
+
+} // xyGetThermalState
+
+//////////////////////////////////////////////////////////////////////////
+
+void xySetSysfsRoot( std::string_view Root )
+{
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+	xySysfsCache&   rCache = xyGetSysfsCache();
+	std::lock_guard Lock( rCache.Mutex );
+
+	rCache.Close();
+	rCache.Root = Root;
+
+#else // XY_OS_LINUX || XY_OS_ANDROID
+
+	( void )Root;
+
+#endif // !XY_OS_LINUX && !XY_OS_ANDROID
+
+} // xySetSysfsRoot
+
+//////////////////////////////////////////////////////////////////////////
+
+std::vector< xyStorageVolume > xyGetStorageVolumes( void )
+{
+	std::vector< xyStorageVolume > Volumes;
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+	std::string MountInfo;
+	if( const int File = open( "/proc/self/mountinfo", O_RDONLY | O_CLOEXEC ); File >= 0 )
+	{
+		char    Buffer[ 4096 ];
+		ssize_t Size;
+
+		while( ( Size = read( File, Buffer, sizeof( Buffer ) ) ) > 0 )
+			MountInfo.append( Buffer, static_cast< size_t >( Size ) );
+
+		close( File );
+	}
+
+	std::string SysfsRoot;
+	{
+		xySysfsCache&   rCache = xyGetSysfsCache();
+		std::lock_guard Lock( rCache.Mutex );
+
+		SysfsRoot = rCache.Root;
+	}
+
+	auto NextField = []( std::string_view& rLine )
+	{
+		const std::string_view Field = rLine.substr( 0, rLine.find( ' ' ) );
+		rLine.remove_prefix( std::min( Field.size() + 1, rLine.size() ) );
+		return Field;
+	};
+
+	// Spaces, tabs, newlines and backslashes in paths are written as octal escapes, such as "\040"
+	auto Unescape = []( std::string_view Field )
+	{
+		std::string Result;
+
+		for( size_t Index = 0; Index < Field.size(); ++Index )
+		{
+			if( Field[ Index ] == '\\' && Index + 3 < Field.size() && std::all_of( Field.begin() + Index + 1, Field.begin() + Index + 4, []( char c ) { return c >= '0' && c <= '7'; } ) )
+			{
+				Result += static_cast< char >( ( Field[ Index + 1 ] - '0' ) * 64 + ( Field[ Index + 2 ] - '0' ) * 8 + ( Field[ Index + 3 ] - '0' ) );
+				Index  += 3;
+			}
+			else
+			{
+				Result += Field[ Index ];
+			}
+		}
+
+		return Result;
+	};
+
+	auto ReadNumber = []( const std::string& rPath ) -> int64_t
+	{
+		char                   Buffer[ 32 ];
+		const std::string_view Value = xyReadSmallFile( rPath.c_str(), Buffer );
+
+		return Value.empty() ? -1 : std::strtoll( std::string( Value ).c_str(), nullptr, 10 );
+	};
+
+	for( std::string_view Remaining = MountInfo; !Remaining.empty(); )
+	{
+		std::string_view Line = Remaining.substr( 0, Remaining.find( '\n' ) );
+		Remaining.remove_prefix( std::min( Line.size() + 1, Remaining.size() ) );
+
+		// "36 35 98:0 /mnt1 /mnt/parent rw,noatime master:1 - ext3 /dev/root rw,errors=continue"
+		NextField( Line );
+		NextField( Line );
+		const std::string_view DeviceNumber = NextField( Line );
+		NextField( Line );
+		const std::string      MountPoint   = Unescape( NextField( Line ) );
+
+		// Skip the optional fields
+		if( const size_t Separator = Line.find( " - " ); Separator != std::string_view::npos ) Line.remove_prefix( Separator + 3 );
+		else                                                                                   continue;
+
+		const std::string_view FileSystem = NextField( Line );
+		const std::string      Device     = Unescape( NextField( Line ) );
+
+		struct statvfs Status;
+		if( statvfs( MountPoint.c_str(), &Status ) != 0 || Status.f_blocks == 0 )
+			continue;
+
+		xyStorageVolume Volume = { .MountPoint=MountPoint, .Device=Device, .FileSystem=FileSystem };
+		Volume.TotalBytes      = static_cast< uint64_t >( Status.f_blocks ) * Status.f_frsize;
+		Volume.FreeBytes       = static_cast< uint64_t >( Status.f_bavail ) * Status.f_frsize;
+		Volume.ReadOnly        = ( Status.f_flag & ST_RDONLY ) != 0;
+
+		// Partitions have no queue of their own, but share the one of the disk they are on. Virtual file systems such as tmpfs and overlay have neither.
+		std::string Queue      = SysfsRoot + "/sys/dev/block/" + std::string( DeviceNumber ) + "/queue/";
+		int64_t     Rotational = ReadNumber( Queue + "rotational" );
+		if( Rotational < 0 )
+		{
+			Queue      = SysfsRoot + "/sys/dev/block/" + std::string( DeviceNumber ) + "/../queue/";
+			Rotational = ReadNumber( Queue + "rotational" );
+		}
+
+		if( Rotational >= 0 )
+		{
+			Volume.Rotational    = Rotational > 0;
+			Volume.OptimalIOSize = static_cast< uint32_t >( std::max< int64_t >( ReadNumber( Queue + "optimal_io_size" ), 0 ) );
+			Volume.MinimumIOSize = static_cast< uint32_t >( std::max< int64_t >( ReadNumber( Queue + "minimum_io_size" ), 0 ) );
+			Volume.QueueDepth    = static_cast< uint32_t >( std::max< int64_t >( ReadNumber( Queue + "nr_requests" ), 0 ) );
+			Volume.Discard       = ReadNumber( Queue + "discard_max_bytes" ) > 0;
+
+			// O_DIRECT bypasses the page cache and goes straight to the block device
+			Volume.DirectIO = true;
+		}
+
+		if( Volume.OptimalIOSize == 0 )
+			Volume.OptimalIOSize = static_cast< uint32_t >( Status.f_bsize );
+
+		// A later mount on the same point hides the earlier one
+		std::erase_if( Volumes, [ & ]( const xyStorageVolume& rOther ) { return rOther.MountPoint == Volume.MountPoint; } );
+		Volumes.push_back( std::move( Volume ) );
+	}
+
+#elif defined( XY_OS_WINDOWS ) // XY_OS_LINUX || XY_OS_ANDROID
+
+	WCHAR Drives[ 256 ];
+	if( GetLogicalDriveStringsW( static_cast< DWORD >( std::size( Drives ) ), Drives ) == 0 )
+		return Volumes;
+
+	for( const WCHAR* pDrive = Drives; *pDrive; pDrive += wcslen( pDrive ) + 1 )
+	{
+		// Empty card readers and optical drives fail here
+		ULARGE_INTEGER Available;
+		ULARGE_INTEGER Total;
+		if( !GetDiskFreeSpaceExW( pDrive, &Available, &Total, NULL ) )
+			continue;
+
+		WCHAR FileSystem[ MAX_PATH + 1 ] = { };
+		DWORD Flags                      = 0;
+		GetVolumeInformationW( pDrive, NULL, 0, NULL, NULL, &Flags, FileSystem, static_cast< DWORD >( std::size( FileSystem ) ) );
+
+		xyStorageVolume Volume = { .MountPoint=xyUTF( pDrive ), .Device={ }, .FileSystem=xyUTF( FileSystem ) };
+		Volume.TotalBytes      = Total.QuadPart;
+		Volume.FreeBytes       = Available.QuadPart;
+		Volume.ReadOnly        = ( Flags & FILE_READ_ONLY_VOLUME ) != 0;
+
+		DWORD SectorsPerCluster;
+		DWORD BytesPerSector;
+		DWORD FreeClusters;
+		DWORD TotalClusters;
+		if( GetDiskFreeSpaceW( pDrive, &SectorsPerCluster, &BytesPerSector, &FreeClusters, &TotalClusters ) )
+		{
+			Volume.OptimalIOSize = SectorsPerCluster * BytesPerSector;
+			Volume.MinimumIOSize = BytesPerSector;
+		}
+
+		// "C:\" becomes "C:" for QueryDosDevice and "\\.\C:" for CreateFile
+		const std::wstring DriveName( pDrive, 2 );
+		WCHAR              DeviceName[ MAX_PATH ];
+		if( QueryDosDeviceW( DriveName.c_str(), DeviceName, static_cast< DWORD >( std::size( DeviceName ) ) ) )
+			Volume.Device = xyUTF( DeviceName );
+
+		// Property queries need no access rights, and thus no elevation
+		const std::wstring DevicePath = L"\\\\.\\" + DriveName;
+		HANDLE             Device     = CreateFileW( DevicePath.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL );
+		if( Device != INVALID_HANDLE_VALUE )
+		{
+			auto Query = [ Device ]( STORAGE_PROPERTY_ID Property, auto& rDescriptor )
+			{
+				STORAGE_PROPERTY_QUERY PropertyQuery = { .PropertyId=Property, .QueryType=PropertyStandardQuery, .AdditionalParameters={ } };
+				DWORD                  Returned;
+
+				return DeviceIoControl( Device, IOCTL_STORAGE_QUERY_PROPERTY, &PropertyQuery, sizeof( PropertyQuery ), &rDescriptor, sizeof( rDescriptor ), &Returned, NULL ) && Returned >= sizeof( rDescriptor );
+			};
+
+			DEVICE_SEEK_PENALTY_DESCRIPTOR      SeekPenalty = { };
+			STORAGE_ACCESS_ALIGNMENT_DESCRIPTOR Alignment   = { };
+			DEVICE_TRIM_DESCRIPTOR              Trim        = { };
+
+			if( Query( StorageDeviceSeekPenaltyProperty, SeekPenalty ) ) Volume.Rotational    = SeekPenalty.IncursSeekPenalty;
+			if( Query( StorageAccessAlignmentProperty, Alignment ) )     Volume.MinimumIOSize = Alignment.BytesPerPhysicalSector;
+			if( Query( StorageDeviceTrimProperty, Trim ) )               Volume.Discard       = Trim.TrimEnabled;
+
+			// FILE_FLAG_NO_BUFFERING works on any volume that is backed by a disk
+			Volume.DirectIO = true;
+
+			CloseHandle( Device );
+		}
+
+		Volumes.push_back( std::move( Volume ) );
+	}
+
+#elif defined( XY_OS_MACOS ) || defined( XY_OS_IOS ) || defined( XY_OS_TVOS ) || defined( XY_OS_WATCHOS ) // XY_OS_WINDOWS
+
+	// The array is owned by the system and reused by the next call
+	struct statfs* pMounts = nullptr;
+	const int      Count   = getmntinfo( &pMounts, MNT_NOWAIT );
+
+	for( int Index = 0; Index < Count; ++Index )
+	{
+		const struct statfs& rMount = pMounts[ Index ];
+		if( rMount.f_blocks == 0 )
+			continue;
+
+		xyStorageVolume Volume = { .MountPoint=rMount.f_mntonname, .Device=rMount.f_mntfromname, .FileSystem=rMount.f_fstypename };
+		Volume.TotalBytes      = static_cast< uint64_t >( rMount.f_blocks ) * rMount.f_bsize;
+		Volume.FreeBytes       = static_cast< uint64_t >( rMount.f_bavail ) * rMount.f_bsize;
+		Volume.OptimalIOSize   = static_cast< uint32_t >( rMount.f_iosize );
+		Volume.MinimumIOSize   = static_cast< uint32_t >( rMount.f_bsize );
+		Volume.ReadOnly        = ( rMount.f_flags & MNT_RDONLY ) != 0;
+
+		// F_NOCACHE is honored by local file systems
+		Volume.DirectIO = ( rMount.f_flags & MNT_LOCAL ) != 0;
+
+		Volumes.push_back( std::move( Volume ) );
+	}
+
+#endif // XY_OS_MACOS || XY_OS_IOS || XY_OS_TVOS || XY_OS_WATCHOS
+
+	return Volumes;
+
+} // xyGetStorageVolumes
+
+//////////////////////////////////////////////////////////////////////////
+
+std::optional< xyStorageVolume > xyGetStorageVolume( std::string_view Path )
+{
+	std::string Resolved( Path );
+
+#if defined( XY_OS_WINDOWS )
+
+	// Also resolves mounted folders, which GetLogicalDriveStrings does not list, to the drive they are on
+	WCHAR VolumePath[ MAX_PATH ];
+	if( GetVolumePathNameW( xyUnicode( Path ).c_str(), VolumePath, static_cast< DWORD >( std::size( VolumePath ) ) ) )
+		Resolved = xyUTF( VolumePath );
+
+#else // XY_OS_WINDOWS
+
+	if( char* pResolved = realpath( Resolved.c_str(), nullptr ) )
+	{
+		Resolved = pResolved;
+		free( pResolved );
+	}
+
+#endif // !XY_OS_WINDOWS
+
+	std::vector< xyStorageVolume >   Volumes = xyGetStorageVolumes();
+	std::optional< xyStorageVolume > Result;
+
+	// The deepest mount point that contains the path
+	for( xyStorageVolume& rVolume : Volumes )
+	{
+		const std::string& rMountPoint = rVolume.MountPoint;
+		const bool         Contains    = Resolved.starts_with( rMountPoint ) && ( Resolved.size() == rMountPoint.size() || rMountPoint.ends_with( '/' ) || rMountPoint.ends_with( '\\' ) || Resolved[ rMountPoint.size() ] == '/' );
+
+		if( Contains && ( !Result || rMountPoint.size() > Result->MountPoint.size() ) )
+			Result = std::move( rVolume );
+	}
+
+	return Result;
+
+} // xyGetStorageVolume
+
+//////////////////////////////////////////////////////////////////////////
+
+static xyNetworkAddress xyMakeNetworkAddress( const sockaddr* pAddress, uint8_t PrefixLength )
+{
+	xyNetworkAddress Address = { .Address={ }, .PrefixLength=PrefixLength, .IPv6=pAddress->sa_family == AF_INET6 };
+	char             Buffer[ INET6_ADDRSTRLEN ];
+	const void*      pBytes  = Address.IPv6 ? static_cast< const void* >( &reinterpret_cast< const sockaddr_in6* >( pAddress )->sin6_addr ) : static_cast< const void* >( &reinterpret_cast< const sockaddr_in* >( pAddress )->sin_addr );
+
+	if( inet_ntop( pAddress->sa_family, pBytes, Buffer, sizeof( Buffer ) ) )
+		Address.Address = Buffer;
+
+	return Address;
+
+} // xyMakeNetworkAddress
+
+//////////////////////////////////////////////////////////////////////////
+
+std::vector< xyNetworkInterface > xyGetNetworkInterfaces( void )
+{
+	std::vector< xyNetworkInterface > Interfaces;
+
+#if defined( XY_OS_WINDOWS )
+
+	std::vector< std::byte > Buffer;
+	ULONG                    Size   = 16 * 1024;
+	ULONG                    Result = ERROR_BUFFER_OVERFLOW;
+
+	// Interfaces may appear between the calls, so keep growing until the list fits
+	while( Result == ERROR_BUFFER_OVERFLOW )
+	{
+		Buffer.resize( Size );
+		Result = GetAdaptersAddresses( AF_UNSPEC, GAA_FLAG_SKIP_ANYCAST | GAA_FLAG_SKIP_MULTICAST | GAA_FLAG_SKIP_DNS_SERVER, NULL, reinterpret_cast< IP_ADAPTER_ADDRESSES* >( Buffer.data() ), &Size );
+	}
+
+	if( Result != NO_ERROR )
+		return Interfaces;
+
+	for( const IP_ADAPTER_ADDRESSES* pAdapter = reinterpret_cast< const IP_ADAPTER_ADDRESSES* >( Buffer.data() ); pAdapter; pAdapter = pAdapter->Next )
+	{
+		// Speeds are in bits per second, and all ones when unknown
+		const ULONG64      Speed     = std::min( pAdapter->TransmitLinkSpeed, pAdapter->ReceiveLinkSpeed );
+		xyNetworkInterface Interface = { .Name=xyUTF( pAdapter->FriendlyName ), .Addresses={ } };
+		Interface.MTU                = pAdapter->Mtu;
+		Interface.SpeedMbps          = ( Speed == ~ULONG64( 0 ) ) ? 0 : static_cast< uint32_t >( Speed / 1'000'000 );
+		Interface.Up                 = pAdapter->OperStatus != IfOperStatusDown;
+		Interface.Running            = pAdapter->OperStatus == IfOperStatusUp;
+		Interface.Loopback           = pAdapter->IfType == IF_TYPE_SOFTWARE_LOOPBACK;
+
+		for( const IP_ADAPTER_UNICAST_ADDRESS* pAddress = pAdapter->FirstUnicastAddress; pAddress; pAddress = pAddress->Next )
+			Interface.Addresses.push_back( xyMakeNetworkAddress( pAddress->Address.lpSockaddr, pAddress->OnLinkPrefixLength ) );
+
+		Interfaces.push_back( std::move( Interface ) );
+	}
+
+#else // XY_OS_WINDOWS
+
+	ifaddrs* pList = nullptr;
+	if( getifaddrs( &pList ) != 0 )
+		return Interfaces;
+
+	// There is one entry per address, plus one per interface for the link layer
+	for( const ifaddrs* pEntry = pList; pEntry; pEntry = pEntry->ifa_next )
+	{
+		auto It = std::find_if( Interfaces.begin(), Interfaces.end(), [ & ]( const xyNetworkInterface& rInterface ) { return rInterface.Name == pEntry->ifa_name; } );
+		if( It == Interfaces.end() )
+			It = Interfaces.insert( It, { .Name=pEntry->ifa_name, .Addresses={ } } );
+
+		It->Up       = ( pEntry->ifa_flags & IFF_UP ) != 0;
+		It->Running  = ( pEntry->ifa_flags & IFF_RUNNING ) != 0;
+		It->Loopback = ( pEntry->ifa_flags & IFF_LOOPBACK ) != 0;
+
+		if( pEntry->ifa_addr == nullptr )
+			continue;
+
+		if( pEntry->ifa_addr->sa_family == AF_INET || pEntry->ifa_addr->sa_family == AF_INET6 )
+		{
+			const bool     IPv6         = pEntry->ifa_addr->sa_family == AF_INET6;
+			const auto*    pMask        = pEntry->ifa_netmask ? reinterpret_cast< const uint8_t* >( IPv6 ? static_cast< const void* >( &reinterpret_cast< const sockaddr_in6* >( pEntry->ifa_netmask )->sin6_addr ) : static_cast< const void* >( &reinterpret_cast< const sockaddr_in* >( pEntry->ifa_netmask )->sin_addr ) ) : nullptr;
+			uint8_t        PrefixLength = 0;
+
+			for( size_t Index = 0; pMask && Index < ( IPv6 ? 16u : 4u ); ++Index )
+				PrefixLength += static_cast< uint8_t >( std::popcount( pMask[ Index ] ) );
+
+			It->Addresses.push_back( xyMakeNetworkAddress( pEntry->ifa_addr, PrefixLength ) );
+		}
+
+#if defined( XY_OS_MACOS ) || defined( XY_OS_IOS ) || defined( XY_OS_TVOS ) || defined( XY_OS_WATCHOS )
+
+		else if( pEntry->ifa_addr->sa_family == AF_LINK && pEntry->ifa_data )
+		{
+			const if_data* pData = static_cast< const if_data* >( pEntry->ifa_data );
+			It->MTU              = pData->ifi_mtu;
+			It->SpeedMbps        = static_cast< uint32_t >( pData->ifi_baudrate / 1'000'000 );
+		}
+
+#endif // XY_OS_MACOS || XY_OS_IOS || XY_OS_TVOS || XY_OS_WATCHOS
+
+	}
+
+	freeifaddrs( pList );
+
+#endif // !XY_OS_WINDOWS
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+	std::string SysfsRoot;
+	{
+		xySysfsCache&   rCache = xyGetSysfsCache();
+		std::lock_guard Lock( rCache.Mutex );
+
+		SysfsRoot = rCache.Root;
+	}
+
+	// Any socket will do for ethtool requests
+	const int Socket = socket( AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0 );
+
+	for( xyNetworkInterface& rInterface : Interfaces )
+	{
+		const std::string Path = SysfsRoot + "/sys/class/net/" + rInterface.Name + "/";
+		char              Buffer[ 32 ];
+
+		rInterface.MTU = static_cast< uint32_t >( std::strtoul( std::string( xyReadSmallFile( ( Path + "mtu" ).c_str(), Buffer ) ).c_str(), nullptr, 10 ) );
+
+		// Reading the speed fails while the link is down, and virtual devices report -1
+		rInterface.SpeedMbps = static_cast< uint32_t >( std::max( std::strtol( std::string( xyReadSmallFile( ( Path + "speed" ).c_str(), Buffer ) ).c_str(), nullptr, 10 ), 0l ) );
+
+		const std::string_view Duplex = xyReadSmallFile( ( Path + "duplex" ).c_str(), Buffer );
+		rInterface.Duplex             = ( Duplex == "full" ) ? xyDuplex::Full : ( Duplex == "half" ) ? xyDuplex::Half : xyDuplex::Unknown;
+
+		if( DIR* pDirectory = opendir( ( Path + "queues" ).c_str() ) )
+		{
+			while( dirent* pEntry = readdir( pDirectory ) )
+			{
+				rInterface.RxQueues += std::string_view( pEntry->d_name ).starts_with( "rx-" );
+				rInterface.TxQueues += std::string_view( pEntry->d_name ).starts_with( "tx-" );
+			}
+
+			closedir( pDirectory );
+		}
+
+		if( Socket < 0 )
+			continue;
+
+		ifreq Request = { };
+		std::strncpy( Request.ifr_name, rInterface.Name.c_str(), IFNAMSIZ - 1 );
+
+		auto Query = [ & ]( uint32_t Command )
+		{
+			ethtool_value Value = { .cmd=Command, .data=0 };
+			Request.ifr_data    = reinterpret_cast< char* >( &Value );
+
+			return ioctl( Socket, SIOCETHTOOL, &Request ) == 0 && Value.data;
+		};
+
+		if( Query( ETHTOOL_GRXCSUM ) ) rInterface.Offloads |= XY_NETWORK_OFFLOAD_RX_CHECKSUM;
+		if( Query( ETHTOOL_GTXCSUM ) ) rInterface.Offloads |= XY_NETWORK_OFFLOAD_TX_CHECKSUM;
+		if( Query( ETHTOOL_GTSO ) )    rInterface.Offloads |= XY_NETWORK_OFFLOAD_TSO;
+		if( Query( ETHTOOL_GGSO ) )    rInterface.Offloads |= XY_NETWORK_OFFLOAD_GSO;
+		if( Query( ETHTOOL_GGRO ) )    rInterface.Offloads |= XY_NETWORK_OFFLOAD_GRO;
+	}
+
+	if( Socket >= 0 )
+		close( Socket );
+
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+	return Interfaces;
+
+} // xyGetNetworkInterfaces
+
+//////////////////////////////////////////////////////////////////////////
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+struct xyProcessStatsCache
+{
+	struct ThreadFiles
+	{
+		int Stat      = -1;
+		int Schedstat = -1;
+		int Status    = -1;
+
+		void Close( void ) const;
+
+	}; // ThreadFiles
+
+	~xyProcessStatsCache( void );
+
+	void                    Prune( void );
+	static std::string_view Read ( int File, std::span< char > Buffer );
+	static uint64_t         Field( std::string_view Text, std::string_view Name );
+
+	std::mutex                                  Mutex;
+	int                                         Statm       = -2; // Not yet opened
+	int                                         SmapsRollup = -2;
+	std::unordered_map< uint32_t, ThreadFiles > Threads;
+	size_t                                      PruneAt     = 16; // Threads that exit without being queried again are only noticed when the cache is pruned
+
+}; // xyProcessStatsCache
+
+//////////////////////////////////////////////////////////////////////////
+
+static xyProcessStatsCache& xyGetProcessStatsCache( void )
+{
+	static xyProcessStatsCache ProcessStatsCache;
+	return ProcessStatsCache;
+
+} // xyGetProcessStatsCache
+
+//////////////////////////////////////////////////////////////////////////
+
+xyProcessStatsCache::~xyProcessStatsCache( void )
+{
+	for( int File : { Statm, SmapsRollup } )
+		if( File >= 0 ) close( File );
+
+	for( const auto& [ ThreadID, rFiles ] : Threads )
+		rFiles.Close();
+
+} // ~xyProcessStatsCache
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyProcessStatsCache::ThreadFiles::Close( void ) const
+{
+	for( int File : { Stat, Schedstat, Status } )
+		if( File >= 0 ) close( File );
+
+} // Close
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyProcessStatsCache::Prune( void )
+{
+	if( Threads.size() < PruneAt )
+		return;
+
+	// The stat file stays bound to the thread it was opened for, so reading it fails once that thread has exited, even if the ID has been reused
+	char Byte;
+	std::erase_if( Threads, [ & ]( const auto& rEntry )
+	{
+		if( pread( rEntry.second.Stat, &Byte, 1, 0 ) > 0 )
+			return false;
+
+		rEntry.second.Close();
+		return true;
+	} );
+
+	// Wait for the cache to double again, so that pruning costs a constant amount per query on average
+	PruneAt = std::max< size_t >( Threads.size() * 2, 16 );
+
+} // Prune
+
+//////////////////////////////////////////////////////////////////////////
+
+std::string_view xyProcessStatsCache::Read( int File, std::span< char > Buffer )
+{
+	if( File < 0 )
+		return { };
+
+	// Proc files are regenerated whenever they are read from the start
+	const ssize_t Size = pread( File, Buffer.data(), Buffer.size() - 1, 0 );
+	if( Size <= 0 )
+		return { };
+
+	Buffer[ Size ] = '\0';
+
+	return std::string_view( Buffer.data(), static_cast< size_t >( Size ) );
+
+} // Read
+
+//////////////////////////////////////////////////////////////////////////
+
+uint64_t xyProcessStatsCache::Field( std::string_view Text, std::string_view Name )
+{
+	// Lines look like "Name:    123 kB"
+	const size_t Position = Text.find( Name );
+	if( Position == std::string_view::npos || ( Position > 0 && Text[ Position - 1 ] != '\n' ) )
+		return 0;
+
+	return std::strtoull( Text.data() + Position + Name.size(), nullptr, 10 );
+
+} // Field
+
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+//////////////////////////////////////////////////////////////////////////
+
+#if !defined( XY_OS_WINDOWS )
+
+template< typename Stats >
+static void xyApplyResourceUsage( const rusage& rUsage, Stats& rStats )
+{
+	rStats.UserTime            = std::chrono::seconds( rUsage.ru_utime.tv_sec ) + std::chrono::microseconds( rUsage.ru_utime.tv_usec );
+	rStats.SystemTime          = std::chrono::seconds( rUsage.ru_stime.tv_sec ) + std::chrono::microseconds( rUsage.ru_stime.tv_usec );
+	rStats.MajorFaults         = static_cast< uint64_t >( rUsage.ru_majflt );
+	rStats.MinorFaults         = static_cast< uint64_t >( rUsage.ru_minflt );
+	rStats.VoluntarySwitches   = static_cast< uint64_t >( rUsage.ru_nvcsw );
+	rStats.InvoluntarySwitches = static_cast< uint64_t >( rUsage.ru_nivcsw );
+	rStats.Valid               = true;
+
+} // xyApplyResourceUsage
+
+#endif // !XY_OS_WINDOWS
+
+//////////////////////////////////////////////////////////////////////////
+
+xyProcessStats xyGetProcessStats( uint32_t Flags )
+{
+	xyProcessStats Stats;
+
+#if defined( XY_OS_WINDOWS )
+
+	const HANDLE Process = GetCurrentProcess();
+
+	// Process times are in units of 100 nanoseconds
+	FILETIME CreationTime, ExitTime, KernelTime, UserTime;
+	if( GetProcessTimes( Process, &CreationTime, &ExitTime, &KernelTime, &UserTime ) )
+	{
+		Stats.UserTime   = std::chrono::nanoseconds( ( ( static_cast< uint64_t >( UserTime.dwHighDateTime ) << 32 ) | UserTime.dwLowDateTime ) * 100 );
+		Stats.SystemTime = std::chrono::nanoseconds( ( ( static_cast< uint64_t >( KernelTime.dwHighDateTime ) << 32 ) | KernelTime.dwLowDateTime ) * 100 );
+		Stats.Valid      = true;
+	}
+
+	PROCESS_MEMORY_COUNTERS Counters = { .cb=sizeof( PROCESS_MEMORY_COUNTERS ) };
+	if( GetProcessMemoryInfo( Process, &Counters, sizeof( Counters ) ) )
+	{
+		Stats.ResidentBytes = Counters.WorkingSetSize;
+		Stats.MinorFaults   = Counters.PageFaultCount;
+	}
+
+	if( DWORD Handles; ( Flags & XY_PROCESS_STATS_OPEN_FILES ) && GetProcessHandleCount( Process, &Handles ) )
+		Stats.OpenFiles = Handles;
+
+#else // XY_OS_WINDOWS
+
+	// One system call with microsecond precision, where /proc/self/stat only counts clock ticks
+	if( rusage Usage; getrusage( RUSAGE_SELF, &Usage ) == 0 )
+		xyApplyResourceUsage( Usage, Stats );
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+	xyProcessStatsCache& rCache = xyGetProcessStatsCache();
+	char                 Buffer[ 1024 ];
+
+	{
+		std::lock_guard Lock( rCache.Mutex );
+		rCache.Prune();
+
+		if( rCache.Statm == -2 )
+			rCache.Statm = open( "/proc/self/statm", O_RDONLY | O_CLOEXEC );
+
+		// The second field is the number of resident pages
+		if( std::string_view Statm = xyProcessStatsCache::Read( rCache.Statm, Buffer ); !Statm.empty() )
+		{
+			char* pEnd;
+			std::strtoull( Statm.data(), &pEnd, 10 );
+			Stats.ResidentBytes = std::strtoull( pEnd, nullptr, 10 ) * static_cast< uint64_t >( sysconf( _SC_PAGESIZE ) );
+		}
+
+		if( Flags & XY_PROCESS_STATS_PSS )
+		{
+			if( rCache.SmapsRollup == -2 )
+				rCache.SmapsRollup = open( "/proc/self/smaps_rollup", O_RDONLY | O_CLOEXEC );
+
+			Stats.ProportionalBytes = xyProcessStatsCache::Field( xyProcessStatsCache::Read( rCache.SmapsRollup, Buffer ), "Pss:" ) * 1024;
+		}
+	}
+
+	if( Flags & XY_PROCESS_STATS_OPEN_FILES )
+	{
+		if( DIR* pDirectory = opendir( "/proc/self/fd" ) )
+		{
+			while( dirent* pEntry = readdir( pDirectory ) )
+				Stats.OpenFiles += pEntry->d_name[ 0 ] != '.';
+
+			// Leave out the descriptor of the directory itself
+			Stats.OpenFiles -= Stats.OpenFiles > 0;
+			closedir( pDirectory );
+		}
+	}
+
+#elif defined( XY_OS_MACOS ) || defined( XY_OS_IOS ) || defined( XY_OS_TVOS ) || defined( XY_OS_WATCHOS ) // XY_OS_LINUX || XY_OS_ANDROID
+
+	mach_task_basic_info_data_t Info;
+	mach_msg_type_number_t      Count = MACH_TASK_BASIC_INFO_COUNT;
+	if( task_info( mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast< task_info_t >( &Info ), &Count ) == KERN_SUCCESS )
+		Stats.ResidentBytes = Info.resident_size;
+
+	( void )Flags;
+
+#endif // XY_OS_MACOS || XY_OS_IOS || XY_OS_TVOS || XY_OS_WATCHOS
+
+#endif // !XY_OS_WINDOWS
+
+	return Stats;
+
+} // xyGetProcessStats
+
+//////////////////////////////////////////////////////////////////////////
+
+xyThreadStats xyGetThreadStats( void )
+{
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+	xyThreadStats Stats = xyGetThreadStats( xyGetThreadID() );
+
+	// More precise than the proc files for everything but the run delay
+	if( rusage Usage; getrusage( RUSAGE_THREAD, &Usage ) == 0 )
+		xyApplyResourceUsage( Usage, Stats );
+
+	return Stats;
+
+#else // XY_OS_LINUX || XY_OS_ANDROID
+
+	return xyGetThreadStats( xyGetThreadID() );
+
+#endif // !XY_OS_LINUX && !XY_OS_ANDROID
+
+} // xyGetThreadStats
+
+//////////////////////////////////////////////////////////////////////////
+
+xyThreadStats xyGetThreadStats( uint32_t ThreadID )
+{
+	xyThreadStats Stats = { .ThreadID=ThreadID };
+
+#if defined( XY_OS_WINDOWS )
+
+	if( HANDLE Thread = OpenThread( THREAD_QUERY_LIMITED_INFORMATION, FALSE, ThreadID ) )
+	{
+		FILETIME CreationTime, ExitTime, KernelTime, UserTime;
+		if( GetThreadTimes( Thread, &CreationTime, &ExitTime, &KernelTime, &UserTime ) )
+		{
+			Stats.UserTime   = std::chrono::nanoseconds( ( ( static_cast< uint64_t >( UserTime.dwHighDateTime ) << 32 ) | UserTime.dwLowDateTime ) * 100 );
+			Stats.SystemTime = std::chrono::nanoseconds( ( ( static_cast< uint64_t >( KernelTime.dwHighDateTime ) << 32 ) | KernelTime.dwLowDateTime ) * 100 );
+			Stats.Valid      = true;
+		}
+
+		CloseHandle( Thread );
+	}
+
+#elif defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID ) // XY_OS_WINDOWS
+
+	xyProcessStatsCache& rCache = xyGetProcessStatsCache();
+	std::lock_guard      Lock( rCache.Mutex );
+
+	rCache.Prune();
+
+	auto [ It, Inserted ] = rCache.Threads.try_emplace( ThreadID );
+	if( Inserted )
+	{
+		auto Open = [ ThreadID ]( const char* pName )
+		{
+			char Path[ 64 ];
+			std::snprintf( Path, sizeof( Path ), "/proc/self/task/%u/%s", ThreadID, pName );
+			return open( Path, O_RDONLY | O_CLOEXEC );
+		};
+
+		It->second = { .Stat=Open( "stat" ), .Schedstat=Open( "schedstat" ), .Status=Open( "status" ) };
+	}
+
+	char             Buffer[ 2048 ];
+	std::string_view Stat = xyProcessStatsCache::Read( It->second.Stat, Buffer );
+
+	// Reads fail once the thread has exited, and the ID may later be reused by another thread
+	if( Stat.empty() )
+	{
+		It->second.Close();
+		rCache.Threads.erase( It );
+		return Stats;
+	}
+
+	// The minor and major faults are the 10th and 12th fields, and the user and system times are the 14th and 15th. Count from the end of the command name, which may contain spaces.
+	uint64_t Fields[ 15 ] = { };
+	if( const size_t Close = Stat.rfind( ')' ); Close != std::string_view::npos && Close + 3 <= Stat.size() )
+	{
+		// Skip past ") S", the single character state being the third field
+		const char* pField = Stat.data() + Close + 3;
+		for( size_t Index = 3; Index < std::size( Fields ); ++Index )
+		{
+			char* pEnd;
+			Fields[ Index ] = std::strtoull( pField, &pEnd, 10 );
+			pField          = pEnd;
+		}
+	}
+
+	const uint64_t UserTicks   = Fields[ 13 ];
+	const uint64_t SystemTicks = Fields[ 14 ];
+	Stats.MinorFaults          = Fields[ 9 ];
+	Stats.MajorFaults          = Fields[ 11 ];
+
+	// Schedstat holds the time spent running and waiting in nanoseconds. The tick-based times are only used to split the running time into user and system time, like the kernel does.
+	if( std::string_view Schedstat = xyProcessStatsCache::Read( It->second.Schedstat, Buffer ); !Schedstat.empty() )
+	{
+		char*          pEnd;
+		const uint64_t RunTime = std::strtoull( Schedstat.data(), &pEnd, 10 );
+		const uint64_t Ticks   = UserTicks + SystemTicks;
+
+		Stats.UserTime   = std::chrono::nanoseconds( Ticks ? static_cast< uint64_t >( static_cast< double >( RunTime ) * UserTicks / Ticks ) : RunTime );
+		Stats.SystemTime = std::chrono::nanoseconds( RunTime ) - Stats.UserTime;
+		Stats.RunDelay   = std::chrono::nanoseconds( std::strtoull( pEnd, nullptr, 10 ) );
+	}
+	else
+	{
+		const uint64_t TicksPerSecond = static_cast< uint64_t >( sysconf( _SC_CLK_TCK ) );
+		Stats.UserTime                = std::chrono::nanoseconds( UserTicks * 1'000'000'000 / TicksPerSecond );
+		Stats.SystemTime              = std::chrono::nanoseconds( SystemTicks * 1'000'000'000 / TicksPerSecond );
+	}
+
+	if( std::string_view Status = xyProcessStatsCache::Read( It->second.Status, Buffer ); !Status.empty() )
+	{
+		Stats.VoluntarySwitches   = xyProcessStatsCache::Field( Status, "voluntary_ctxt_switches:" );
+		Stats.InvoluntarySwitches = xyProcessStatsCache::Field( Status, "nonvoluntary_ctxt_switches:" );
+	}
+
+	Stats.Valid = true;
+
+#elif defined( XY_OS_MACOS ) || defined( XY_OS_IOS ) || defined( XY_OS_TVOS ) || defined( XY_OS_WATCHOS ) // XY_OS_LINUX || XY_OS_ANDROID
+
+	// Thread IDs are the Mach ports of the threads
+	thread_basic_info_data_t Info;
+	mach_msg_type_number_t   Count = THREAD_BASIC_INFO_COUNT;
+	if( thread_info( static_cast< thread_act_t >( ThreadID ), THREAD_BASIC_INFO, reinterpret_cast< thread_info_t >( &Info ), &Count ) == KERN_SUCCESS )
+	{
+		Stats.UserTime   = std::chrono::seconds( Info.user_time.seconds ) + std::chrono::microseconds( Info.user_time.microseconds );
+		Stats.SystemTime = std::chrono::seconds( Info.system_time.seconds ) + std::chrono::microseconds( Info.system_time.microseconds );
+		Stats.Valid      = true;
+	}
+
+#endif // XY_OS_MACOS || XY_OS_IOS || XY_OS_TVOS || XY_OS_WATCHOS
+
+	return Stats;
+
+} // xyGetThreadStats
+
+//////////////////////////////////////////////////////////////////////////
+
+uint32_t xyGetThreadID( void )
+{
+
+#if defined( XY_OS_WINDOWS )
+	return GetCurrentThreadId();
+#elif defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID ) // XY_OS_WINDOWS
+	return static_cast< uint32_t >( syscall( SYS_gettid ) );
+#elif defined( XY_OS_MACOS ) || defined( XY_OS_IOS ) || defined( XY_OS_TVOS ) || defined( XY_OS_WATCHOS ) // XY_OS_LINUX || XY_OS_ANDROID
+	return pthread_mach_thread_np( pthread_self() );
+#else // XY_OS_MACOS || XY_OS_IOS || XY_OS_TVOS || XY_OS_WATCHOS
+	return 0;
+#endif // !XY_OS_WINDOWS && !XY_OS_LINUX && !XY_OS_ANDROID && !XY_OS_MACOS && !XY_OS_IOS && !XY_OS_TVOS && !XY_OS_WATCHOS
+
+} // xyGetThreadID
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyWatchdogThreadImpl
+{
+	~xyWatchdogThreadImpl( void );
+
+	std::atomic< uint32_t >               Beat            = 1;
+	std::atomic< uint32_t >*              pBeat           = &Beat; // Points elsewhere for threads that are pinged rather than beating on their own
+	xyInlineString< 31 >                  Name;
+	uint32_t                              ThreadID        = 0;
+	std::chrono::nanoseconds              Deadline        = { };
+	std::chrono::steady_clock::time_point LastBeat;
+	bool                                  Stalled         = false;
+	bool                                  Pinged          = false; // Whether the watchdog has to ask for each heartbeat
+	bool                                  PingOutstanding = false;
+
+}; // xyWatchdogThreadImpl
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyWatchdog
+{
+	~xyWatchdog( void ) { Stop(); }
+
+	void Run  ( void );
+	void Stop ( void );
+	void Ping ( xyWatchdogThreadImpl& rThread );
+	void Capture( uint32_t ThreadID, xySmallVector< uintptr_t, 32 >& rFrames );
+
+	std::mutex                            Mutex;
+	std::condition_variable               Condition;
+	std::vector< xyWatchdogThreadImpl* >  Threads;
+	std::thread                           Thread;
+	xyWatchdogCallback                    Callback = nullptr;
+	void*                                 pUserData = nullptr;
+	std::chrono::milliseconds             CheckInterval = { };
+	bool                                  Stopping = false;
+
+}; // xyWatchdog
+
+//////////////////////////////////////////////////////////////////////////
+
+static xyWatchdog& xyGetWatchdog( void )
+{
+	static xyWatchdog Watchdog;
+	return Watchdog;
+
+} // xyGetWatchdog
+
+//////////////////////////////////////////////////////////////////////////
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+struct xyWatchdogCapture
+{
+	std::atomic< uint32_t > Target    = 0;     // The thread that is asked for its stack. Claimed by the signal handler by setting it to zero.
+	std::atomic< bool >     Done      = false;
+	bool                    Abandoned = false; // Whether the watchdog gave up on a handler that had claimed the capture. Only used by the watchdog thread.
+	uint32_t                Count     = 0;
+	uintptr_t               Frames[ 32 ];
+
+}; // xyWatchdogCapture
+
+static xyWatchdogCapture xyWatchdogCaptureData;
+
+//////////////////////////////////////////////////////////////////////////
+
+static void xyWatchdogSignalHandler( int /*Signal*/, siginfo_t* /*pInfo*/, void* /*pContext*/ )
+{
+	const int SavedErrno = errno;
+	uint32_t  ThreadID   = static_cast< uint32_t >( syscall( SYS_gettid ) );
+
+	// A handler that runs after the watchdog has given up on it must not touch the frames, which may already be in use for another thread
+	if( xyWatchdogCaptureData.Target.compare_exchange_strong( ThreadID, 0, std::memory_order_acquire ) )
+	{
+		// The first two frames are this handler and the signal trampoline
+		struct Walk { uint32_t Skip; } State = { .Skip=2 };
+
+		xyWatchdogCaptureData.Count = 0;
+		_Unwind_Backtrace( []( _Unwind_Context* pContext, void* pData ) -> _Unwind_Reason_Code
+		{
+			Walk&           rState = *static_cast< Walk* >( pData );
+			const uintptr_t IP     = _Unwind_GetIP( pContext );
+
+			if( rState.Skip )                                                                     --rState.Skip;
+			else if( IP && xyWatchdogCaptureData.Count < std::size( xyWatchdogCaptureData.Frames ) ) xyWatchdogCaptureData.Frames[ xyWatchdogCaptureData.Count++ ] = IP;
+			else if( IP )                                                                         return _URC_END_OF_STACK;
+
+			return _URC_NO_REASON;
+
+		}, &State );
+
+		xyWatchdogCaptureData.Done.store( true, std::memory_order_release );
+	}
+
+	errno = SavedErrno;
+
+} // xyWatchdogSignalHandler
+
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+//////////////////////////////////////////////////////////////////////////
+
+xyWatchdogThreadImpl::~xyWatchdogThreadImpl( void )
+{
+	xyWatchdog&     rWatchdog = xyGetWatchdog();
+	std::lock_guard Lock( rWatchdog.Mutex );
+
+	std::erase( rWatchdog.Threads, this );
+
+} // ~xyWatchdogThreadImpl
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyWatchdog::Capture( uint32_t ThreadID, xySmallVector< uintptr_t, 32 >& rFrames )
+{
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+	xyWatchdogCapture& rCapture = xyWatchdogCaptureData;
+
+	// A handler that was given up on while it was walking its stack may still write to the frames
+	if( rCapture.Abandoned && !rCapture.Done.load( std::memory_order_acquire ) )
+		return;
+
+	rCapture.Abandoned = false;
+	rCapture.Done.store( false, std::memory_order_relaxed );
+	rCapture.Target.store( ThreadID, std::memory_order_release );
+
+	if( syscall( SYS_tgkill, getpid(), ThreadID, XY_WATCHDOG_SIGNAL ) != 0 )
+	{
+		rCapture.Target.store( 0, std::memory_order_relaxed );
+		return;
+	}
+
+	// A thread in uninterruptible sleep will not run the handler until it wakes up
+	const auto Timeout = std::chrono::steady_clock::now() + std::chrono::milliseconds( 100 );
+	while( !rCapture.Done.load( std::memory_order_acquire ) && std::chrono::steady_clock::now() < Timeout )
+		std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+
+	// If the handler has not claimed the capture yet, withdraw it. Otherwise it is running and should finish shortly.
+	if( !rCapture.Done.load( std::memory_order_acquire ) && rCapture.Target.exchange( 0, std::memory_order_acquire ) == ThreadID )
+		return;
+
+	// The unwinder is not async-signal-safe. A thread that stalled while holding the loader lock deadlocks in the handler and never finishes.
+	const auto WalkTimeout = std::chrono::steady_clock::now() + std::chrono::milliseconds( 100 );
+	while( !rCapture.Done.load( std::memory_order_acquire ) && std::chrono::steady_clock::now() < WalkTimeout )
+		std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+
+	if( !rCapture.Done.load( std::memory_order_acquire ) )
+	{
+		rCapture.Abandoned = true;
+		return;
+	}
+
+	for( uint32_t Index = 0; Index < rCapture.Count; ++Index )
+		rFrames.push_back( rCapture.Frames[ Index ] );
+
+#else // XY_OS_LINUX || XY_OS_ANDROID
+
+	( void )ThreadID;
+	( void )rFrames;
+
+#endif // !XY_OS_LINUX && !XY_OS_ANDROID
+
+} // Capture
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyWatchdog::Ping( xyWatchdogThreadImpl& rThread )
+{
+
+#if defined( XY_OS_ANDROID )
+
+	// A null runnable only makes the looper beat, which tells that it is still servicing the pipe
+	xyRunnable* pRunnable = nullptr;
+	rThread.PingOutstanding = write( xyGetContext().pPlatformImpl->JavaThreadPipe[ 1 ], &pRunnable, sizeof( pRunnable ) ) == sizeof( pRunnable );
+
+#else // XY_OS_ANDROID
+
+	( void )rThread;
+
+#endif // !XY_OS_ANDROID
+
+} // Ping
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyWatchdog::Run( void )
+{
+	std::unique_lock Lock( Mutex );
+	std::vector< xyWatchdogStall > Stalls;
+
+	while( !Condition.wait_for( Lock, CheckInterval, [ this ]{ return Stopping; } ) )
+	{
+		const auto Now = std::chrono::steady_clock::now();
+
+		for( xyWatchdogThreadImpl* pThread : Threads )
+		{
+			if( pThread->pBeat->exchange( 0, std::memory_order_relaxed ) )
+			{
+				if( pThread->Stalled )
+					Stalls.push_back( { .Name=pThread->Name, .ThreadID=pThread->ThreadID, .Duration=Now - pThread->LastBeat, .Recovered=true, .Frames={ } } );
+
+				pThread->LastBeat        = Now;
+				pThread->Stalled         = false;
+				pThread->PingOutstanding = false;
+			}
+			else if( !pThread->Stalled && Now - pThread->LastBeat > pThread->Deadline )
+			{
+				Stalls.push_back( { .Name=pThread->Name, .ThreadID=pThread->ThreadID, .Duration=Now - pThread->LastBeat, .Recovered=false, .Frames={ } } );
+
+				pThread->Stalled = true;
+			}
+
+			if( pThread->Pinged && !pThread->PingOutstanding )
+				Ping( *pThread );
+		}
+
+		if( Stalls.empty() )
+			continue;
+
+		// Threads may unregister from within the callback. Capturing waits on the stalled threads, which must not hold up others from registering or unregistering either.
+		Lock.unlock();
+
+		for( xyWatchdogStall& rStall : Stalls )
+		{
+			if( !rStall.Recovered )
+				Capture( rStall.ThreadID, rStall.Frames );
+		}
+
+		for( const xyWatchdogStall& rStall : Stalls )
+			Callback( rStall, pUserData );
+
+		Stalls.clear();
+		Lock.lock();
+	}
+
+} // Run
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyWatchdog::Stop( void )
+{
+	{
+		std::lock_guard Lock( Mutex );
+		Stopping = true;
+	}
+
+	Condition.notify_all();
+
+	if( Thread.joinable() )
+		Thread.join();
+
+} // Stop
+
+//////////////////////////////////////////////////////////////////////////
+
+static xyWatchdogHeartbeat xyRegisterWatchdog( std::string_view Name, uint32_t ThreadID, std::chrono::milliseconds Deadline, std::atomic< uint32_t >* pBeat, bool Pinged )
+{
+	auto pImpl      = std::make_shared< xyWatchdogThreadImpl >();
+	pImpl->Name     = Name.substr( 0, decltype( pImpl->Name )::capacity() );
+	pImpl->ThreadID = ThreadID;
+	pImpl->Deadline = Deadline;
+	pImpl->LastBeat = std::chrono::steady_clock::now();
+	pImpl->Pinged   = Pinged;
+
+	if( pBeat )
+		pImpl->pBeat = pBeat;
+
+	{
+		xyWatchdog&     rWatchdog = xyGetWatchdog();
+		std::lock_guard Lock( rWatchdog.Mutex );
+
+		rWatchdog.Threads.push_back( pImpl.get() );
+	}
+
+	return { .pImpl=pImpl, .pBeat=pImpl->pBeat };
+
+} // xyRegisterWatchdog
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyStartWatchdog( xyWatchdogCallback Callback, void* pUserData, std::chrono::milliseconds CheckInterval )
+{
+	xyWatchdog&     rWatchdog = xyGetWatchdog();
+	std::lock_guard Lock( rWatchdog.Mutex );
+
+	if( rWatchdog.Thread.joinable() || Callback == nullptr )
+		return false;
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+	// The handler stays installed for good, since a late signal would otherwise terminate the process
+	static std::once_flag HandlerFlag;
+	std::call_once( HandlerFlag, []
+	{
+		struct sigaction Action = { };
+		Action.sa_sigaction     = xyWatchdogSignalHandler;
+		Action.sa_flags         = SA_SIGINFO | SA_RESTART | SA_ONSTACK;
+		sigemptyset( &Action.sa_mask );
+		sigaction( XY_WATCHDOG_SIGNAL, &Action, nullptr );
+
+		// The unwinder loads and caches what it needs on first use, which must not happen inside the signal handler
+		_Unwind_Backtrace( []( _Unwind_Context*, void* ) { return _URC_END_OF_STACK; }, nullptr );
+	} );
+
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+	rWatchdog.Callback      = Callback;
+	rWatchdog.pUserData     = pUserData;
+	rWatchdog.CheckInterval = CheckInterval;
+	rWatchdog.Stopping      = false;
+
+	// Time spent stopped does not count against anyone
+	for( xyWatchdogThreadImpl* pThread : rWatchdog.Threads )
+		pThread->LastBeat = std::chrono::steady_clock::now();
+
+	rWatchdog.Thread = std::thread( &xyWatchdog::Run, &rWatchdog );
+
+	return true;
+
+} // xyStartWatchdog
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyStopWatchdog( void )
+{
+	xyGetWatchdog().Stop();
+
+} // xyStopWatchdog
+
+//////////////////////////////////////////////////////////////////////////
+
+xyWatchdogHeartbeat xyRegisterWatchdogThread( std::string_view Name, std::chrono::milliseconds Deadline )
+{
+	return xyRegisterWatchdog( Name, xyGetThreadID(), Deadline, nullptr, false );
+
+} // xyRegisterWatchdogThread
+
+//////////////////////////////////////////////////////////////////////////
+
+#if defined( XY_OS_ANDROID )
+
+xyWatchdogHeartbeat xyWatchJavaThread( std::chrono::milliseconds Deadline )
+{
+	xyPlatformImpl& rPlatform = *xyGetContext().pPlatformImpl;
+
+	return xyRegisterWatchdog( "Java", rPlatform.JavaThreadID, Deadline, &rPlatform.JavaThreadBeat, true );
+
+} // xyWatchJavaThread
+
+#endif // XY_OS_ANDROID
+
+//////////////////////////////////////////////////////////////////////////
+
+template< typename Emit >
+static void xyEnumerateDisplayAdapters( Emit&& rrEmit )
+{
+
+#if defined( XY_OS_WINDOWS )
+
+	auto EnumProc = []( HMONITOR MonitorHandle, HDC /*DeviceContextHandle*/, LPRECT /*pRect*/, LPARAM UserData ) -> BOOL
+	{
+		auto& rEmit = *reinterpret_cast< std::remove_reference_t< Emit >* >( UserData );
+
+		MONITORINFOEXA Info = { sizeof( MONITORINFOEXA ) };
+		if( GetMonitorInfoA( MonitorHandle, &Info ) )
+		{
+			const xyRect    FullRect      = { .Left=Info.rcMonitor.left, .Top=Info.rcMonitor.top, .Right=Info.rcMonitor.right, .Bottom=Info.rcMonitor.bottom };
+			const xyRect    WorkRect      = { .Left=Info.rcWork   .left, .Top=Info.rcWork   .top, .Right=Info.rcWork   .right, .Bottom=Info.rcWork   .bottom };
+			DISPLAY_DEVICEA DisplayDevice = { .cb=sizeof( DISPLAY_DEVICEA ) };
+
+			// Prefer the name of the display device over the name of the monitor
+			if( EnumDisplayDevicesA( Info.szDevice, 0, &DisplayDevice, 0 ) ) rEmit( DisplayDevice.DeviceString, FullRect, WorkRect );
+			else                                                             rEmit( Info.szDevice,               FullRect, WorkRect );
+		}
+
+		// Always continue
+		return TRUE;
+	};
+
+	EnumDisplayMonitors( NULL, NULL, EnumProc, reinterpret_cast< LPARAM >( &rrEmit ) );
+
+#elif defined( XY_OS_MACOS ) // XY_OS_WINDOWS
+
+	for( NSScreen* pScreen in [ NSScreen screens ] )
+	{
+		const xyRect FullRect = { .Left=NSMinX( pScreen.frame ),        .Top=NSMinY( pScreen.frame ),        .Right=NSMaxX( pScreen.frame ),        .Bottom=NSMaxY( pScreen.frame ) };
+		const xyRect WorkRect = { .Left=NSMinX( pScreen.visibleFrame ), .Top=NSMinY( pScreen.visibleFrame ), .Right=NSMaxX( pScreen.visibleFrame ), .Bottom=NSMaxY( pScreen.visibleFrame ) };
+
+		rrEmit( [ [ pScreen localizedName ] UTF8String ], FullRect, WorkRect );
+	}
+
+#elif defined( XY_OS_ANDROID ) // XY_OS_MACOS
+
+	JNIEnv*           pJNI   = xyGetJNIEnv();
+	const xyJNICache& rCache = xyGetJNICache();
+
+	pJNI->PushLocalFrame( 4 );
+
+	jobjectArray Displays     = rCache.DisplayManager ? ( jobjectArray )pJNI->CallObjectMethod( rCache.DisplayManager, rCache.DisplayManagerGetDisplays ) : nullptr;
+	jsize        DisplayCount = Displays ? pJNI->GetArrayLength( Displays ) : 0;
+
+	for( jsize i = 0; i < DisplayCount; ++i )
+	{
+		// The thread stays attached, so local references have to be released explicitly or they would pile up
+		pJNI->PushLocalFrame( 8 );
+
+		jobject     Display  = pJNI->GetObjectArrayElement( Displays, i );
+		jstring     Name     = ( jstring )pJNI->CallObjectMethod( Display, rCache.DisplayGetName );
+		const char* pNameUTF = pJNI->GetStringUTFChars( Name, nullptr );
+		jobject     Bounds   = pJNI->AllocObject( rCache.RectClass );
+		xyRect      FullRect;
+		xyRect      WorkRect;
+
+		// NOTE: "getRectSize" is deprecated as of SDK v30.
+		// The documentation suggests using WindowMetric#getBounds(), but there seems to be no way of obtaining the bounds of a specific Display object.
+		pJNI->CallVoidMethod( Display, rCache.DisplayGetRectSize, Bounds );
+		FullRect.Left   = pJNI->GetIntField( Bounds, rCache.RectLeft );
+		FullRect.Top    = pJNI->GetIntField( Bounds, rCache.RectTop );
+		FullRect.Right  = pJNI->GetIntField( Bounds, rCache.RectRight );
+		FullRect.Bottom = pJNI->GetIntField( Bounds, rCache.RectBottom );
+
+		// getCutout was added in API level 28
+		jobject DisplayCutout = rCache.DisplayGetCutout ? pJNI->CallObjectMethod( Display, rCache.DisplayGetCutout ) : nullptr;
+		if( DisplayCutout )
+		{
+			WorkRect.Left   = pJNI->CallIntMethod( DisplayCutout, rCache.DisplayCutoutGetSafeInsetLeft );
+			WorkRect.Top    = pJNI->CallIntMethod( DisplayCutout, rCache.DisplayCutoutGetSafeInsetTop );
+			WorkRect.Right  = pJNI->CallIntMethod( DisplayCutout, rCache.DisplayCutoutGetSafeInsetRight );
+			WorkRect.Bottom = pJNI->CallIntMethod( DisplayCutout, rCache.DisplayCutoutGetSafeInsetBottom );
+		}
+		else
+		{
+			// TODO: There are other ways to obtain the safe area
+			WorkRect = FullRect;
+		}
+
+		rrEmit( pNameUTF, FullRect, WorkRect );
+
+		pJNI->ReleaseStringUTFChars( Name, pNameUTF );
+		pJNI->PopLocalFrame( nullptr );
+	}
+
+	pJNI->PopLocalFrame( nullptr );
+
+#elif defined( XY_OS_IOS ) // XY_OS_ANDROID
+	
+	NSArray< UIScreen* >* pScreens = [ UIScreen screens ];
+
+	for( UIScreen* pScreen in pScreens )
+	{
+		NSString*    pScreenName = ( pScreen == [ UIScreen mainScreen ] ) ? @"Main Display" : [ NSString stringWithFormat:@"External Display #%d", [ pScreens indexOfObject:pScreen ] ];
+		CGRect       Bounds      = [ pScreen bounds ];
+		const xyRect FullRect    = { .Left=CGRectGetMinX( Bounds ), .Top=CGRectGetMinY( Bounds ), .Right=CGRectGetMaxX( Bounds ), .Bottom=CGRectGetMaxY( Bounds ) };
+
+		// TODO: Obtain the safe area
+
+		rrEmit( [ pScreenName UTF8String ], FullRect, xyRect{ } );
+	}
+
+#else // XY_OS_IOS
+
+	( void )rrEmit;
+
+#endif // !XY_OS_WINDOWS && !XY_OS_MACOS && !XY_OS_ANDROID && !XY_OS_IOS
+
+} // xyEnumerateDisplayAdapters
+
+//////////////////////////////////////////////////////////////////////////
+
+std::vector< xyDisplayAdapter > xyGetDisplayAdapters( void )
+{
+	std::vector< xyDisplayAdapter > DisplayAdapters;
+
+	if constexpr( !xyPlatform::HasDisplays )
+	{
+		return DisplayAdapters;
+	}
+	else
+	{
+		if( xyGetBackend() )
+		{
+			xyArena& rScratch = xyGetScratchArena();
+
+			for( const xyPmrDisplayAdapter& rAdapter : xyGetDisplayAdapters( &rScratch ) )
+				DisplayAdapters.emplace_back( xyDisplayAdapter{ .Name=std::string( rAdapter.Name ), .FullRect=rAdapter.FullRect, .WorkRect=rAdapter.WorkRect } );
+
+			rScratch.Reset();
+
+			return DisplayAdapters;
+		}
+
+		xyEnumerateDisplayAdapters( [ & ]( std::string_view Name, const xyRect& rFullRect, const xyRect& rWorkRect )
+		{
+			DisplayAdapters.emplace_back( xyDisplayAdapter{ .Name=std::string( Name ), .FullRect=rFullRect, .WorkRect=rWorkRect } );
+		} );
+
+		return DisplayAdapters;
+	}
+
+} // xyGetDisplayAdapters
+
+//////////////////////////////////////////////////////////////////////////
+
+std::pmr::vector< xyPmrDisplayAdapter > xyGetDisplayAdapters( std::pmr::memory_resource* pMemoryResource )
+{
+	if constexpr( !xyPlatform::HasDisplays )
+	{
+		return std::pmr::vector< xyPmrDisplayAdapter >( pMemoryResource );
+	}
+	else
+	{
+		if( xyBackend* pBackend = xyGetBackend() )
+			return pBackend->GetDisplayAdapters( pMemoryResource );
+
+		std::pmr::vector< xyPmrDisplayAdapter > DisplayAdapters( pMemoryResource );
+
+		xyEnumerateDisplayAdapters( [ & ]( std::string_view Name, const xyRect& rFullRect, const xyRect& rWorkRect )
+		{
+			DisplayAdapters.emplace_back( xyPmrDisplayAdapter{ .Name=std::pmr::string( Name, pMemoryResource ), .FullRect=rFullRect, .WorkRect=rWorkRect } );
+		} );
+
+		return DisplayAdapters;
+	}
+
+} // xyGetDisplayAdapters
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyGetDisplayAdapters( xySmallVector< xyInlineDisplayAdapter, 4 >& rDisplayAdapters )
+{
+	rDisplayAdapters.clear();
+
+	if constexpr( !xyPlatform::HasDisplays )
+	{
+		return;
+	}
+	else
+	{
+		if( xyGetBackend() )
+		{
+			xyArena& rScratch = xyGetScratchArena();
+
+			for( const xyPmrDisplayAdapter& rAdapter : xyGetDisplayAdapters( &rScratch ) )
+				rDisplayAdapters.emplace_back( xyInlineDisplayAdapter{ .Name=rAdapter.Name, .FullRect=rAdapter.FullRect, .WorkRect=rAdapter.WorkRect } );
+
+			rScratch.Reset();
+
+			return;
+		}
+
+		xyEnumerateDisplayAdapters( [ & ]( std::string_view Name, const xyRect& rFullRect, const xyRect& rWorkRect )
+		{
+			rDisplayAdapters.emplace_back( xyInlineDisplayAdapter{ .Name=Name, .FullRect=rFullRect, .WorkRect=rWorkRect } );
+		} );
+	}
+
+} // xyGetDisplayAdapters
+
+//////////////////////////////////////////////////////////////////////////
+
+static size_t xyGetPageSize( uint32_t Flags )
+{
+
+#if defined( XY_OS_WINDOWS )
+
+	if( Flags & XY_MEMORY_EXPLICIT_HUGE_PAGES )
+		return GetLargePageMinimum();
+
+	SYSTEM_INFO SystemInfo;
+	GetSystemInfo( &SystemInfo );
+
+	// Reservations are made at allocation granularity rather than page granularity
+	return SystemInfo.dwAllocationGranularity;
+
+#else // XY_OS_WINDOWS
+
+	if( Flags & ( XY_MEMORY_EXPLICIT_HUGE_PAGES | XY_MEMORY_TRANSPARENT_HUGE_PAGES ) )
+	{
+		static const size_t HugePageSize = []
+		{
+			size_t HugePageSizeKiB = 2048;
+
+		#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+			if( FILE* pMemInfo = fopen( "/proc/meminfo", "r" ) )
+			{
+				char Line[ 128 ];
+				while( fgets( Line, sizeof( Line ), pMemInfo ) )
+				{
+					if( sscanf( Line, "Hugepagesize: %zu kB", &HugePageSizeKiB ) == 1 )
+						break;
+				}
+
+				fclose( pMemInfo );
+			}
+		#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+			return HugePageSizeKiB * 1024;
+		}();
+
+		return HugePageSize;
+	}
+
+	return static_cast< size_t >( sysconf( _SC_PAGESIZE ) );
+
+#endif // !XY_OS_WINDOWS
+
+} // xyGetPageSize
+
+//////////////////////////////////////////////////////////////////////////
+
+xyMemoryReservation xyReserveMemory( size_t Size, uint32_t Flags )
+{
+	xyMemoryReservation Reservation;
+
+#if defined( XY_OS_WINDOWS )
+
+	// Large pages can not be committed on demand, so they are committed together with the reservation
+	if( Flags & XY_MEMORY_EXPLICIT_HUGE_PAGES )
+	{
+		if( const size_t LargePageSize = GetLargePageMinimum() )
+		{
+			Reservation.PageSize = LargePageSize;
+			Reservation.Size     = ( Size + LargePageSize - 1 ) & ~( LargePageSize - 1 );
+			Reservation.pAddress = static_cast< std::byte* >( VirtualAlloc( NULL, Reservation.Size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE ) );
+			Reservation.Flags    = XY_MEMORY_EXPLICIT_HUGE_PAGES;
+
+			if( Reservation.pAddress )
+				return Reservation;
+		}
+
+		// Fall back to regular pages. Most likely the process lacks SeLockMemoryPrivilege.
+		Flags &= ~XY_MEMORY_EXPLICIT_HUGE_PAGES;
+	}
+
+	// Transparent huge pages are not a thing on Windows
+	Flags &= ~XY_MEMORY_TRANSPARENT_HUGE_PAGES;
+
+	Reservation.PageSize = xyGetPageSize( Flags );
+	Reservation.Size     = ( Size + Reservation.PageSize - 1 ) & ~( Reservation.PageSize - 1 );
+	Reservation.pAddress = static_cast< std::byte* >( VirtualAlloc( NULL, Reservation.Size, MEM_RESERVE, PAGE_NOACCESS ) );
+	Reservation.Flags    = Flags;
+
+#else // XY_OS_WINDOWS
+
+#if defined( MAP_HUGETLB )
+
+	if( Flags & XY_MEMORY_EXPLICIT_HUGE_PAGES )
+	{
+		const size_t HugePageSize = xyGetPageSize( XY_MEMORY_EXPLICIT_HUGE_PAGES );
+		const size_t HugeSize     = ( Size + HugePageSize - 1 ) & ~( HugePageSize - 1 );
+		void*        pAddress     = mmap( nullptr, HugeSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_HUGETLB, -1, 0 );
+
+		if( pAddress != MAP_FAILED )
+		{
+			Reservation.pAddress = static_cast< std::byte* >( pAddress );
+			Reservation.Size     = HugeSize;
+			Reservation.PageSize = HugePageSize;
+			Reservation.Flags    = Flags & ~XY_MEMORY_TRANSPARENT_HUGE_PAGES;
+			return Reservation;
+		}
+	}
+
+#endif // MAP_HUGETLB
+
+	Flags &= ~XY_MEMORY_EXPLICIT_HUGE_PAGES;
+
+#if !defined( MADV_HUGEPAGE )
+	Flags &= ~XY_MEMORY_TRANSPARENT_HUGE_PAGES;
+#endif // !MADV_HUGEPAGE
+
+	// Transparent huge pages can only back ranges that are aligned to the huge page size,
+	// so over-reserve by one huge page and trim the unaligned head and tail.
+	const size_t Alignment    = xyGetPageSize( Flags );
+	const size_t AlignedSize  = ( Size + Alignment - 1 ) & ~( Alignment - 1 );
+	const size_t ReserveSize  = ( Flags & XY_MEMORY_TRANSPARENT_HUGE_PAGES ) ? AlignedSize + Alignment : AlignedSize;
+	void*        pAddress     = mmap( nullptr, ReserveSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+
+	if( pAddress == MAP_FAILED )
+		return { };
+
+	std::byte* pBegin        = static_cast< std::byte* >( pAddress );
+	std::byte* pAlignedBegin = reinterpret_cast< std::byte* >( ( reinterpret_cast< uintptr_t >( pBegin ) + Alignment - 1 ) & ~( Alignment - 1 ) );
+	std::byte* pAlignedEnd   = pAlignedBegin + AlignedSize;
+
+	if( pAlignedBegin != pBegin )               munmap( pBegin,      pAlignedBegin - pBegin );
+	if( pAlignedEnd   != pBegin + ReserveSize ) munmap( pAlignedEnd, pBegin + ReserveSize - pAlignedEnd );
+
+#if defined( MADV_HUGEPAGE )
+	if( Flags & XY_MEMORY_TRANSPARENT_HUGE_PAGES )
+		madvise( pAlignedBegin, AlignedSize, MADV_HUGEPAGE );
+#endif // MADV_HUGEPAGE
+
+	Reservation.pAddress = pAlignedBegin;
+	Reservation.Size     = AlignedSize;
+	Reservation.PageSize = Alignment;
+	Reservation.Flags    = Flags;
+
+#endif // !XY_OS_WINDOWS
+
+	return Reservation;
+
+} // xyReserveMemory
+
+//////////////////////////////////////////////////////////////////////////
+
+static void xyTouchPages( std::byte* pBegin, size_t Size, size_t Stride )
+{
+	// An atomic no-op write faults the page in without changing it. The range can start inside a page that is already in use,
+	// and a plain read followed by a write of the same value could lose a store made by another thread in between.
+	for( size_t i = 0; i < Size; i += Stride )
+		std::atomic_ref< uint64_t >( *reinterpret_cast< uint64_t* >( pBegin + i ) ).fetch_or( 0, std::memory_order_relaxed );
+
+} // xyTouchPages
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyCommitMemory( const xyMemoryReservation& rReservation, size_t Offset, size_t Size )
+{
+	const size_t PageMask = rReservation.PageSize - 1;
+	const size_t Begin    = Offset & ~PageMask;
+	const size_t End      = std::min( ( Offset + Size + PageMask ) & ~PageMask, rReservation.Size );
+
+	if( Begin >= End )
+		return Begin == End;
+
+	std::byte*   pBegin    = rReservation.pAddress + Begin;
+	const size_t RangeSize = End - Begin;
+
+#if defined( XY_OS_WINDOWS )
+
+	// Large pages are committed up front
+	if( rReservation.Flags & XY_MEMORY_EXPLICIT_HUGE_PAGES )
+		return true;
+
+	bool Committed = false;
+
+	if( rReservation.Flags & XY_MEMORY_NUMA_LOCAL )
+	{
+		PROCESSOR_NUMBER Processor;
+		USHORT           Node;
+		GetCurrentProcessorNumberEx( &Processor );
+
+		if( GetNumaProcessorNodeEx( &Processor, &Node ) )
+			Committed = VirtualAllocExNuma( GetCurrentProcess(), pBegin, RangeSize, MEM_COMMIT, PAGE_READWRITE, Node ) != NULL;
+	}
+
+	if( !Committed && VirtualAlloc( pBegin, RangeSize, MEM_COMMIT, PAGE_READWRITE ) == NULL )
+		return false;
+
+	if( rReservation.Flags & XY_MEMORY_PREFAULT )
+	{
+		SYSTEM_INFO SystemInfo;
+		GetSystemInfo( &SystemInfo );
+
+		xyTouchPages( pBegin, RangeSize, SystemInfo.dwPageSize );
+	}
+
+#else // XY_OS_WINDOWS
+
+	if( mprotect( pBegin, RangeSize, PROT_READ | PROT_WRITE ) != 0 )
+		return false;
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+	// Bind before the first touch, since that is when the pages get placed. Kernels built without NUMA support have nothing to bind to.
+	if( ( rReservation.Flags & XY_MEMORY_NUMA_LOCAL ) && syscall( SYS_mbind, pBegin, RangeSize, MPOL_LOCAL, nullptr, 0, 0 ) != 0 && errno != ENOSYS )
+	{
+		mprotect( pBegin, RangeSize, PROT_NONE );
+		return false;
+	}
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+	// Explicit huge pages are reserved with MAP_NORESERVE, so an exhausted huge page pool would otherwise surface as SIGBUS on first touch.
+	// Populating them here turns that into a failed commit instead.
+	if( rReservation.Flags & ( XY_MEMORY_PREFAULT | XY_MEMORY_EXPLICIT_HUGE_PAGES ) )
+	{
+	#if defined( MADV_POPULATE_WRITE )
+		if( madvise( pBegin, RangeSize, MADV_POPULATE_WRITE ) == 0 )
+			return true;
+
+		if( errno != EINVAL )
+		{
+			mprotect( pBegin, RangeSize, PROT_NONE );
+			return false;
+		}
+	#endif // MADV_POPULATE_WRITE
+
+		// Older kernels lack MADV_POPULATE_WRITE, so fault the pages in by hand.
+		// An exhausted huge page pool still raises SIGBUS here, but at least it does so during the commit rather than at some later first touch.
+		xyTouchPages( pBegin, RangeSize, rReservation.PageSize );
+	}
+
+#endif // !XY_OS_WINDOWS
+
+	return true;
+
+} // xyCommitMemory
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyDecommitMemory( const xyMemoryReservation& rReservation, size_t Offset, size_t Size )
+{
+	const size_t PageMask = rReservation.PageSize - 1;
+	const size_t Begin    = ( Offset + PageMask ) & ~PageMask;
+	const size_t End      = std::min( ( Offset + Size ) & ~PageMask, rReservation.Size );
+
+	if( Begin >= End )
+		return true;
+
+	std::byte*   pBegin    = rReservation.pAddress + Begin;
+	const size_t RangeSize = End - Begin;
+
+#if defined( XY_OS_WINDOWS )
+
+	// Large pages can not be decommitted individually
+	if( rReservation.Flags & XY_MEMORY_EXPLICIT_HUGE_PAGES )
+		return false;
+
+	return VirtualFree( pBegin, RangeSize, MEM_DECOMMIT ) != FALSE;
+
+#else // XY_OS_WINDOWS
+
+	if( madvise( pBegin, RangeSize, MADV_DONTNEED ) != 0 )
+		return false;
+
+	return mprotect( pBegin, RangeSize, PROT_NONE ) == 0;
+
+#endif // !XY_OS_WINDOWS
+
+} // xyDecommitMemory
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyReleaseMemory( xyMemoryReservation& rReservation )
+{
+	if( !rReservation )
+		return;
+
+#if defined( XY_OS_WINDOWS )
+	VirtualFree( rReservation.pAddress, 0, MEM_RELEASE );
+#else // XY_OS_WINDOWS
+	munmap( rReservation.pAddress, rReservation.Size );
+#endif // !XY_OS_WINDOWS
+
+	rReservation = { };
+
+} // xyReleaseMemory
+
+//////////////////////////////////////////////////////////////////////////
+
+xyMappedFile::xyMappedFile( xyMappedFile&& rrOther ) noexcept
+	: Data  ( std::exchange( rrOther.Data,   { } ) )
+	, pAsset( std::exchange( rrOther.pAsset, nullptr ) )
+{
+} // xyMappedFile
+
+//////////////////////////////////////////////////////////////////////////
+
+xyMappedFile::~xyMappedFile( void )
+{
+
+#if defined( XY_OS_ANDROID )
+	if( pAsset )
+	{
+		AAsset_close( static_cast< AAsset* >( pAsset ) );
+		return;
+	}
+#endif // XY_OS_ANDROID
+
+	if( Data.data() == nullptr )
+		return;
+
+#if defined( XY_OS_WINDOWS )
+	UnmapViewOfFile( Data.data() );
+#else // XY_OS_WINDOWS
+	munmap( const_cast< std::byte* >( Data.data() ), Data.size() );
+#endif // !XY_OS_WINDOWS
+
+} // ~xyMappedFile
+
+//////////////////////////////////////////////////////////////////////////
+
+xyMappedFile& xyMappedFile::operator=( xyMappedFile&& rrOther ) noexcept
+{
+	if( this != &rrOther )
+	{
+		this->~xyMappedFile();
+
+		Data   = std::exchange( rrOther.Data,   { } );
+		pAsset = std::exchange( rrOther.pAsset, nullptr );
+	}
+
+	return *this;
+
+} // operator=
+
+//////////////////////////////////////////////////////////////////////////
+
+xyMappedFile xyMapFile( std::string_view Path, xyAccessPattern AccessPattern )
+{
+	xyMappedFile MappedFile;
+
+#if defined( XY_OS_WINDOWS )
+
+	const DWORD        Flags       = ( AccessPattern == xyAccessPattern::Sequential ) ? FILE_FLAG_SEQUENTIAL_SCAN : ( AccessPattern == xyAccessPattern::Random ) ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL;
+	const std::wstring UnicodePath = xyUnicode( Path );
+	HANDLE             File        = CreateFileW( UnicodePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, Flags, NULL );
+	if( File == INVALID_HANDLE_VALUE )
+		return MappedFile;
+
+	LARGE_INTEGER Size;
+	if( GetFileSizeEx( File, &Size ) && Size.QuadPart > 0 )
+	{
+		if( HANDLE Mapping = CreateFileMappingW( File, NULL, PAGE_READONLY, 0, 0, NULL ) )
+		{
+			// The view keeps the mapping object alive, so both handles can be closed right away
+			if( const void* pView = MapViewOfFile( Mapping, FILE_MAP_READ, 0, 0, 0 ) )
+				MappedFile.Data = { static_cast< const std::byte* >( pView ), static_cast< size_t >( Size.QuadPart ) };
+
+			CloseHandle( Mapping );
+		}
+	}
+
+	CloseHandle( File );
+
+#else // XY_OS_WINDOWS
+
+	const std::string NullTerminatedPath( Path );
+
+#if defined( XY_OS_ANDROID )
+
+	if( !NullTerminatedPath.empty() && NullTerminatedPath[ 0 ] != '/' )
+	{
+		xyContext& rContext = xyGetContext();
+		const int  Mode     = ( AccessPattern == xyAccessPattern::Sequential ) ? AASSET_MODE_STREAMING : ( AccessPattern == xyAccessPattern::Random ) ? AASSET_MODE_RANDOM : AASSET_MODE_BUFFER;
+
+		if( AAsset* pAsset = AAssetManager_open( rContext.pPlatformImpl->pNativeActivity->assetManager, NullTerminatedPath.c_str(), Mode ) )
+		{
+			// Uncompressed assets are mapped straight from the APK. Compressed ones get inflated into a buffer owned by the asset.
+			if( const void* pBuffer = AAsset_getBuffer( pAsset ) )
+			{
+				MappedFile.Data   = { static_cast< const std::byte* >( pBuffer ), static_cast< size_t >( AAsset_getLength64( pAsset ) ) };
+				MappedFile.pAsset = pAsset;
+			}
+			else
+			{
+				AAsset_close( pAsset );
+			}
+		}
+
+		return MappedFile;
+	}
+
+#endif // XY_OS_ANDROID
+
+	const int File = open( NullTerminatedPath.c_str(), O_RDONLY | O_CLOEXEC );
+	if( File < 0 )
+		return MappedFile;
+
+	struct stat Status;
+	if( fstat( File, &Status ) == 0 && Status.st_size > 0 )
+	{
+		// The mapping holds its own reference to the file, so the descriptor can be closed right away
+		void* pAddress = mmap( nullptr, static_cast< size_t >( Status.st_size ), PROT_READ, MAP_PRIVATE, File, 0 );
+		if( pAddress != MAP_FAILED )
+		{
+			switch( AccessPattern )
+			{
+				case xyAccessPattern::Sequential: { madvise( pAddress, static_cast< size_t >( Status.st_size ), MADV_SEQUENTIAL ); } break;
+				case xyAccessPattern::Random:     { madvise( pAddress, static_cast< size_t >( Status.st_size ), MADV_RANDOM );     } break;
+
+				default: break;
+			}
+
+			MappedFile.Data = { static_cast< const std::byte* >( pAddress ), static_cast< size_t >( Status.st_size ) };
+		}
+	}
+
+	close( File );
+
+#endif // !XY_OS_WINDOWS
+
+	return MappedFile;
+
+} // xyMapFile
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyPrefetchMappedFile( const xyMappedFile& rFile, size_t Offset, size_t Size )
+{
+	if( Offset >= rFile.Data.size() )
+		return;
+
+	Size = std::min( Size, rFile.Data.size() - Offset );
+
+#if defined( XY_OS_WINDOWS )
+
+	WIN32_MEMORY_RANGE_ENTRY Range = { .VirtualAddress=const_cast< std::byte* >( rFile.Data.data() + Offset ), .NumberOfBytes=Size };
+	PrefetchVirtualMemory( GetCurrentProcess(), 1, &Range, 0 );
+
+#else // XY_OS_WINDOWS
+
+	// madvise requires a page-aligned address
+	const uintptr_t PageMask = static_cast< uintptr_t >( sysconf( _SC_PAGESIZE ) ) - 1;
+	const uintptr_t Begin    = reinterpret_cast< uintptr_t >( rFile.Data.data() + Offset ) & ~PageMask;
+	const uintptr_t End      = reinterpret_cast< uintptr_t >( rFile.Data.data() + Offset + Size );
+
+	madvise( reinterpret_cast< void* >( Begin ), End - Begin, MADV_WILLNEED );
+
+#endif // !XY_OS_WINDOWS
+
+} // xyPrefetchMappedFile
+
+//////////////////////////////////////////////////////////////////////////
+
+xyFile xyOpenFile( std::string_view Path, xyFileMode Mode )
+{
+
+#if defined( XY_OS_WINDOWS )
+
+	const DWORD        Access      = ( Mode == xyFileMode::Read ) ? GENERIC_READ : ( Mode == xyFileMode::Write ) ? GENERIC_WRITE : ( GENERIC_READ | GENERIC_WRITE );
+	const DWORD        Disposition = ( Mode == xyFileMode::Read ) ? OPEN_EXISTING : OPEN_ALWAYS;
+	const std::wstring UnicodePath = xyUnicode( Path );
+	HANDLE             File        = CreateFileW( UnicodePath.c_str(), Access, FILE_SHARE_READ, NULL, Disposition, FILE_ATTRIBUTE_NORMAL, NULL );
+
+	return { .NativeHandle=reinterpret_cast< intptr_t >( File ) };
+
+#else // XY_OS_WINDOWS
+
+	const int         Flags = ( Mode == xyFileMode::Read ) ? O_RDONLY : ( Mode == xyFileMode::Write ) ? ( O_WRONLY | O_CREAT ) : ( O_RDWR | O_CREAT );
+	const std::string NullTerminatedPath( Path );
+
+	return { .NativeHandle=open( NullTerminatedPath.c_str(), Flags | O_CLOEXEC, 0644 ) };
+
+#endif // !XY_OS_WINDOWS
+
+} // xyOpenFile
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyCloseFile( xyFile& rFile )
+{
+	if( !rFile )
+		return;
+
+#if defined( XY_OS_WINDOWS )
+	CloseHandle( reinterpret_cast< HANDLE >( rFile.NativeHandle ) );
+#else // XY_OS_WINDOWS
+	close( static_cast< int >( rFile.NativeHandle ) );
+#endif // !XY_OS_WINDOWS
+
+	rFile = { };
+
+} // xyCloseFile
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyFileIO
+{
+	struct Request
+	{
+		xyFileCompletion Completion;
+		xyFileCallback   Callback;
+		intptr_t         NativeHandle;
+		int              BufferIndex = -1; // Index of the registered buffer that contains the request buffer
+		bool             Write       = false;
+
+	}; // Request
+
+	xyFileIO( void );
+	~xyFileIO( void );
+
+	void   Enqueue      ( Request NewRequest );
+	size_t Submit       ( void );
+	void   Reap         ( bool Wait, std::unique_lock< std::mutex >& rLock );
+	void   WorkerMain   ( size_t Index );
+	void   StartWorkers ( size_t Count );
+	void   StopWorkers  ( void );
+	void   LimitWorkers ( float Fraction );
+
+	static int64_t Execute( const Request& rRequest );
+
+	std::mutex                            Mutex;
+	std::vector< Request >                Queued;
+	std::vector< Request >                Completed;
+	std::vector< Request >                Delivering;
+	std::vector< std::span< std::byte > > RegisteredBuffers;
+	size_t                                InFlight = 0;
+	size_t                                Waiters  = 0; // Threads blocked in Reap without holding the lock
+
+	// Blocking fallback
+	std::vector< std::thread >            Workers;
+	std::deque< Request >                 WorkQueue;
+	std::condition_variable               WorkAvailable;
+	std::condition_variable               CompletionAvailable;
+	size_t                                WorkerLimit = SIZE_MAX; // Workers at or beyond this index are parked
+	bool                                  Stopping    = false;
+
+#if defined( XY_HAS_IO_URING )
+
+	bool SetupRing( uint32_t Entries );
+	int  EnterRing( uint32_t MinComplete );
+	void WakeWaiters( void );
+
+	// Completions with this user data only wake up waiting threads and do not belong to a request
+	static constexpr uint64_t WakeUpData = UINT64_MAX;
+
+	int                    RingFile     = -1;
+	std::byte*             pSQRing      = nullptr;
+	std::byte*             pCQRing      = nullptr;
+	io_uring_sqe*          pSQEs        = nullptr;
+	size_t                 SQRingSize   = 0;
+	size_t                 CQRingSize   = 0;
+	uint32_t*              pSQHead      = nullptr;
+	uint32_t*              pSQTail      = nullptr;
+	uint32_t*              pSQArray     = nullptr;
+	uint32_t               SQMask       = 0;
+	uint32_t               SQEntries    = 0;
+	uint32_t*              pCQHead      = nullptr;
+	uint32_t*              pCQTail      = nullptr;
+	io_uring_cqe*          pCQEs        = nullptr;
+	uint32_t               CQMask       = 0;
+	std::vector< Request > Slots;
+	std::vector< iovec >   SlotVectors;
+	std::vector< size_t >  FreeSlots;
+	size_t                 InFlightLimit = SIZE_MAX; // Lowered by LimitWorkers, since there are no workers to park while the ring is in use
+
+#endif // XY_HAS_IO_URING
+
+}; // xyFileIO
+
+//////////////////////////////////////////////////////////////////////////
+
+// Lets observers such as the telemetry publisher skip the file I/O system without creating it
+static std::atomic< bool > xyFileIOCreated = false;
+
+static xyFileIO& xyGetFileIO( void )
+{
+	static xyFileIO FileIO;
+
+	xyFileIOCreated.store( true, std::memory_order_relaxed );
+
+	return FileIO;
+
+} // xyGetFileIO
+
+//////////////////////////////////////////////////////////////////////////
+
+xyFileIO::xyFileIO( void )
+{
+	Queued    .reserve( 256 );
+	Completed .reserve( 256 );
+	Delivering.reserve( 256 );
+
+#if defined( XY_HAS_IO_URING )
+	if( SetupRing( 256 ) )
+		return;
+#endif // XY_HAS_IO_URING
+
+	StartWorkers( std::clamp< size_t >( std::thread::hardware_concurrency(), 1, 4 ) );
+
+} // xyFileIO
+
+//////////////////////////////////////////////////////////////////////////
+
+xyFileIO::~xyFileIO( void )
+{
+	StopWorkers();
+
+#if defined( XY_HAS_IO_URING )
+	if( RingFile >= 0 )
+	{
+		munmap( pSQEs, SQEntries * sizeof( io_uring_sqe ) );
+		if( pCQRing != pSQRing )
+			munmap( pCQRing, CQRingSize );
+		munmap( pSQRing, SQRingSize );
+		close( RingFile );
+	}
+#endif // XY_HAS_IO_URING
+
+} // ~xyFileIO
+
+//////////////////////////////////////////////////////////////////////////
+
+#if defined( XY_HAS_IO_URING )
+
+bool xyFileIO::SetupRing( uint32_t Entries )
+{
+	io_uring_params Params = { };
+
+	// Fails with ENOSYS on kernels older than 5.1, and with EPERM where io_uring has been disabled or filtered by seccomp
+	RingFile = static_cast< int >( syscall( __NR_io_uring_setup, Entries, &Params ) );
+	if( RingFile < 0 )
+		return false;
+
+	SQRingSize = Params.sq_off.array + Params.sq_entries * sizeof( uint32_t );
+	CQRingSize = Params.cq_off.cqes  + Params.cq_entries * sizeof( io_uring_cqe );
+
+	const bool SingleMapping = Params.features & IORING_FEAT_SINGLE_MMAP;
+	if( SingleMapping )
+		SQRingSize = CQRingSize = std::max( SQRingSize, CQRingSize );
+
+	void* pSQ   = mmap( nullptr, SQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, RingFile, IORING_OFF_SQ_RING );
+	void* pCQ   = SingleMapping ? pSQ : mmap( nullptr, CQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, RingFile, IORING_OFF_CQ_RING );
+	void* pSQEn = mmap( nullptr, Params.sq_entries * sizeof( io_uring_sqe ), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, RingFile, IORING_OFF_SQES );
+
+	if( pSQ == MAP_FAILED || pCQ == MAP_FAILED || pSQEn == MAP_FAILED )
+	{
+		if( pSQEn != MAP_FAILED )                   munmap( pSQEn, Params.sq_entries * sizeof( io_uring_sqe ) );
+		if( pCQ   != MAP_FAILED && pCQ != pSQ )     munmap( pCQ, CQRingSize );
+		if( pSQ   != MAP_FAILED )                   munmap( pSQ, SQRingSize );
+
+		close( RingFile );
+		RingFile = -1;
+		return false;
+	}
+
+	pSQRing   = static_cast< std::byte* >( pSQ );
+	pCQRing   = static_cast< std::byte* >( pCQ );
+	pSQEs     = static_cast< io_uring_sqe* >( pSQEn );
+	pSQHead   = reinterpret_cast< uint32_t* >( pSQRing + Params.sq_off.head );
+	pSQTail   = reinterpret_cast< uint32_t* >( pSQRing + Params.sq_off.tail );
+	pSQArray  = reinterpret_cast< uint32_t* >( pSQRing + Params.sq_off.array );
+	SQMask    = *reinterpret_cast< uint32_t* >( pSQRing + Params.sq_off.ring_mask );
+	SQEntries = Params.sq_entries;
+	pCQHead   = reinterpret_cast< uint32_t* >( pCQRing + Params.cq_off.head );
+	pCQTail   = reinterpret_cast< uint32_t* >( pCQRing + Params.cq_off.tail );
+	pCQEs     = reinterpret_cast< io_uring_cqe* >( pCQRing + Params.cq_off.cqes );
+	CQMask    = *reinterpret_cast< uint32_t* >( pCQRing + Params.cq_off.ring_mask );
+
+	// Never have more requests in flight than the completion queue can hold, so that it can not overflow
+	Slots      .resize( Params.cq_entries );
+	SlotVectors.resize( Params.cq_entries );
+	FreeSlots  .reserve( Params.cq_entries );
+	for( size_t i = Params.cq_entries; i > 0; --i )
+		FreeSlots.push_back( i - 1 );
+
+	return true;
+
+} // SetupRing
+
+//////////////////////////////////////////////////////////////////////////
+
+int xyFileIO::EnterRing( uint32_t MinComplete )
+{
+	// Always offer every entry that the kernel has not consumed yet, so that entries left behind by a failed call are submitted by the next one
+	const uint32_t Unconsumed = std::atomic_ref< uint32_t >( *pSQTail ).load( std::memory_order_relaxed ) - std::atomic_ref< uint32_t >( *pSQHead ).load( std::memory_order_acquire );
+	const unsigned Flags      = MinComplete ? IORING_ENTER_GETEVENTS : 0;
+	int            Result;
+
+	do Result = static_cast< int >( syscall( __NR_io_uring_enter, RingFile, Unconsumed, MinComplete, Flags, nullptr, 0 ) );
+	while( Result < 0 && errno == EINTR && MinComplete == 0 );
+
+	return Result;
+
+} // EnterRing
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyFileIO::WakeWaiters( void )
+{
+	const uint32_t Tail = *pSQTail;
+	const uint32_t Head = std::atomic_ref< uint32_t >( *pSQHead ).load( std::memory_order_acquire );
+
+	// A full submission queue has requests coming that will wake the waiters anyway
+	if( Tail - Head >= SQEntries )
+		return;
+
+	const uint32_t Index = Tail & SQMask;
+	io_uring_sqe&  rSQE  = pSQEs[ Index ];
+
+	rSQE           = { };
+	rSQE.opcode    = IORING_OP_NOP;
+	rSQE.user_data = WakeUpData;
+
+	pSQArray[ Index ] = Index;
+	std::atomic_ref< uint32_t >( *pSQTail ).store( Tail + 1, std::memory_order_release );
+	EnterRing( 0 );
+
+} // WakeWaiters
+
+#endif // XY_HAS_IO_URING
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyFileIO::StartWorkers( size_t Count )
+{
+	Stopping = false;
+
+	for( size_t i = 0; i < Count; ++i )
+		Workers.emplace_back( &xyFileIO::WorkerMain, this, Workers.size() );
+
+} // StartWorkers
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyFileIO::StopWorkers( void )
+{
+	{
+		std::lock_guard Lock( Mutex );
+		Stopping = true;
+	}
+
+	WorkAvailable.notify_all();
+
+	for( std::thread& rWorker : Workers )
+		rWorker.join();
+
+	Workers.clear();
+
+} // StopWorkers
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyFileIO::LimitWorkers( float Fraction )
+{
+	{
+		std::lock_guard Lock( Mutex );
+		WorkerLimit = std::max< size_t >( static_cast< size_t >( Fraction * Workers.size() + 0.5f ), 1 );
+
+	#if defined( XY_HAS_IO_URING )
+		InFlightLimit = std::max< size_t >( static_cast< size_t >( Fraction * Slots.size() + 0.5f ), 1 );
+	#endif // XY_HAS_IO_URING
+	}
+
+	WorkAvailable.notify_all();
+
+} // LimitWorkers
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyFileIO::WorkerMain( size_t Index )
+{
+	std::unique_lock Lock( Mutex );
+
+	for( ;; )
+	{
+		WorkAvailable.wait( Lock, [ this, Index ] { return Stopping || ( !WorkQueue.empty() && Index < WorkerLimit ); } );
+
+		if( WorkQueue.empty() )
+			return;
+
+		Request Work = WorkQueue.front();
+		WorkQueue.pop_front();
+
+		Lock.unlock();
+		Work.Completion.Result = Execute( Work );
+		Lock.lock();
+
+		Completed.push_back( Work );
+		CompletionAvailable.notify_one();
+	}
+
+} // WorkerMain
+
+//////////////////////////////////////////////////////////////////////////
+
+int64_t xyFileIO::Execute( const Request& rRequest )
+{
+
+#if defined( XY_OS_WINDOWS )
+
+	// Positional I/O on a synchronous handle
+	OVERLAPPED Overlapped = { .Offset=static_cast< DWORD >( rRequest.Completion.Offset ), .OffsetHigh=static_cast< DWORD >( rRequest.Completion.Offset >> 32 ) };
+	HANDLE     File       = reinterpret_cast< HANDLE >( rRequest.NativeHandle );
+	DWORD      Size       = static_cast< DWORD >( rRequest.Completion.Buffer.size() );
+	DWORD      Transferred;
+	BOOL       Success    = rRequest.Write ? WriteFile( File, rRequest.Completion.Buffer.data(), Size, &Transferred, &Overlapped )
+	                                       : ReadFile ( File, rRequest.Completion.Buffer.data(), Size, &Transferred, &Overlapped );
+
+	if( !Success && GetLastError() != ERROR_HANDLE_EOF )
+		return -static_cast< int64_t >( GetLastError() );
+
+	return Success ? Transferred : 0;
+
+#else // XY_OS_WINDOWS
+
+	const int     File   = static_cast< int >( rRequest.NativeHandle );
+	const off_t   Offset = static_cast< off_t >( rRequest.Completion.Offset );
+	const ssize_t Result = rRequest.Write ? pwrite( File, rRequest.Completion.Buffer.data(), rRequest.Completion.Buffer.size(), Offset )
+	                                      : pread ( File, rRequest.Completion.Buffer.data(), rRequest.Completion.Buffer.size(), Offset );
+
+	return ( Result < 0 ) ? -errno : Result;
+
+#endif // !XY_OS_WINDOWS
+
+} // Execute
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyFileIO::Enqueue( Request NewRequest )
+{
+	for( size_t i = 0; i < RegisteredBuffers.size(); ++i )
+	{
+		const std::span< std::byte > Registered = RegisteredBuffers[ i ];
+		if( NewRequest.Completion.Buffer.data() >= Registered.data() && NewRequest.Completion.Buffer.data() + NewRequest.Completion.Buffer.size() <= Registered.data() + Registered.size() )
+		{
+			NewRequest.BufferIndex = static_cast< int >( i );
+			break;
+		}
+	}
+
+	Queued.push_back( NewRequest );
+
+} // Enqueue
+
+//////////////////////////////////////////////////////////////////////////
+
+size_t xyFileIO::Submit( void )
+{
+	size_t Submitted = 0;
+
+#if defined( XY_HAS_IO_URING )
+
+	if( RingFile >= 0 )
+	{
+		uint32_t Tail = *pSQTail;
+		uint32_t Head = std::atomic_ref< uint32_t >( *pSQHead ).load( std::memory_order_acquire );
+
+		while( Submitted < Queued.size() && !FreeSlots.empty() && ( Tail - Head ) < SQEntries && InFlight + Submitted < InFlightLimit )
+		{
+			const Request& rRequest = Queued[ Submitted ];
+			const size_t   Slot     = FreeSlots.back();
+			const uint32_t Index    = Tail & SQMask;
+			io_uring_sqe&  rSQE     = pSQEs[ Index ];
+
+			FreeSlots.pop_back();
+			Slots[ Slot ]       = rRequest;
+			SlotVectors[ Slot ] = { .iov_base=rRequest.Completion.Buffer.data(), .iov_len=rRequest.Completion.Buffer.size() };
+
+			rSQE           = { };
+			rSQE.fd        = static_cast< int >( rRequest.NativeHandle );
+			rSQE.off       = rRequest.Completion.Offset;
+			rSQE.user_data = Slot;
+
+			if( rRequest.BufferIndex >= 0 )
+			{
+				rSQE.opcode    = rRequest.Write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+				rSQE.addr      = reinterpret_cast< uintptr_t >( rRequest.Completion.Buffer.data() );
+				rSQE.len       = static_cast< uint32_t >( rRequest.Completion.Buffer.size() );
+				rSQE.buf_index = static_cast< uint16_t >( rRequest.BufferIndex );
+			}
+			else
+			{
+				// The vectored variants are used since they are supported by every kernel that has io_uring
+				rSQE.opcode = rRequest.Write ? IORING_OP_WRITEV : IORING_OP_READV;
+				rSQE.addr   = reinterpret_cast< uintptr_t >( &SlotVectors[ Slot ] );
+				rSQE.len    = 1;
+			}
+
+			pSQArray[ Index ] = Index;
+			++Tail;
+			++Submitted;
+		}
+
+		if( Tail != Head )
+		{
+			std::atomic_ref< uint32_t >( *pSQTail ).store( Tail, std::memory_order_release );
+			EnterRing( 0 );
+		}
+	}
+	else
+
+#endif // XY_HAS_IO_URING
+
+	{
+		Submitted = Queued.size();
+		WorkQueue.insert( WorkQueue.end(), Queued.begin(), Queued.end() );
+
+		// A single wakeup could land on a parked worker, so only rely on one when no workers are parked
+		if( Submitted > 1 || WorkerLimit < Workers.size() ) WorkAvailable.notify_all();
+		else                                                WorkAvailable.notify_one();
+	}
+
+	Queued.erase( Queued.begin(), Queued.begin() + Submitted );
+	InFlight += Submitted;
+
+	return Submitted;
+
+} // Submit
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyFileIO::Reap( bool Wait, std::unique_lock< std::mutex >& rLock )
+{
+	Delivering.clear();
+
+#if defined( XY_HAS_IO_URING )
+
+	if( RingFile >= 0 )
+	{
+		if( Wait && InFlight > 0 && *pCQHead == std::atomic_ref< uint32_t >( *pCQTail ).load( std::memory_order_acquire ) )
+		{
+			// Wait without the lock, so that other threads can keep queueing and submitting requests in the meantime.
+			// Errors are not fatal, since the completion queue is checked regardless. EINTR simply returns early.
+			++Waiters;
+			rLock.unlock();
+			EnterRing( 1 );
+			rLock.lock();
+			--Waiters;
+		}
+
+		// Another thread may have reaped in the meantime, so the head is read after the wait
+		uint32_t Head = *pCQHead;
+		uint32_t Tail = std::atomic_ref< uint32_t >( *pCQTail ).load( std::memory_order_acquire );
+
+		for( ; Head != Tail; ++Head )
+		{
+			const io_uring_cqe& rCQE = pCQEs[ Head & CQMask ];
+			if( rCQE.user_data == WakeUpData )
+				continue;
+
+			Request& rDone = Slots[ rCQE.user_data ];
+
+			rDone.Completion.Result = rCQE.res;
+			Delivering.push_back( rDone );
+			FreeSlots.push_back( rCQE.user_data );
+		}
+
+		std::atomic_ref< uint32_t >( *pCQHead ).store( Head, std::memory_order_release );
+
+		// A thread that waits for requests that this thread just took would otherwise wait for a completion that never comes
+		if( Waiters > 0 && InFlight == Delivering.size() && !Delivering.empty() )
+			WakeWaiters();
+	}
+	else
+
+#endif // XY_HAS_IO_URING
+
+	{
+		if( Wait && InFlight > 0 )
+		{
+			++Waiters;
+			CompletionAvailable.wait( rLock, [ this ] { return !Completed.empty() || InFlight == 0; } );
+			--Waiters;
+		}
+
+		Delivering.swap( Completed );
+
+		// Same as above, but for threads waiting on the condition variable
+		if( Waiters > 0 && InFlight == Delivering.size() && !Delivering.empty() )
+			CompletionAvailable.notify_all();
+	}
+
+	InFlight -= Delivering.size();
+
+} // Reap
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyReadFileAsync( const xyFile& rFile, uint64_t Offset, std::span< std::byte > Buffer, xyFileCallback Callback, void* pUserData )
+{
+	xyFileIO&       rFileIO = xyGetFileIO();
+	std::lock_guard Lock( rFileIO.Mutex );
+
+	rFileIO.Enqueue( { .Completion={ .Buffer=Buffer, .Offset=Offset, .pUserData=pUserData }, .Callback=Callback, .NativeHandle=rFile.NativeHandle } );
+
+} // xyReadFileAsync
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyWriteFileAsync( const xyFile& rFile, uint64_t Offset, std::span< const std::byte > Buffer, xyFileCallback Callback, void* pUserData )
+{
+	xyFileIO&              rFileIO         = xyGetFileIO();
+	std::span< std::byte > UnconstedBuffer = { const_cast< std::byte* >( Buffer.data() ), Buffer.size() };
+	std::lock_guard        Lock( rFileIO.Mutex );
+
+	rFileIO.Enqueue( { .Completion={ .Buffer=UnconstedBuffer, .Offset=Offset, .pUserData=pUserData }, .Callback=Callback, .NativeHandle=rFile.NativeHandle, .Write=true } );
+
+} // xyWriteFileAsync
+
+//////////////////////////////////////////////////////////////////////////
+
+size_t xySubmitFileRequests( void )
+{
+	xyFileIO&       rFileIO = xyGetFileIO();
+	std::lock_guard Lock( rFileIO.Mutex );
+
+	return rFileIO.Submit();
+
+} // xySubmitFileRequests
+
+//////////////////////////////////////////////////////////////////////////
+
+size_t xyPollFileCompletions( bool Wait )
+{
+	xyFileIO&        rFileIO = xyGetFileIO();
+	std::unique_lock Lock( rFileIO.Mutex );
+
+	rFileIO.Reap( Wait, Lock );
+
+	// Completions free up room for requests that did not fit in the submission queue earlier
+	if( !rFileIO.Queued.empty() && !rFileIO.Delivering.empty() )
+		rFileIO.Submit();
+
+	// Callbacks are invoked without holding the lock, so that they can queue new requests.
+	// The delivery buffer is swapped out in case a callback polls recursively.
+	std::vector< xyFileIO::Request > Delivering;
+	Delivering.swap( rFileIO.Delivering );
+	Lock.unlock();
+
+	for( const xyFileIO::Request& rRequest : Delivering )
+		rRequest.Callback( rRequest.Completion );
+
+	const size_t Count = Delivering.size();
+
+	// Hand the buffer back so that its capacity is reused
+	Delivering.clear();
+	Lock.lock();
+	if( rFileIO.Delivering.capacity() < Delivering.capacity() )
+		rFileIO.Delivering.swap( Delivering );
+
+	return Count;
+
+} // xyPollFileCompletions
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyRegisterFileBuffers( std::span< const std::span< std::byte > > Buffers )
+{
+	xyFileIO&       rFileIO = xyGetFileIO();
+	std::lock_guard Lock( rFileIO.Mutex );
+
+	rFileIO.RegisteredBuffers.assign( Buffers.begin(), Buffers.end() );
+
+#if defined( XY_HAS_IO_URING )
+
+	if( rFileIO.RingFile >= 0 )
+	{
+		syscall( __NR_io_uring_register, rFileIO.RingFile, IORING_UNREGISTER_BUFFERS, nullptr, 0 );
+
+		if( Buffers.empty() )
+			return true;
+
+		std::vector< iovec > Vectors;
+		Vectors.reserve( Buffers.size() );
+		for( std::span< std::byte > Buffer : Buffers )
+			Vectors.push_back( { .iov_base=Buffer.data(), .iov_len=Buffer.size() } );
+
+		if( syscall( __NR_io_uring_register, rFileIO.RingFile, IORING_REGISTER_BUFFERS, Vectors.data(), static_cast< unsigned >( Vectors.size() ) ) == 0 )
+			return true;
+
+		// Fall back to regular requests
+		rFileIO.RegisteredBuffers.clear();
+	}
+
+#endif // XY_HAS_IO_URING
+
+	return false;
+
+} // xyRegisterFileBuffers
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyDirectoryWatchImpl
+{
+	struct RawEvent
+	{
+		uint32_t        PathOffset;
+		uint32_t        PathLength;
+		uint64_t        Sequence;
+		xyFileEventType Type;
+
+	}; // RawEvent
+
+	struct Batch
+	{
+		// Paths are assembled straight into the shared string, whose capacity is kept between batches, so that adding an event does not allocate
+		void Add( std::string_view Directory, std::string_view Name, xyFileEventType Type, uint64_t Sequence )
+		{
+			const size_t Offset = Paths.size();
+
+			if( !Directory.empty() )
+				Paths.append( Directory ).append( 1, '/' );
+
+			Paths.append( Name );
+			Events.push_back( { .PathOffset=static_cast< uint32_t >( Offset ), .PathLength=static_cast< uint32_t >( Paths.size() - Offset ), .Sequence=Sequence, .Type=Type } );
+
+		} // Add
+
+	#if defined( XY_OS_WINDOWS )
+
+		void Add( std::wstring_view Path, xyFileEventType Type, uint64_t Sequence )
+		{
+			const size_t Offset  = Paths.size();
+			const int    MaxSize = static_cast< int >( Path.size() * 3 );
+
+			Paths.resize( Offset + MaxSize );
+			Paths.resize( Offset + WideCharToMultiByte( CP_UTF8, 0, Path.data(), static_cast< int >( Path.size() ), Paths.data() + Offset, MaxSize, nullptr, nullptr ) );
+			std::replace( Paths.begin() + Offset, Paths.end(), '\\', '/' );
+
+			Events.push_back( { .PathOffset=static_cast< uint32_t >( Offset ), .PathLength=static_cast< uint32_t >( Paths.size() - Offset ), .Sequence=Sequence, .Type=Type } );
+
+		} // Add
+
+	#endif // XY_OS_WINDOWS
+
+		void Append( const Batch& rOther )
+		{
+			const uint32_t Base = static_cast< uint32_t >( Paths.size() );
+
+			for( RawEvent Event : rOther.Events )
+			{
+				Event.PathOffset += Base;
+				Events.push_back( Event );
+			}
+
+			Paths.append( rOther.Paths );
+
+		} // Append
+
+		void Clear( void )
+		{
+			Events.clear();
+			Paths.clear();
+
+		} // Clear
+
+		std::string_view PathOf( const RawEvent& rEvent ) const { return std::string_view( Paths ).substr( rEvent.PathOffset, rEvent.PathLength ); }
+
+		std::vector< RawEvent > Events;
+		std::string             Paths;
+
+	}; // Batch
+
+	~xyDirectoryWatchImpl( void );
+
+	void Add    ( std::string_view Directory, std::string_view Name, xyFileEventType Type ) { Pending.Add( Directory, Name, Type, NextSequence++ ); }
+	void Publish( void );
+	void Run    ( void );
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+	void AddWatches( const std::string& rRelativePath, bool EmitCreated );
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+	std::string                 Root;
+	std::chrono::milliseconds   CoalescingWindow;
+	bool                        Recursive;
+
+	std::thread                 Thread;
+	std::mutex                  Mutex;
+	std::mutex                  DispatchMutex;
+	std::condition_variable     EventsAvailable;
+	Batch                       Pending;    // Owned by the watcher thread
+	Batch                       Shared;     // Guarded by Mutex
+	Batch                       Delivering; // Guarded by DispatchMutex
+	std::vector< xyFileEvent >  Events;     // Guarded by DispatchMutex
+	uint64_t                    NextSequence = 0;
+	bool                        Stopped      = false;
+
+#if defined( XY_OS_WINDOWS )
+	HANDLE                      Directory    = INVALID_HANDLE_VALUE;
+	HANDLE                      ChangeEvent  = NULL;
+	HANDLE                      StopEvent    = NULL;
+#elif defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID ) // XY_OS_WINDOWS
+	int                         InotifyFile  = -1;
+	int                         StopFile     = -1;
+	std::unordered_map< int, std::string > Directories;
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+}; // xyDirectoryWatchImpl
+
+//////////////////////////////////////////////////////////////////////////
+
+xyDirectoryWatchImpl::~xyDirectoryWatchImpl( void )
+{
+
+#if defined( XY_OS_WINDOWS )
+
+	if( StopEvent )
+		SetEvent( StopEvent );
+
+	if( Thread.joinable() )
+		Thread.join();
+
+	if( Directory != INVALID_HANDLE_VALUE ) CloseHandle( Directory );
+	if( ChangeEvent )                       CloseHandle( ChangeEvent );
+	if( StopEvent )                         CloseHandle( StopEvent );
+
+#elif defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID ) // XY_OS_WINDOWS
+
+	if( StopFile >= 0 )
+	{
+		const uint64_t One = 1;
+		( void )write( StopFile, &One, sizeof( One ) );
+	}
+
+	if( Thread.joinable() )
+		Thread.join();
+
+	if( InotifyFile >= 0 ) close( InotifyFile );
+	if( StopFile >= 0 )    close( StopFile );
+
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+} // ~xyDirectoryWatchImpl
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyDirectoryWatchImpl::Publish( void )
+{
+	{
+		std::lock_guard Lock( Mutex );
+		Shared.Append( Pending );
+	}
+
+	EventsAvailable.notify_all();
+	Pending.Clear();
+
+} // Publish
+
+//////////////////////////////////////////////////////////////////////////
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+void xyDirectoryWatchImpl::AddWatches( const std::string& rRelativePath, bool EmitCreated )
+{
+	const uint32_t    Mask     = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+	const std::string FullPath = rRelativePath.empty() ? Root : ( Root + '/' + rRelativePath );
+	const int         Watch    = inotify_add_watch( InotifyFile, FullPath.c_str(), Mask );
+	if( Watch < 0 )
+		return;
+
+	Directories[ Watch ] = rRelativePath;
+
+	// Files created in a new directory before its watch was added would otherwise go unnoticed
+	if( !Recursive && !EmitCreated )
+		return;
+
+	if( DIR* pDirectory = opendir( FullPath.c_str() ) )
+	{
+		while( dirent* pEntry = readdir( pDirectory ) )
+		{
+			const std::string_view Name = pEntry->d_name;
+			if( Name == "." || Name == ".." )
+				continue;
+
+			const std::string ChildPath = rRelativePath.empty() ? std::string( Name ) : ( rRelativePath + '/' ).append( Name );
+
+			if( EmitCreated )
+				Add( { }, ChildPath, xyFileEventType::Created );
+
+			if( Recursive && pEntry->d_type == DT_DIR )
+				AddWatches( ChildPath, EmitCreated );
+		}
+
+		closedir( pDirectory );
+	}
+
+} // AddWatches
+
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyDirectoryWatchImpl::Run( void )
+{
+	using Clock = std::chrono::steady_clock;
+
+	Clock::time_point Deadline;
+
+#if defined( XY_OS_WINDOWS )
+
+	const DWORD  Filter     = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_CREATION;
+	OVERLAPPED   Overlapped = { .hEvent=ChangeEvent };
+	alignas( DWORD ) BYTE Buffer[ 64 * 1024 ];
+
+	if( !ReadDirectoryChangesW( Directory, Buffer, sizeof( Buffer ), Recursive, Filter, NULL, &Overlapped, NULL ) )
+		return;
+
+	for( ;; )
+	{
+		const DWORD  Timeout   = Pending.Events.empty() ? INFINITE : static_cast< DWORD >( std::max< int64_t >( 0, std::chrono::duration_cast< std::chrono::milliseconds >( Deadline - Clock::now() ).count() ) );
+		const HANDLE Handles[] = { ChangeEvent, StopEvent };
+		const DWORD  Result    = WaitForMultipleObjects( 2, Handles, FALSE, Timeout );
+
+		if( Result == WAIT_OBJECT_0 )
+		{
+			DWORD Bytes;
+			if( !GetOverlappedResult( Directory, &Overlapped, &Bytes, FALSE ) )
+				break;
+
+			if( Pending.Events.empty() )
+				Deadline = Clock::now() + CoalescingWindow;
+
+			// Zero bytes means that the buffer overflowed and the changes were lost. Report the root as modified.
+			if( Bytes == 0 )
+				Add( { }, { }, xyFileEventType::Modified );
+
+			for( DWORD Offset = 0; Bytes > 0; )
+			{
+				const FILE_NOTIFY_INFORMATION& rInfo = *reinterpret_cast< const FILE_NOTIFY_INFORMATION* >( Buffer + Offset );
+				const std::wstring_view        Path  = std::wstring_view( rInfo.FileName, rInfo.FileNameLength / sizeof( WCHAR ) );
+
+				switch( rInfo.Action )
+				{
+					case FILE_ACTION_ADDED:
+					case FILE_ACTION_RENAMED_NEW_NAME: { Pending.Add( Path, xyFileEventType::Created,  NextSequence++ ); } break;
+					case FILE_ACTION_REMOVED:
+					case FILE_ACTION_RENAMED_OLD_NAME: { Pending.Add( Path, xyFileEventType::Removed,  NextSequence++ ); } break;
+					default:                           { Pending.Add( Path, xyFileEventType::Modified, NextSequence++ ); } break;
+				}
+
+				if( rInfo.NextEntryOffset == 0 )
+					break;
+
+				Offset += rInfo.NextEntryOffset;
+			}
+
+			if( !ReadDirectoryChangesW( Directory, Buffer, sizeof( Buffer ), Recursive, Filter, NULL, &Overlapped, NULL ) )
+				break;
+		}
+		else if( Result != WAIT_TIMEOUT )
+		{
+			// The buffer must stay alive until the cancelled read has finished
+			DWORD Bytes;
+			CancelIoEx( Directory, &Overlapped );
+			GetOverlappedResult( Directory, &Overlapped, &Bytes, TRUE );
+			break;
+		}
+
+		if( !Pending.Events.empty() && Clock::now() >= Deadline )
+			Publish();
+	}
+
+#elif defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID ) // XY_OS_WINDOWS
+
+	alignas( inotify_event ) char Buffer[ 16 * 1024 ];
+
+	for( ;; )
+	{
+		const int Timeout = Pending.Events.empty() ? -1 : static_cast< int >( std::max< int64_t >( 0, std::chrono::duration_cast< std::chrono::milliseconds >( Deadline - Clock::now() ).count() ) );
+		pollfd    Files[] = { { .fd=InotifyFile, .events=POLLIN, .revents=0 }, { .fd=StopFile, .events=POLLIN, .revents=0 } };
+
+		if( poll( Files, 2, Timeout ) < 0 && errno != EINTR )
+			break;
+
+		if( Files[ 1 ].revents )
+			break;
+
+		if( Files[ 0 ].revents & POLLIN )
+		{
+			if( Pending.Events.empty() )
+				Deadline = Clock::now() + CoalescingWindow;
+
+			ssize_t Size;
+			while( ( Size = read( InotifyFile, Buffer, sizeof( Buffer ) ) ) > 0 )
+			{
+				for( char* pCursor = Buffer; pCursor < Buffer + Size; )
+				{
+					const inotify_event& rEvent = *reinterpret_cast< const inotify_event* >( pCursor );
+					pCursor += sizeof( inotify_event ) + rEvent.len;
+
+					// The kernel queue overflowed and events were lost. Report the root as modified.
+					if( rEvent.mask & IN_Q_OVERFLOW )
+					{
+						Add( { }, { }, xyFileEventType::Modified );
+						continue;
+					}
+
+					if( rEvent.mask & IN_IGNORED )
+					{
+						Directories.erase( rEvent.wd );
+						continue;
+					}
+
+					auto Directory = Directories.find( rEvent.wd );
+					if( Directory == Directories.end() || rEvent.len == 0 )
+						continue;
+
+					if( rEvent.mask & ( IN_CREATE | IN_MOVED_TO ) )
+					{
+						Add( Directory->second, rEvent.name, xyFileEventType::Created );
+
+						// New directories need a path of their own to be watched. They are rare enough for that to be allowed to allocate.
+						if( Recursive && ( rEvent.mask & IN_ISDIR ) )
+							AddWatches( std::string( Pending.PathOf( Pending.Events.back() ) ), true );
+					}
+					else if( rEvent.mask & ( IN_DELETE | IN_MOVED_FROM ) )
+					{
+						Add( Directory->second, rEvent.name, xyFileEventType::Removed );
+					}
+					else
+					{
+						Add( Directory->second, rEvent.name, xyFileEventType::Modified );
+					}
+				}
+			}
+		}
+
+		if( !Pending.Events.empty() && Clock::now() >= Deadline )
+			Publish();
+	}
+
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+	{
+		std::lock_guard Lock( Mutex );
+		Stopped = true;
+	}
+
+	EventsAvailable.notify_all();
+
+} // Run
+
+//////////////////////////////////////////////////////////////////////////
+
+xyDirectoryWatch xyWatchDirectory( std::string_view Path, bool Recursive, std::chrono::milliseconds CoalescingWindow )
+{
+	auto pImpl              = std::make_shared< xyDirectoryWatchImpl >();
+	pImpl->Root             = Path;
+	pImpl->Recursive        = Recursive;
+	pImpl->CoalescingWindow = CoalescingWindow;
+
+	while( pImpl->Root.size() > 1 && ( pImpl->Root.back() == '/' || pImpl->Root.back() == '\\' ) )
+		pImpl->Root.pop_back();
+
+#if defined( XY_OS_WINDOWS )
+
+	const std::wstring UnicodePath = xyUnicode( pImpl->Root );
+	pImpl->Directory               = CreateFileW( UnicodePath.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL );
+	pImpl->ChangeEvent             = CreateEventW( NULL, FALSE, FALSE, NULL );
+	pImpl->StopEvent               = CreateEventW( NULL, TRUE,  FALSE, NULL );
+
+	if( pImpl->Directory == INVALID_HANDLE_VALUE || !pImpl->ChangeEvent || !pImpl->StopEvent )
+		return { };
+
+#elif defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID ) // XY_OS_WINDOWS
+
+	pImpl->InotifyFile = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+	pImpl->StopFile    = eventfd( 0, EFD_CLOEXEC );
+
+	if( pImpl->InotifyFile < 0 || pImpl->StopFile < 0 )
+		return { };
+
+	pImpl->AddWatches( { }, false );
+
+	if( pImpl->Directories.empty() )
+		return { };
+
+#else // XY_OS_LINUX || XY_OS_ANDROID
+
+	// Not supported on Apple platforms
+	return { };
+
+#endif // !XY_OS_WINDOWS && !XY_OS_LINUX && !XY_OS_ANDROID
+
+	pImpl->Thread = std::thread( &xyDirectoryWatchImpl::Run, pImpl.get() );
+
+	return { .pImpl=std::move( pImpl ) };
+
+} // xyWatchDirectory
+
+//////////////////////////////////////////////////////////////////////////
+
+size_t xyDispatchDirectoryEvents( const xyDirectoryWatch& rWatch, xyFileEventCallback Callback, void* pUserData, bool Wait )
+{
+	if( !rWatch )
+		return 0;
+
+	xyDirectoryWatchImpl& rImpl = *rWatch.pImpl;
+	std::lock_guard       DispatchLock( rImpl.DispatchMutex );
+
+	{
+		std::unique_lock Lock( rImpl.Mutex );
+
+		if( Wait )
+			rImpl.EventsAvailable.wait( Lock, [ &rImpl ] { return !rImpl.Shared.Events.empty() || rImpl.Stopped; } );
+
+		// Swapping rather than copying keeps the capacity of both batches around
+		std::swap( rImpl.Shared, rImpl.Delivering );
+	}
+
+	std::vector< xyDirectoryWatchImpl::RawEvent >& rRawEvents = rImpl.Delivering.Events;
+
+	// Group the events by path while keeping them in the order they happened
+	std::sort( rRawEvents.begin(), rRawEvents.end(), [ &rImpl ]( const xyDirectoryWatchImpl::RawEvent& rLhs, const xyDirectoryWatchImpl::RawEvent& rRhs )
+	{
+		const std::string_view LhsPath = rImpl.Delivering.PathOf( rLhs );
+		const std::string_view RhsPath = rImpl.Delivering.PathOf( rRhs );
+
+		return ( LhsPath != RhsPath ) ? ( LhsPath < RhsPath ) : ( rLhs.Sequence < rRhs.Sequence );
+	} );
+
+	rImpl.Events.clear();
+
+	for( size_t First = 0, Last; First < rRawEvents.size(); First = Last )
+	{
+		const std::string_view Path = rImpl.Delivering.PathOf( rRawEvents[ First ] );
+
+		for( Last = First + 1; Last < rRawEvents.size() && rImpl.Delivering.PathOf( rRawEvents[ Last ] ) == Path; ++Last );
+
+		const xyFileEventType FirstType = rRawEvents[ First ].Type;
+		const xyFileEventType LastType  = rRawEvents[ Last - 1 ].Type;
+
+		if( FirstType == xyFileEventType::Created )
+		{
+			// A file that was created and removed again within the same batch never existed as far as the application is concerned
+			if( LastType != xyFileEventType::Removed )
+				rImpl.Events.push_back( { .Path=Path, .Type=xyFileEventType::Created } );
+		}
+		else if( LastType == xyFileEventType::Removed )
+		{
+			rImpl.Events.push_back( { .Path=Path, .Type=xyFileEventType::Removed } );
+		}
+		else
+		{
+			// Modified, or removed and then replaced
+			rImpl.Events.push_back( { .Path=Path, .Type=xyFileEventType::Modified } );
+		}
+	}
+
+	if( !rImpl.Events.empty() )
+		Callback( rImpl.Events, pUserData );
+
+	rImpl.Delivering.Clear();
+
+	return rImpl.Events.size();
+
+} // xyDispatchDirectoryEvents
+
+//////////////////////////////////////////////////////////////////////////
+
+static uint32_t xyCRC32( uint32_t CRC, std::span< const std::byte > Data )
+{
+	static constexpr auto Table = []
+	{
+		std::array< uint32_t, 256 > Table = { };
+
+		for( uint32_t i = 0; i < 256; ++i )
+		{
+			uint32_t Value = i;
+			for( int Bit = 0; Bit < 8; ++Bit )
+				Value = ( Value & 1 ) ? ( 0xEDB88320u ^ ( Value >> 1 ) ) : ( Value >> 1 );
+
+			Table[ i ] = Value;
+		}
+
+		return Table;
+	}();
+
+	CRC = ~CRC;
+
+	for( std::byte Byte : Data )
+		CRC = Table[ ( CRC ^ static_cast< uint32_t >( Byte ) ) & 0xFF ] ^ ( CRC >> 8 );
+
+	return ~CRC;
+
+} // xyCRC32
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyPreferencesImpl
+{
+	struct FileHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint64_t Reserved;
+
+	}; // FileHeader
+
+	struct RecordHeader
+	{
+		uint32_t Checksum; // CRC-32 of everything in the record that follows the checksum
+		uint32_t KeySize;  // Zero marks the end of the log
+		uint32_t ValueSize;
+		uint32_t Flags;
+
+	}; // RecordHeader
+
+	// A mapping of the log together with the index of its records.
+	// Readers use a view without taking any locks. A view that has been replaced by compaction is unmapped once it has no readers left,
+	// but the structure itself is reused rather than freed, since a reader may still be about to count itself in.
+	struct View
+	{
+		~View( void ) { Unmap(); }
+
+		void                     Unmap   ( void );
+		std::atomic< uint32_t >* FindSlot( std::string_view Key ) const;
+
+		const RecordHeader& HeaderAt( uint32_t Offset ) const { return *reinterpret_cast< const RecordHeader* >( pBase + Offset ); }
+		std::string_view    KeyAt   ( uint32_t Offset ) const { return { reinterpret_cast< const char* >( pBase + Offset + sizeof( RecordHeader ) ), HeaderAt( Offset ).KeySize }; }
+		std::string_view    ValueAt ( uint32_t Offset ) const { return { reinterpret_cast< const char* >( pBase + Offset + sizeof( RecordHeader ) ) + HeaderAt( Offset ).KeySize, HeaderAt( Offset ).ValueSize }; }
+
+		std::byte*                                   pBase     = nullptr;
+		size_t                                       Size      = 0;
+		size_t                                       SlotCount = 0;
+		std::unique_ptr< std::atomic< uint32_t >[] > pSlots; // Open-addressed index of record offsets. Zero marks an empty slot.
+		std::atomic< uint32_t >                      Readers   = 0; // The values that point into the mapping, and readers that are about to look something up
+
+	#if defined( XY_OS_WINDOWS )
+		HANDLE                                       Mapping   = NULL;
+	#endif // XY_OS_WINDOWS
+
+	}; // View
+
+	static constexpr uint32_t Magic           = 0x46505958; // "XYPF"
+	static constexpr uint32_t Version         = 1;
+	static constexpr uint32_t FlagTombstone   = 0x1;
+	static constexpr size_t   GrowthIncrement = 64 * 1024;
+
+	~xyPreferencesImpl( void ) { CloseFile(); }
+
+	bool  Open     ( void );
+	void  CloseFile( void );
+	bool  Grow     ( size_t Size );
+	void  Load     ( View& rView );
+	bool  Append   ( std::string_view Key, std::string_view Value, uint32_t Flags );
+	bool  Compact  ( void );
+	View& Current  ( void ) { return *pReaderView.load( std::memory_order_relaxed ); }
+	View& Acquire  ( void );
+	void  Retire   ( void );
+
+	static size_t RecordSize( size_t KeySize, size_t ValueSize ) { return ( sizeof( RecordHeader ) + KeySize + ValueSize + 7 ) & ~size_t( 7 ); }
+
+	std::string                                  Path;
+	size_t                                       Capacity    = 0;
+	size_t                                       FileSize    = 0;
+	size_t                                       WriteOffset = 0;
+	size_t                                       DeadBytes   = 0; // Bytes that compaction would reclaim
+	size_t                                       UsedSlots   = 0;
+	std::vector< std::unique_ptr< View > >       Views;                 // The current view, views that readers still hold and unmapped ones for reuse. Guarded by WriteMutex.
+	std::atomic< View* >                         pReaderView = nullptr; // The current view, published to readers once it has been loaded
+	std::mutex                                   WriteMutex;
+
+#if defined( XY_OS_WINDOWS )
+	HANDLE                                       File        = INVALID_HANDLE_VALUE;
+#else // XY_OS_WINDOWS
+	int                                          File        = -1;
+#endif // !XY_OS_WINDOWS
+
+}; // xyPreferencesImpl
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyPreferencesImpl::View::Unmap( void )
+{
+
+#if defined( XY_OS_WINDOWS )
+
+	if( pBase )   UnmapViewOfFile( pBase );
+	if( Mapping ) CloseHandle( Mapping );
+
+	Mapping = NULL;
+
+#else // XY_OS_WINDOWS
+
+	if( pBase ) munmap( pBase, Size );
+
+#endif // !XY_OS_WINDOWS
+
+	// The reader count is left alone, since readers that are backing out of a stale view still have to subtract themselves
+	pBase     = nullptr;
+	Size      = 0;
+	SlotCount = 0;
+	pSlots.reset();
+
+} // Unmap
+
+//////////////////////////////////////////////////////////////////////////
+
+std::atomic< uint32_t >* xyPreferencesImpl::View::FindSlot( std::string_view Key ) const
+{
+	const size_t Mask  = SlotCount - 1;
+	size_t       Index = xyHashString( Key ) & Mask;
+
+	// Bounded, so that a full index can not make a lookup of a missing key spin forever
+	for( size_t Probe = 0; Probe < SlotCount; ++Probe, Index = ( Index + 1 ) & Mask )
+	{
+		std::atomic< uint32_t >& rSlot  = pSlots[ Index ];
+		const uint32_t           Offset = rSlot.load( std::memory_order_acquire );
+
+		if( Offset == 0 || KeyAt( Offset ) == Key )
+			return &rSlot;
+	}
+
+	return nullptr;
+
+} // FindSlot
+
+//////////////////////////////////////////////////////////////////////////
+
+xyPreferencesImpl::View& xyPreferencesImpl::Acquire( void )
+{
+	for( const std::unique_ptr< View >& rpView : Views )
+	{
+		if( rpView->pBase == nullptr )
+			return *rpView;
+	}
+
+	return *Views.emplace_back( std::make_unique< View >() );
+
+} // Acquire
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyPreferencesImpl::Retire( void )
+{
+	const View* pCurrent = &Current();
+
+	// The current view was published before this, so a reader that counts itself in from here on either sees that it is stale or is seen here
+	for( const std::unique_ptr< View >& rpView : Views )
+	{
+		if( rpView.get() != pCurrent && rpView->pBase && rpView->Readers.load( std::memory_order_seq_cst ) == 0 )
+			rpView->Unmap();
+	}
+
+} // Retire
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyPreferencesImpl::Open( void )
+{
+	View* pView = &Acquire();
+
+#if defined( XY_OS_WINDOWS )
+
+	const std::wstring UnicodePath = xyUnicode( Path );
+
+	// Sharing deletion lets compaction replace the file while earlier views of it are still mapped
+	File = CreateFileW( UnicodePath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL );
+	if( File == INVALID_HANDLE_VALUE )
+		return false;
+
+	// Windows extends the file to the size of the mapping right away, so there is no need to grow it later
+	pView->Mapping = CreateFileMappingW( File, NULL, PAGE_READWRITE, static_cast< DWORD >( static_cast< uint64_t >( Capacity ) >> 32 ), static_cast< DWORD >( Capacity ), NULL );
+	if( pView->Mapping == NULL )
+		return false;
+
+	pView->pBase = static_cast< std::byte* >( MapViewOfFile( pView->Mapping, FILE_MAP_ALL_ACCESS, 0, 0, Capacity ) );
+	pView->Size  = Capacity;
+	FileSize     = Capacity;
+
+	// Leave the view free for reuse, without the mapping handle
+	if( pView->pBase == nullptr )
+	{
+		pView->Unmap();
+		return false;
+	}
+
+#else // XY_OS_WINDOWS
+
+	File = open( Path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600 );
+	if( File < 0 )
+		return false;
+
+	struct stat Status;
+	if( fstat( File, &Status ) != 0 )
+		return false;
+
+	// The whole capacity is mapped up front so that the mapping never has to move.
+	// Only the part that lies within the file is ever touched, and the file is grown before writing past its end.
+	void* pAddress = mmap( nullptr, Capacity, PROT_READ | PROT_WRITE, MAP_SHARED, File, 0 );
+	if( pAddress == MAP_FAILED )
+		return false;
+
+	pView->pBase = static_cast< std::byte* >( pAddress );
+	pView->Size  = Capacity;
+	FileSize     = std::min( static_cast< size_t >( Status.st_size ), Capacity );
+
+#endif // !XY_OS_WINDOWS
+
+	FileHeader& rHeader = *reinterpret_cast< FileHeader* >( pView->pBase );
+
+	if( FileSize < sizeof( FileHeader ) || rHeader.Magic == 0 )
+	{
+		if( !Grow( sizeof( FileHeader ) ) )
+			return false;
+
+		rHeader = { .Magic=Magic, .Version=Version, .Reserved=0 };
+	}
+	else if( rHeader.Magic != Magic || rHeader.Version != Version )
+	{
+		return false;
+	}
+
+	Load( *pView );
+
+	pReaderView.store( pView, std::memory_order_seq_cst );
+	Retire();
+
+	return true;
+
+} // Open
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyPreferencesImpl::CloseFile( void )
+{
+
+#if defined( XY_OS_WINDOWS )
+
+	if( File != INVALID_HANDLE_VALUE )
+		CloseHandle( File );
+
+	File = INVALID_HANDLE_VALUE;
+
+#else // XY_OS_WINDOWS
+
+	if( File >= 0 )
+		close( File );
+
+	File = -1;
+
+#endif // !XY_OS_WINDOWS
+
+} // CloseFile
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyPreferencesImpl::Grow( size_t Size )
+{
+	if( Size <= FileSize )
+		return true;
+
+	if( Size > Capacity )
+		return false;
+
+#if !defined( XY_OS_WINDOWS )
+
+	const size_t NewSize = std::min( ( Size + GrowthIncrement - 1 ) / GrowthIncrement * GrowthIncrement, Capacity );
+	if( ftruncate( File, static_cast< off_t >( NewSize ) ) != 0 )
+		return false;
+
+	FileSize = NewSize;
+
+#endif // !XY_OS_WINDOWS
+
+	return true;
+
+} // Grow
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyPreferencesImpl::Load( View& rView )
+{
+	// The log may have been written with a larger capacity than this one, so the index is sized after the records it holds as well
+	size_t RecordCount = 0;
+	for( size_t Offset = sizeof( FileHeader ); Offset + sizeof( RecordHeader ) <= FileSize && rView.HeaderAt( static_cast< uint32_t >( Offset ) ).KeySize != 0; ++RecordCount )
+		Offset += RecordSize( rView.HeaderAt( static_cast< uint32_t >( Offset ) ).KeySize, rView.HeaderAt( static_cast< uint32_t >( Offset ) ).ValueSize );
+
+	rView.SlotCount = std::bit_ceil( std::max< size_t >( { Capacity / 64, RecordCount * 2, 1024 } ) );
+	rView.pSlots    = std::make_unique< std::atomic< uint32_t >[] >( rView.SlotCount );
+	UsedSlots       = 0;
+	DeadBytes       = 0;
+
+	size_t Offset = sizeof( FileHeader );
+
+	while( Offset + sizeof( RecordHeader ) <= FileSize )
+	{
+		const RecordHeader& rHeader = rView.HeaderAt( static_cast< uint32_t >( Offset ) );
+		if( rHeader.KeySize == 0 )
+			break;
+
+		const size_t Size = RecordSize( rHeader.KeySize, rHeader.ValueSize );
+		if( Size > FileSize - Offset )
+			break;
+
+		// A record that fails its checksum was torn by a crash. Everything from here on is discarded.
+		const std::span< const std::byte > Checked( rView.pBase + Offset + sizeof( uint32_t ), sizeof( RecordHeader ) - sizeof( uint32_t ) + rHeader.KeySize + rHeader.ValueSize );
+		if( xyCRC32( 0, Checked ) != rHeader.Checksum )
+			break;
+
+		// Tombstones are dropped by compaction, and so are the records they replace. A replaced tombstone has been counted already.
+		std::atomic< uint32_t >& rSlot = *rView.FindSlot( rView.KeyAt( static_cast< uint32_t >( Offset ) ) );
+		if( const uint32_t Previous = rSlot.load( std::memory_order_relaxed ); Previous == 0 )               ++UsedSlots;
+		else if( !( rView.HeaderAt( Previous ).Flags & FlagTombstone ) )                                     DeadBytes += RecordSize( rView.HeaderAt( Previous ).KeySize, rView.HeaderAt( Previous ).ValueSize );
+
+		if( rHeader.Flags & FlagTombstone )
+			DeadBytes += Size;
+
+		rSlot.store( static_cast< uint32_t >( Offset ), std::memory_order_release );
+		Offset += Size;
+	}
+
+	WriteOffset = Offset;
+
+	// Wipe whatever a torn write left behind, so that it can not be mistaken for a record later on
+	std::fill( rView.pBase + WriteOffset, rView.pBase + FileSize, std::byte{ 0 } );
+
+} // Load
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyPreferencesImpl::Append( std::string_view Key, std::string_view Value, uint32_t Flags )
+{
+	const size_t Size = RecordSize( Key.size(), Value.size() );
+
+	// A record that would not even fit in an empty log must not cause a compaction on every attempt
+	if( sizeof( FileHeader ) + Size > Capacity )
+		return false;
+
+	// Keep the index at most three quarters full so that probe sequences stay short
+	bool NewKey = Current().FindSlot( Key )->load( std::memory_order_relaxed ) == 0;
+	if( WriteOffset + Size > Capacity || ( NewKey && ( UsedSlots + 1 ) * 4 > Current().SlotCount * 3 ) )
+	{
+		// Compaction only helps if there is something to reclaim
+		if( DeadBytes == 0 || !Compact() )
+			return false;
+
+		NewKey = Current().FindSlot( Key )->load( std::memory_order_relaxed ) == 0;
+		if( WriteOffset + Size > Capacity || ( NewKey && ( UsedSlots + 1 ) * 4 > Current().SlotCount * 3 ) )
+			return false;
+	}
+
+	if( !Grow( WriteOffset + Size ) )
+		return false;
+
+	View&         rView   = Current();
+	std::byte*    pRecord = rView.pBase + WriteOffset;
+	RecordHeader& rHeader = *reinterpret_cast< RecordHeader* >( pRecord );
+
+	std::copy( Key  .begin(), Key  .end(), reinterpret_cast< char* >( pRecord + sizeof( RecordHeader ) ) );
+	std::copy( Value.begin(), Value.end(), reinterpret_cast< char* >( pRecord + sizeof( RecordHeader ) + Key.size() ) );
+
+	rHeader.KeySize   = static_cast< uint32_t >( Key.size() );
+	rHeader.ValueSize = static_cast< uint32_t >( Value.size() );
+	rHeader.Flags     = Flags;
+	rHeader.Checksum  = xyCRC32( 0, std::span( pRecord + sizeof( uint32_t ), sizeof( RecordHeader ) - sizeof( uint32_t ) + Key.size() + Value.size() ) );
+
+	// Publish the record to readers only once it has been written in full
+	std::atomic< uint32_t >& rSlot = *rView.FindSlot( Key );
+	if( const uint32_t Previous = rSlot.load( std::memory_order_relaxed ); Previous == 0 ) ++UsedSlots;
+	else if( !( rView.HeaderAt( Previous ).Flags & FlagTombstone ) )                       DeadBytes += RecordSize( rView.HeaderAt( Previous ).KeySize, rView.HeaderAt( Previous ).ValueSize );
+
+	if( Flags & FlagTombstone )
+		DeadBytes += Size;
+
+	rSlot.store( static_cast< uint32_t >( WriteOffset ), std::memory_order_release );
+	WriteOffset += Size;
+
+	return true;
+
+} // Append
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyPreferencesImpl::Compact( void )
+{
+	const View& rView = Current();
+
+	// Build the compacted log in memory, in the order the records were originally written
+	std::vector< uint32_t > LiveRecords;
+	for( size_t i = 0; i < rView.SlotCount; ++i )
+	{
+		const uint32_t Offset = rView.pSlots[ i ].load( std::memory_order_relaxed );
+		if( Offset != 0 && !( rView.HeaderAt( Offset ).Flags & FlagTombstone ) )
+			LiveRecords.push_back( Offset );
+	}
+
+	std::sort( LiveRecords.begin(), LiveRecords.end() );
+
+	std::vector< std::byte > Image( rView.pBase, rView.pBase + sizeof( FileHeader ) );
+	for( uint32_t Offset : LiveRecords )
+		Image.insert( Image.end(), rView.pBase + Offset, rView.pBase + Offset + RecordSize( rView.HeaderAt( Offset ).KeySize, rView.HeaderAt( Offset ).ValueSize ) );
+
+	// Write it to a temporary file and swap it in atomically, so that a crash leaves either the old or the new log behind.
+	// The old file stays mapped for the readers that may still be looking at it. Only its name is taken over.
+	const std::string TemporaryPath = Path + ".tmp";
+
+#if defined( XY_OS_WINDOWS )
+
+	const std::wstring UnicodeTemporaryPath = xyUnicode( TemporaryPath );
+	const std::wstring UnicodePath          = xyUnicode( Path );
+	HANDLE             TemporaryFile        = CreateFileW( UnicodeTemporaryPath.c_str(), GENERIC_WRITE | DELETE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL );
+	if( TemporaryFile == INVALID_HANDLE_VALUE )
+		return false;
+
+	// Replacing a file that is still open requires POSIX semantics, which were added in Windows 10 version 1607
+	std::vector< std::byte > RenameBuffer( sizeof( FILE_RENAME_INFO ) + UnicodePath.size() * sizeof( WCHAR ) );
+	FILE_RENAME_INFO&        rRename = *reinterpret_cast< FILE_RENAME_INFO* >( RenameBuffer.data() );
+	rRename.Flags                    = FILE_RENAME_FLAG_REPLACE_IF_EXISTS | FILE_RENAME_FLAG_POSIX_SEMANTICS;
+	rRename.FileNameLength           = static_cast< DWORD >( UnicodePath.size() * sizeof( WCHAR ) );
+	std::copy( UnicodePath.begin(), UnicodePath.end(), rRename.FileName );
+
+	DWORD      Written;
+	const bool Success = WriteFile( TemporaryFile, Image.data(), static_cast< DWORD >( Image.size() ), &Written, NULL ) && FlushFileBuffers( TemporaryFile )
+	                  && SetFileInformationByHandle( TemporaryFile, FileRenameInfoEx, &rRename, static_cast< DWORD >( RenameBuffer.size() ) );
+	CloseHandle( TemporaryFile );
+
+	if( !Success )
+	{
+		DeleteFileW( UnicodeTemporaryPath.c_str() );
+		return false;
+	}
+
+#else // XY_OS_WINDOWS
+
+	const int TemporaryFile = open( TemporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600 );
+	if( TemporaryFile < 0 )
+		return false;
+
+	const bool Success = write( TemporaryFile, Image.data(), Image.size() ) == static_cast< ssize_t >( Image.size() ) && fsync( TemporaryFile ) == 0;
+	close( TemporaryFile );
+
+	if( !Success || rename( TemporaryPath.c_str(), Path.c_str() ) != 0 )
+	{
+		unlink( TemporaryPath.c_str() );
+		return false;
+	}
+
+#endif // !XY_OS_WINDOWS
+
+	CloseFile();
+
+	return Open();
+
+} // Compact
+
+//////////////////////////////////////////////////////////////////////////
+
+static std::string xyGetPreferencesPath( std::string_view Name )
+{
+#if defined( XY_OS_WINDOWS )
+	if( Name.size() > 1 && Name[ 1 ] == ':' )
+#else // XY_OS_WINDOWS
+	if( Name.starts_with( '/' ) )
+#endif // !XY_OS_WINDOWS
+		return std::string( Name );
+
+	std::string Directory;
+
+#if defined( XY_OS_WINDOWS )
+
+	CHAR Buffer[ MAX_PATH ];
+	if( GetEnvironmentVariableA( "APPDATA", Buffer, static_cast< DWORD >( std::size( Buffer ) ) ) )
+		Directory = Buffer;
+
+#elif defined( XY_OS_MACOS ) || defined( XY_OS_IOS ) // XY_OS_WINDOWS
+
+	NSString* pDirectory = [ NSSearchPathForDirectoriesInDomains( NSApplicationSupportDirectory, NSUserDomainMask, YES ) firstObject ];
+	[ [ NSFileManager defaultManager ] createDirectoryAtPath:pDirectory withIntermediateDirectories:YES attributes:nil error:nil ];
+
+	Directory = [ pDirectory UTF8String ];
+
+#elif defined( XY_OS_ANDROID ) // XY_OS_MACOS || XY_OS_IOS
+
+	xyContext& rContext = xyGetContext();
+	Directory           = rContext.pPlatformImpl->pNativeActivity->internalDataPath;
+
+#else // XY_OS_ANDROID
+
+	if( const char* pConfigHome = getenv( "XDG_CONFIG_HOME" ); pConfigHome && *pConfigHome )
+		Directory = pConfigHome;
+	else if( const char* pHome = getenv( "HOME" ) )
+		Directory = std::string( pHome ) + "/.config";
+
+	mkdir( Directory.c_str(), 0700 );
+
+#endif // !XY_OS_WINDOWS && !XY_OS_MACOS && !XY_OS_IOS && !XY_OS_ANDROID
+
+	if( Directory.empty() )
+		return std::string( Name );
+
+	return Directory.append( 1, '/' ).append( Name ).append( ".prefs" );
+
+} // xyGetPreferencesPath
+
+//////////////////////////////////////////////////////////////////////////
+
+xyPreferences xyOpenPreferences( std::string_view Name, size_t Capacity )
+{
+	auto pImpl      = std::make_shared< xyPreferencesImpl >();
+	pImpl->Path     = xyGetPreferencesPath( Name );
+	pImpl->Capacity = std::clamp< size_t >( Capacity, 4096, UINT32_MAX );
+
+	if( !pImpl->Open() )
+		return { };
+
+	return { .pImpl=std::move( pImpl ) };
+
+} // xyOpenPreferences
+
+//////////////////////////////////////////////////////////////////////////
+
+xyPreferenceValue::xyPreferenceValue( xyPreferenceValue&& rrOther ) noexcept
+	: Value   ( std::exchange( rrOther.Value,    { } ) )
+	, pReaders( std::exchange( rrOther.pReaders, nullptr ) )
+{
+} // xyPreferenceValue
+
+//////////////////////////////////////////////////////////////////////////
+
+xyPreferenceValue::~xyPreferenceValue( void )
+{
+	if( pReaders )
+		pReaders->fetch_sub( 1, std::memory_order_release );
+
+} // ~xyPreferenceValue
+
+//////////////////////////////////////////////////////////////////////////
+
+xyPreferenceValue& xyPreferenceValue::operator=( xyPreferenceValue&& rrOther ) noexcept
+{
+	if( this != &rrOther )
+	{
+		this->~xyPreferenceValue();
+
+		Value    = std::exchange( rrOther.Value,    { } );
+		pReaders = std::exchange( rrOther.pReaders, nullptr );
+	}
+
+	return *this;
+
+} // operator=
+
+//////////////////////////////////////////////////////////////////////////
+
+xyPreferenceValue xyGetPreference( const xyPreferences& rPreferences, std::string_view Key )
+{
+	if( !rPreferences )
+		return { };
+
+	xyPreferencesImpl&       rImpl = *rPreferences.pImpl;
+	xyPreferencesImpl::View* pView = rImpl.pReaderView.load( std::memory_order_seq_cst );
+
+	// Count in before using the view. If compaction replaced it in the meantime, it may already be on its way to being unmapped.
+	for( ;; )
+	{
+		pView->Readers.fetch_add( 1, std::memory_order_seq_cst );
+
+		xyPreferencesImpl::View* pLatest = rImpl.pReaderView.load( std::memory_order_seq_cst );
+		if( pLatest == pView )
+			break;
+
+		pView->Readers.fetch_sub( 1, std::memory_order_release );
+		pView = pLatest;
+	}
+
+	const std::atomic< uint32_t >* pSlot  = pView->FindSlot( Key );
+	const uint32_t                 Offset = pSlot ? pSlot->load( std::memory_order_acquire ) : 0;
+
+	if( Offset == 0 || ( pView->HeaderAt( Offset ).Flags & xyPreferencesImpl::FlagTombstone ) )
+	{
+		pView->Readers.fetch_sub( 1, std::memory_order_release );
+		return { };
+	}
+
+	xyPreferenceValue Result;
+	Result.Value    = pView->ValueAt( Offset );
+	Result.pReaders = &pView->Readers;
+
+	return Result;
+
+} // xyGetPreference
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xySetPreference( const xyPreferences& rPreferences, std::string_view Key, std::string_view Value )
+{
+	if( !rPreferences || Key.empty() )
+		return false;
+
+	xyPreferencesImpl& rImpl = *rPreferences.pImpl;
+	std::lock_guard    Lock( rImpl.WriteMutex );
+
+	return rImpl.Append( Key, Value, 0x0 );
+
+} // xySetPreference
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyRemovePreference( const xyPreferences& rPreferences, std::string_view Key )
+{
+	if( !xyGetPreference( rPreferences, Key ) )
+		return false;
+
+	xyPreferencesImpl& rImpl = *rPreferences.pImpl;
+	std::lock_guard    Lock( rImpl.WriteMutex );
+
+	return rImpl.Append( Key, { }, xyPreferencesImpl::FlagTombstone );
+
+} // xyRemovePreference
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyCompactPreferences( const xyPreferences& rPreferences )
+{
+	if( !rPreferences )
+		return false;
+
+	xyPreferencesImpl& rImpl = *rPreferences.pImpl;
+	std::lock_guard    Lock( rImpl.WriteMutex );
+
+	return rImpl.Compact();
+
+} // xyCompactPreferences
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyFlushPreferences( const xyPreferences& rPreferences )
+{
+	if( !rPreferences )
+		return;
+
+	xyPreferencesImpl& rImpl = *rPreferences.pImpl;
+	std::lock_guard    Lock( rImpl.WriteMutex );
+
+#if defined( XY_OS_WINDOWS )
+	FlushViewOfFile( rImpl.Current().pBase, rImpl.WriteOffset );
+	FlushFileBuffers( rImpl.File );
+#else // XY_OS_WINDOWS
+	msync( rImpl.Current().pBase, rImpl.WriteOffset, MS_SYNC );
+#endif // !XY_OS_WINDOWS
+
+} // xyFlushPreferences
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyLogRecordHeader
+{
+	uint32_t    ArgumentsSize; // Records are padded to keep them 8-byte aligned, so their size is rounded up from this
+	xyLogLevel  Level;
+	int64_t     Timestamp;     // Nanoseconds on the steady clock
+	const char* pFormat;       // nullptr for the padding that fills the end of the buffer before it wraps around
+
+	uint32_t Size( void ) const { return ( sizeof( xyLogRecordHeader ) + ArgumentsSize + 7 ) & ~uint32_t( 7 ); }
+
+}; // xyLogRecordHeader
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyLogBuffer
+{
+	explicit xyLogBuffer( size_t Size, uint32_t ThreadIndex ) : pData( std::make_unique< std::byte[] >( Size ) ), Size( Size ), ThreadIndex( ThreadIndex ) { }
+
+	std::unique_ptr< std::byte[] >        pData;
+	size_t                                Size;
+	uint32_t                              ThreadIndex;
+	alignas( 64 ) std::atomic< uint64_t > Head        = 0; // Written by the background thread
+	alignas( 64 ) std::atomic< uint64_t > Tail        = 0; // Written by the owning thread
+	uint64_t                              CachedHead  = 0;
+	uint64_t                              PendingTail = 0;
+	std::atomic< bool >                   Retired     = false;
+
+}; // xyLogBuffer
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyLogger
+{
+	struct Entry
+	{
+		int64_t                      Timestamp;
+		xyLogLevel                   Level;
+		uint32_t                     ThreadIndex;
+		const char*                  pFormat;
+		std::span< const std::byte > Arguments;
+
+	}; // Entry
+
+	static constexpr uint32_t FileMagic   = 0x474C5958; // "XYLG"
+	static constexpr uint32_t FileVersion = 1;
+
+	~xyLogger( void ) { Stop(); }
+
+	void Stop ( void );
+	void Run  ( void );
+	void Drain( void );
+	void Write( const Entry& rEntry );
+
+	std::atomic< bool >                             Running       = false;
+	std::atomic< xyLogLevel >                       Level         = xyLogLevel::Debug;
+	std::atomic< uint64_t >                         Dropped       = 0;
+	std::atomic< uint64_t >                         FlushRequest  = 0;
+	uint64_t                                        FlushComplete = 0;
+	uint32_t                                        Sinks         = 0;
+	xyLogFormat                                     FileFormat    = xyLogFormat::Text;
+	size_t                                          BufferSize    = 0;
+	uint32_t                                        ThreadCount   = 0;
+	int64_t                                         StartTime     = 0;
+	std::FILE*                                      pFile         = nullptr;
+	std::thread                                     Thread;
+	std::mutex                                      Mutex;
+	std::condition_variable                         Condition;
+	std::vector< std::shared_ptr< xyLogBuffer > >   Buffers;
+	std::vector< std::shared_ptr< xyLogBuffer > >   DrainBuffers; // Reused between passes, as are the members below
+	std::vector< uint64_t >                         DrainHeads;
+	std::vector< Entry >                            Entries;
+	std::unordered_map< const char*, uint32_t >     FormatIds;
+	std::string                                     Line;
+	std::vector< std::byte >                        Record;
+
+}; // xyLogger
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyLogThread
+{
+	~xyLogThread( void ) { if( pBuffer ) pBuffer->Retired.store( true, std::memory_order_release ); }
+
+	std::shared_ptr< xyLogBuffer > pBuffer;
+
+}; // xyLogThread
+
+static thread_local xyLogThread xyThisThreadLog;
+
+//////////////////////////////////////////////////////////////////////////
+
+static xyLogger& xyGetLogger( void )
+{
+	static xyLogger Logger;
+	return Logger;
+
+} // xyGetLogger
+
+//////////////////////////////////////////////////////////////////////////
+
+static int64_t xyGetLogTimestamp( void )
+{
+	return std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+
+} // xyGetLogTimestamp
+
+//////////////////////////////////////////////////////////////////////////
+
+static void xyFormatLogMessage( std::string& rOut, const char* pFormat, std::span< const std::byte > Arguments )
+{
+	char Buffer[ 256 ];
+
+	while( *pFormat )
+	{
+		const char* pSpecifier = std::strchr( pFormat, '%' );
+		if( pSpecifier == nullptr )
+		{
+			rOut.append( pFormat );
+			break;
+		}
+
+		rOut.append( pFormat, pSpecifier );
+
+		if( pSpecifier[ 1 ] == '%' )
+		{
+			rOut.push_back( '%' );
+			pFormat = pSpecifier + 2;
+			continue;
+		}
+
+		// Keep the flags, width and precision, but drop the length modifier since every argument was widened to 64 bits
+		const char* pEnd = pSpecifier + 1 + std::strspn( pSpecifier + 1, "-+ #0123456789." );
+		const char* pConversion = pEnd + std::strspn( pEnd, "hljztL" );
+		if( *pConversion == '\0' || Arguments.empty() )
+		{
+			rOut.append( pSpecifier, pConversion );
+			pFormat = pConversion;
+			continue;
+		}
+
+		std::string   Specifier( pSpecifier, pEnd );
+		xyLogArgument Type = static_cast< xyLogArgument >( Arguments[ 0 ] );
+		uint64_t      Value;
+		std::memcpy( &Value, Arguments.data() + 1, sizeof( Value ) );
+		int           Length;
+
+		switch( Type )
+		{
+			case xyLogArgument::String:
+			{
+				const uint32_t Size = static_cast< uint32_t >( Value );
+				if( Specifier.find( '.' ) == std::string::npos )
+					Specifier.append( ".*" );
+				Specifier.push_back( 's' );
+
+				const int Precision = Specifier.ends_with( ".*s" ) ? static_cast< int >( Size ) : std::min( std::atoi( Specifier.c_str() + Specifier.find( '.' ) + 1 ), static_cast< int >( Size ) );
+				Specifier.replace( Specifier.find( '.' ), Specifier.size() - Specifier.find( '.' ), ".*s" );
+				Length    = std::snprintf( Buffer, sizeof( Buffer ), Specifier.c_str(), Precision, reinterpret_cast< const char* >( Arguments.data() + 1 + sizeof( uint32_t ) ) );
+				Arguments = Arguments.subspan( 1 + sizeof( uint32_t ) + Size );
+
+				if( Length >= static_cast< int >( sizeof( Buffer ) ) )
+				{
+					const size_t Offset = rOut.size();
+					rOut.resize( Offset + Length + 1 );
+					std::snprintf( rOut.data() + Offset, Length + 1, Specifier.c_str(), Precision, reinterpret_cast< const char* >( Arguments.data() - Size ) );
+					rOut.pop_back();
+					Length = -1;
+				}
+			} break;
+
+			case xyLogArgument::Floating:
+			{
+				double Floating;
+				std::memcpy( &Floating, &Value, sizeof( Floating ) );
+				Specifier.push_back( std::strchr( "fFeEgGaA", *pConversion ) ? *pConversion : 'g' );
+				Length = std::snprintf( Buffer, sizeof( Buffer ), Specifier.c_str(), Floating );
+			} break;
+
+			case xyLogArgument::Pointer:
+			{
+				Specifier.push_back( 'p' );
+				Length = std::snprintf( Buffer, sizeof( Buffer ), Specifier.c_str(), reinterpret_cast< void* >( static_cast< uintptr_t >( Value ) ) );
+			} break;
+
+			default:
+			{
+				if( std::strchr( "fFeEgGaA", *pConversion ) )
+				{
+					Specifier.push_back( *pConversion );
+					Length = std::snprintf( Buffer, sizeof( Buffer ), Specifier.c_str(), Type == xyLogArgument::Signed ? static_cast< double >( static_cast< int64_t >( Value ) ) : static_cast< double >( Value ) );
+				}
+				else if( *pConversion == 'c' )
+				{
+					Specifier.push_back( 'c' );
+					Length = std::snprintf( Buffer, sizeof( Buffer ), Specifier.c_str(), static_cast< int >( Value ) );
+				}
+				else
+				{
+					Specifier.append( "ll" );
+					Specifier.push_back( std::strchr( "diouxX", *pConversion ) ? *pConversion : ( Type == xyLogArgument::Signed ? 'd' : 'u' ) );
+					Length = std::snprintf( Buffer, sizeof( Buffer ), Specifier.c_str(), static_cast< long long >( Value ) );
+				}
+			} break;
+		}
+
+		if( Type != xyLogArgument::String )
+			Arguments = Arguments.subspan( 1 + sizeof( uint64_t ) );
+
+		if( Length > 0 )
+			rOut.append( Buffer, std::min< size_t >( Length, sizeof( Buffer ) - 1 ) );
+
+		pFormat = pConversion + 1;
+	}
+
+} // xyFormatLogMessage
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyGetLogConversions( const char* pFormat, std::span< char > Conversions )
+{
+	// Walks the specifiers the same way as xyFormatLogMessage
+	size_t Index = 0;
+
+	while( Index < Conversions.size() )
+	{
+		const char* pSpecifier = std::strchr( pFormat, '%' );
+		if( pSpecifier == nullptr )
+			break;
+
+		if( pSpecifier[ 1 ] == '%' )
+		{
+			pFormat = pSpecifier + 2;
+			continue;
+		}
+
+		const char* pEnd        = pSpecifier + 1 + std::strspn( pSpecifier + 1, "-+ #0123456789." );
+		const char* pConversion = pEnd + std::strspn( pEnd, "hljztL" );
+		if( *pConversion == '\0' )
+			break;
+
+		Conversions[ Index++ ] = *pConversion;
+		pFormat                = pConversion + 1;
+	}
+
+} // xyGetLogConversions
+
+//////////////////////////////////////////////////////////////////////////
+
+static void xyFormatLogLine( std::string& rOut, int64_t Timestamp, xyLogLevel Level, uint32_t ThreadIndex, const char* pFormat, std::span< const std::byte > Arguments )
+{
+	char Prefix[ 64 ];
+	std::snprintf( Prefix, sizeof( Prefix ), "[%12.6f] [%c] [%u] ", static_cast< double >( Timestamp ) / 1e9, "DIWE"[ static_cast< size_t >( Level ) & 3 ], ThreadIndex );
+
+	rOut.append( Prefix );
+	xyFormatLogMessage( rOut, pFormat, Arguments );
+	rOut.push_back( '\n' );
+
+} // xyFormatLogLine
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyLogger::Stop( void )
+{
+	if( !Thread.joinable() )
+		return;
+
+	{
+		std::lock_guard Lock( Mutex );
+		Running.store( false, std::memory_order_relaxed );
+	}
+
+	Condition.notify_all();
+	Thread.join();
+
+	if( pFile )
+	{
+		std::fclose( pFile );
+		pFile = nullptr;
+	}
+
+} // Stop
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyLogger::Run( void )
+{
+	for( ;; )
+	{
+		uint64_t Flush;
+		bool     Stopping;
+
+		{
+			// Producers never signal, so that logging stays free of system calls. The buffers are polled instead.
+			std::unique_lock Lock( Mutex );
+			Condition.wait_for( Lock, std::chrono::milliseconds( 10 ), [ this ]{ return !Running.load( std::memory_order_relaxed ) || FlushRequest.load( std::memory_order_relaxed ) != FlushComplete; } );
+
+			Flush    = FlushRequest.load( std::memory_order_relaxed );
+			Stopping = !Running.load( std::memory_order_relaxed );
+		}
+
+		Drain();
+
+		{
+			std::lock_guard Lock( Mutex );
+			FlushComplete = Flush;
+		}
+
+		Condition.notify_all();
+
+		if( Stopping )
+			break;
+	}
+
+} // Run
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyLogger::Drain( void )
+{
+	{
+		std::lock_guard Lock( Mutex );
+		DrainBuffers.assign( Buffers.begin(), Buffers.end() );
+	}
+
+	Entries.clear();
+	DrainHeads.resize( DrainBuffers.size() );
+
+	for( size_t i = 0; i < DrainBuffers.size(); ++i )
+	{
+		xyLogBuffer&   rBuffer = *DrainBuffers[ i ];
+		uint64_t       Head    = rBuffer.Head.load( std::memory_order_relaxed );
+		const uint64_t Tail    = rBuffer.Tail.load( std::memory_order_acquire );
+
+		while( Head < Tail )
+		{
+			const size_t Offset = Head & ( rBuffer.Size - 1 );
+			if( rBuffer.Size - Offset < sizeof( xyLogRecordHeader ) )
+			{
+				Head += rBuffer.Size - Offset;
+				continue;
+			}
+
+			const xyLogRecordHeader& rHeader = *reinterpret_cast< const xyLogRecordHeader* >( rBuffer.pData.get() + Offset );
+			if( rHeader.pFormat )
+				Entries.push_back( { rHeader.Timestamp, rHeader.Level, rBuffer.ThreadIndex, rHeader.pFormat, std::span( rBuffer.pData.get() + Offset + sizeof( rHeader ), rHeader.ArgumentsSize ) } );
+
+			Head += rHeader.Size();
+		}
+
+		DrainHeads[ i ] = Head;
+	}
+
+	// Interleave the messages of all threads in the order they were logged
+	std::stable_sort( Entries.begin(), Entries.end(), []( const Entry& rLeft, const Entry& rRight ) { return rLeft.Timestamp < rRight.Timestamp; } );
+
+	for( const Entry& rEntry : Entries )
+		Write( rEntry );
+
+	if( const uint64_t DroppedCount = Dropped.exchange( 0, std::memory_order_relaxed ) )
+	{
+		std::byte Encoded[ 1 + sizeof( uint64_t ) ];
+		xyEncodeLogArgument( Encoded, DroppedCount, 'u' );
+
+		Write( { xyGetLogTimestamp(), xyLogLevel::Warning, 0, "Dropped %llu messages because the log buffer was full", Encoded } );
+	}
+
+	for( size_t i = 0; i < DrainBuffers.size(); ++i )
+		DrainBuffers[ i ]->Head.store( DrainHeads[ i ], std::memory_order_release );
+
+	if( Sinks & XY_LOG_SINK_STDOUT ) std::fflush( stdout );
+	if( pFile )                      std::fflush( pFile );
+
+	// Forget the buffers of threads that have exited, once they have been drained
+	{
+		std::lock_guard Lock( Mutex );
+		std::erase_if( Buffers, []( const std::shared_ptr< xyLogBuffer >& rBuffer ) { return rBuffer->Retired.load( std::memory_order_acquire ) && rBuffer->Head.load( std::memory_order_relaxed ) == rBuffer->Tail.load( std::memory_order_relaxed ); } );
+	}
+
+	DrainBuffers.clear();
+
+} // Drain
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyLogger::Write( const Entry& rEntry )
+{
+	const int64_t Timestamp = rEntry.Timestamp - StartTime;
+
+	if( Sinks & ( XY_LOG_SINK_STDOUT | XY_LOG_SINK_LOGCAT ) || ( pFile && FileFormat == xyLogFormat::Text ) )
+	{
+		Line.clear();
+		xyFormatLogLine( Line, Timestamp, rEntry.Level, rEntry.ThreadIndex, rEntry.pFormat, rEntry.Arguments );
+
+		if( Sinks & XY_LOG_SINK_STDOUT )                  std::fwrite( Line.data(), 1, Line.size(), stdout );
+		if( pFile && FileFormat == xyLogFormat::Text ) std::fwrite( Line.data(), 1, Line.size(), pFile );
+
+	#if defined( XY_OS_ANDROID )
+		if( Sinks & XY_LOG_SINK_LOGCAT )
+		{
+			constexpr int Priorities[] = { ANDROID_LOG_DEBUG, ANDROID_LOG_INFO, ANDROID_LOG_WARN, ANDROID_LOG_ERROR };
+
+			// Logcat keeps its own timestamps and thread ids, so only pass along the message itself
+			Line.clear();
+			xyFormatLogMessage( Line, rEntry.pFormat, rEntry.Arguments );
+			__android_log_write( Priorities[ static_cast< size_t >( rEntry.Level ) ], "xy", Line.c_str() );
+		}
+	#endif // XY_OS_ANDROID
+	}
+
+	if( pFile && FileFormat == xyLogFormat::Binary )
+	{
+		auto Append = [ this ]( const auto Value ) { Record.insert( Record.end(), reinterpret_cast< const std::byte* >( &Value ), reinterpret_cast< const std::byte* >( &Value ) + sizeof( Value ) ); };
+
+		Record.clear();
+
+		// Each format string is written once, the first time it is used, and referred to by index after that
+		auto [ Iterator, Inserted ] = FormatIds.try_emplace( rEntry.pFormat, static_cast< uint32_t >( FormatIds.size() ) );
+		if( Inserted )
+		{
+			const std::string_view Format( rEntry.pFormat );
+
+			Append( uint8_t( 0 ) );
+			Append( Iterator->second );
+			Append( static_cast< uint32_t >( Format.size() ) );
+			Record.insert( Record.end(), reinterpret_cast< const std::byte* >( Format.data() ), reinterpret_cast< const std::byte* >( Format.data() + Format.size() ) );
+		}
+
+		Append( uint8_t( 1 ) );
+		Append( static_cast< uint8_t >( rEntry.Level ) );
+		Append( rEntry.ThreadIndex );
+		Append( Iterator->second );
+		Append( Timestamp );
+		Append( static_cast< uint32_t >( rEntry.Arguments.size() ) );
+		Record.insert( Record.end(), rEntry.Arguments.begin(), rEntry.Arguments.end() );
+
+		std::fwrite( Record.data(), 1, Record.size(), pFile );
+	}
+
+} // Write
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyStartLogging( uint32_t Sinks, std::string_view FilePath, xyLogFormat FileFormat, size_t ThreadBufferSize )
+{
+	xyLogger& rLogger = xyGetLogger();
+	if( rLogger.Thread.joinable() )
+		return false;
+
+	if( Sinks & XY_LOG_SINK_FILE )
+	{
+		rLogger.pFile = std::fopen( std::string( FilePath ).c_str(), FileFormat == xyLogFormat::Binary ? "wb" : "w" );
+		if( rLogger.pFile == nullptr )
+			return false;
+
+		if( FileFormat == xyLogFormat::Binary )
+		{
+			const uint32_t Header[ 4 ] = { xyLogger::FileMagic, xyLogger::FileVersion, 0, 0 };
+			std::fwrite( Header, sizeof( Header ), 1, rLogger.pFile );
+		}
+	}
+
+	rLogger.Sinks      = Sinks;
+	rLogger.FileFormat = FileFormat;
+	rLogger.StartTime  = xyGetLogTimestamp();
+	rLogger.FormatIds.clear();
+
+	{
+		// Threads that logged before keep their buffers, so the size only applies to threads that have not logged yet
+		std::lock_guard Lock( rLogger.Mutex );
+		rLogger.BufferSize = std::bit_ceil( std::max< size_t >( ThreadBufferSize, 1024 ) );
+	}
+
+	rLogger.Running.store( true, std::memory_order_release );
+	rLogger.Thread = std::thread( &xyLogger::Run, &rLogger );
+
+	return true;
+
+} // xyStartLogging
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyStopLogging( void )
+{
+	xyGetLogger().Stop();
+
+} // xyStopLogging
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyFlushLog( void )
+{
+	xyLogger& rLogger = xyGetLogger();
+	if( !rLogger.Running.load( std::memory_order_acquire ) )
+		return;
+
+	std::unique_lock Lock( rLogger.Mutex );
+	const uint64_t   Request = rLogger.FlushRequest.fetch_add( 1, std::memory_order_relaxed ) + 1;
+
+	rLogger.Condition.notify_all();
+	rLogger.Condition.wait( Lock, [ & ]{ return rLogger.FlushComplete >= Request || !rLogger.Thread.joinable(); } );
+
+} // xyFlushLog
+
+//////////////////////////////////////////////////////////////////////////
+
+void xySetLogLevel( xyLogLevel Level )
+{
+	xyGetLogger().Level.store( Level, std::memory_order_relaxed );
+
+} // xySetLogLevel
+
+//////////////////////////////////////////////////////////////////////////
+
+std::string xyDecodeLog( std::span< const std::byte > Data )
+{
+	std::string                        Text;
+	std::vector< std::string >         Formats;
+	uint32_t                           Header[ 4 ];
+
+	if( Data.size() < sizeof( Header ) )
+		return Text;
+
+	std::memcpy( Header, Data.data(), sizeof( Header ) );
+	if( Header[ 0 ] != xyLogger::FileMagic || Header[ 1 ] != xyLogger::FileVersion )
+		return Text;
+
+	Data = Data.subspan( sizeof( Header ) );
+
+	auto Read = [ & ]( auto& rValue )
+	{
+		if( Data.size() < sizeof( rValue ) )
+			return false;
+
+		std::memcpy( &rValue, Data.data(), sizeof( rValue ) );
+		Data = Data.subspan( sizeof( rValue ) );
+		return true;
+	};
+
+	uint8_t Kind;
+	while( Read( Kind ) )
+	{
+		if( Kind == 0 )
+		{
+			uint32_t Id, Size;
+			if( !Read( Id ) || !Read( Size ) || Data.size() < Size )
+				break;
+
+			Formats.resize( std::max< size_t >( Formats.size(), Id + 1 ) );
+			Formats[ Id ].assign( reinterpret_cast< const char* >( Data.data() ), Size );
+			Data = Data.subspan( Size );
+		}
+		else
+		{
+			uint8_t  Level;
+			uint32_t ThreadIndex, FormatId, Size;
+			int64_t  Timestamp;
+			if( !Read( Level ) || !Read( ThreadIndex ) || !Read( FormatId ) || !Read( Timestamp ) || !Read( Size ) || Data.size() < Size || FormatId >= Formats.size() )
+				break;
+
+			xyFormatLogLine( Text, Timestamp, static_cast< xyLogLevel >( Level ), ThreadIndex, Formats[ FormatId ].c_str(), Data.first( Size ) );
+			Data = Data.subspan( Size );
+		}
+	}
+
+	return Text;
+
+} // xyDecodeLog
+
+//////////////////////////////////////////////////////////////////////////
+
+std::byte* xyBeginLogRecord( xyLogLevel Level, const char* pFormat, size_t ArgumentsSize )
+{
+	xyLogger& rLogger = xyGetLogger();
+	if( !rLogger.Running.load( std::memory_order_relaxed ) || Level < rLogger.Level.load( std::memory_order_relaxed ) )
+		return nullptr;
+
+	if( xyThisThreadLog.pBuffer == nullptr )
+	{
+		std::lock_guard Lock( rLogger.Mutex );
+		xyThisThreadLog.pBuffer = std::make_shared< xyLogBuffer >( rLogger.BufferSize, ++rLogger.ThreadCount );
+		rLogger.Buffers.push_back( xyThisThreadLog.pBuffer );
+	}
+
+	xyLogBuffer&   rBuffer    = *xyThisThreadLog.pBuffer;
+	const size_t   Size       = ( sizeof( xyLogRecordHeader ) + ArgumentsSize + 7 ) & ~size_t( 7 );
+	uint64_t       Tail       = rBuffer.Tail.load( std::memory_order_relaxed );
+	size_t         Offset     = Tail & ( rBuffer.Size - 1 );
+	const size_t   Contiguous = rBuffer.Size - Offset;
+	const size_t   Needed     = Size + ( Contiguous < Size ? Contiguous : 0 );
+
+	if( Tail + Needed - rBuffer.CachedHead > rBuffer.Size )
+	{
+		rBuffer.CachedHead = rBuffer.Head.load( std::memory_order_acquire );
+
+		if( Tail + Needed - rBuffer.CachedHead > rBuffer.Size )
+		{
+			rLogger.Dropped.fetch_add( 1, std::memory_order_relaxed );
+			return nullptr;
+		}
+	}
+
+	// Records are never split, so skip to the start of the buffer if this one does not fit before the end
+	if( Contiguous < Size )
+	{
+		if( Contiguous >= sizeof( xyLogRecordHeader ) )
+			*reinterpret_cast< xyLogRecordHeader* >( rBuffer.pData.get() + Offset ) = { .ArgumentsSize=static_cast< uint32_t >( Contiguous - sizeof( xyLogRecordHeader ) ), .Level=Level, .Timestamp=0, .pFormat=nullptr };
+
+		Tail  += Contiguous;
+		Offset = 0;
+	}
+
+	*reinterpret_cast< xyLogRecordHeader* >( rBuffer.pData.get() + Offset ) = { .ArgumentsSize=static_cast< uint32_t >( ArgumentsSize ), .Level=Level, .Timestamp=xyGetLogTimestamp(), .pFormat=pFormat };
+	rBuffer.PendingTail                                                   = Tail + Size;
+
+	return rBuffer.pData.get() + Offset + sizeof( xyLogRecordHeader );
+
+} // xyBeginLogRecord
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyEndLogRecord( void )
+{
+	xyLogBuffer& rBuffer = *xyThisThreadLog.pBuffer;
+	rBuffer.Tail.store( rBuffer.PendingTail, std::memory_order_release );
+
+} // xyEndLogRecord
+
+//////////////////////////////////////////////////////////////////////////
+
+static std::optional< float > xyGetHottestTemperature( void )
+{
+	std::optional< float > Hottest;
+
+	for( const xyThermalZone& rZone : xyGetThermalState().Zones )
+		Hottest = std::max( Hottest.value_or( rZone.Temperature ), rZone.Temperature );
+
+	return Hottest;
+
+} // xyGetHottestTemperature
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyPowerMonitor
+{
+	~xyPowerMonitor( void ) { Stop(); }
+
+	void              Stop    ( void );
+	void              Run     ( void );
+	xyPerformanceTier Evaluate( const xyPowerState& rState );
+
+	xyPowerPolicy                     Policy;
+	xyPowerCallback                   Callback    = nullptr;
+	void*                             pUserData   = nullptr;
+	std::atomic< xyPerformanceTier >  Tier        = xyPerformanceTier::Full;
+	std::atomic< float >              TickScale   = 1.0f; // Tick rate scale of the current tier, so that xyGetTickInterval does not have to read the policy
+	size_t                            ThermalTier = 0;
+	bool                              Stopping    = false;
+	std::thread                       Thread;
+	std::mutex                        Mutex;
+	std::condition_variable           Condition;
+
+}; // xyPowerMonitor
+
+//////////////////////////////////////////////////////////////////////////
+
+static xyPowerMonitor& xyGetPowerMonitor( void )
+{
+	static xyPowerMonitor PowerMonitor;
+	return PowerMonitor;
+
+} // xyGetPowerMonitor
+
+//////////////////////////////////////////////////////////////////////////
+
+xyPerformanceTier xyPowerMonitor::Evaluate( const xyPowerState& rState )
+{
+	size_t BatteryTier = 0;
+	if( rState.Battery && !rState.Battery.Charging )
+	{
+		for( uint8_t Percentage : Policy.BatteryPercentages )
+			BatteryTier += rState.Battery.CapacityPercentage <= Percentage;
+	}
+
+	// Drop a tier as soon as a threshold is reached, but only recover once the temperature is comfortably below it again
+	if( rState.Temperature )
+	{
+		size_t Reached = 0;
+		size_t Cooled  = 0;
+
+		for( float Temperature : Policy.Temperatures )
+		{
+			Reached += *rState.Temperature >= Temperature;
+			Cooled  += *rState.Temperature >  Temperature - Policy.TemperatureHysteresis;
+		}
+
+		ThermalTier = std::max( Reached, std::min( ThermalTier, Cooled ) );
+	}
+
+	return static_cast< xyPerformanceTier >( std::max( BatteryTier, ThermalTier ) );
+
+} // Evaluate
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyPowerMonitor::Run( void )
+{
+	std::unique_lock Lock( Mutex );
+	bool             First = true;
+
+	while( !Stopping )
+	{
+		Lock.unlock();
+
+		xyPowerState State = { .Battery=xyGetBatteryState(), .Temperature=xyGetHottestTemperature() };
+		State.Tier         = Evaluate( State );
+
+		if( First || State.Tier != Tier.load( std::memory_order_relaxed ) )
+		{
+			Tier     .store( State.Tier, std::memory_order_relaxed );
+			TickScale.store( Policy.TickRateScales[ static_cast< size_t >( State.Tier ) ], std::memory_order_relaxed );
+			xyGetFileIO().LimitWorkers( Policy.WorkerScales[ static_cast< size_t >( State.Tier ) ] );
+
+			if( Callback )
+				Callback( State, pUserData );
+
+			First = false;
+		}
+
+		Lock.lock();
+		Condition.wait_for( Lock, Policy.PollInterval, [ this ]{ return Stopping; } );
+	}
+
+} // Run
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyPowerMonitor::Stop( void )
+{
+	if( !Thread.joinable() )
+		return;
+
+	{
+		std::lock_guard Lock( Mutex );
+		Stopping = true;
+	}
+
+	Condition.notify_all();
+	Thread.join();
+
+	Tier     .store( xyPerformanceTier::Full, std::memory_order_relaxed );
+	TickScale.store( 1.0f, std::memory_order_relaxed );
+	xyGetFileIO().LimitWorkers( 1.0f );
+
+} // Stop
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyStartPowerPolicy( const xyPowerPolicy& Policy, xyPowerCallback Callback, void* pUserData )
+{
+	xyPowerMonitor& rMonitor = xyGetPowerMonitor();
+	if( rMonitor.Thread.joinable() )
+		return false;
+
+	rMonitor.Policy      = Policy;
+	rMonitor.Callback    = Callback;
+	rMonitor.pUserData   = pUserData;
+	rMonitor.ThermalTier = 0;
+	rMonitor.Stopping    = false;
+	rMonitor.Thread      = std::thread( &xyPowerMonitor::Run, &rMonitor );
+
+	return true;
+
+} // xyStartPowerPolicy
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyStopPowerPolicy( void )
+{
+	xyGetPowerMonitor().Stop();
+
+} // xyStopPowerPolicy
+
+//////////////////////////////////////////////////////////////////////////
+
+xyPerformanceTier xyGetPerformanceTier( void )
+{
+	return xyGetPowerMonitor().Tier.load( std::memory_order_relaxed );
+
+} // xyGetPerformanceTier
+
+//////////////////////////////////////////////////////////////////////////
+
+std::chrono::nanoseconds xyGetTickInterval( std::chrono::nanoseconds FullSpeedInterval )
+{
+	const float Scale = xyGetPowerMonitor().TickScale.load( std::memory_order_relaxed );
+
+	return std::chrono::nanoseconds( static_cast< int64_t >( FullSpeedInterval.count() / std::max( Scale, 0.01f ) ) );
+
+} // xyGetTickInterval
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyConfigurationBus
+{
+	void Start( void );
+	void Stop ( void );
+	void Run  ( void );
+	void Poll ( std::chrono::milliseconds Interval );
+	void Check( void );
+
+	std::mutex                                                        LifetimeMutex; // Held from counting the subscribers until the monitor has been started or stopped accordingly
+	std::mutex                                                        Mutex;
+	std::condition_variable                                           Condition;
+	std::vector< std::weak_ptr< xyConfigurationSubscriptionImpl > >   Subscribers;
+	std::vector< xyConfigurationEvent >                               Pending;
+	std::vector< xyConfigurationEvent >                               Delivering;
+	std::vector< std::shared_ptr< xyConfigurationSubscriptionImpl > > Recipients; // Kept alive until they have been called
+	std::thread                                                       Thread;
+	bool                                                              Stopping = false;
+
+	// The last known state, for platforms where a notification only says that something might have changed
+	xyTheme                                                           Theme;
+	xyInlineLanguage                                                  Language;
+	xySmallVector< xyInlineDisplayAdapter, 4 >                        Displays;
+
+#if defined( XY_OS_WINDOWS )
+	HWND                                                              Window    = NULL;
+#elif defined( XY_OS_LINUX ) // XY_OS_WINDOWS
+	int                                                               StopEvent = -1;
+#endif // XY_OS_LINUX
+
+}; // xyConfigurationBus
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyConfigurationSubscriptionImpl
+{
+	~xyConfigurationSubscriptionImpl( void );
+
+	xyConfigurationCallback Callback  = nullptr;
+	void*                   pUserData = nullptr;
+
+}; // xyConfigurationSubscriptionImpl
+
+//////////////////////////////////////////////////////////////////////////
+
+static xyConfigurationBus& xyGetConfigurationBus( void )
+{
+	// Never destroyed, since subscriptions held by other statics can be released after it at exit. The monitor stops along with the last subscription.
+	static xyConfigurationBus& rConfigurationBus = *new xyConfigurationBus;
+	return rConfigurationBus;
+
+} // xyGetConfigurationBus
+
+//////////////////////////////////////////////////////////////////////////
+
+xyConfigurationSubscriptionImpl::~xyConfigurationSubscriptionImpl( void )
+{
+	xyConfigurationBus& rBus = xyGetConfigurationBus();
+	std::lock_guard     LifetimeLock( rBus.LifetimeMutex );
+	bool                Last;
+
+	{
+		// This subscription has expired by now, as has any other that is being destroyed concurrently
+		std::lock_guard Lock( rBus.Mutex );
+		std::erase_if( rBus.Subscribers, []( const std::weak_ptr< xyConfigurationSubscriptionImpl >& rSubscriber ) { return rSubscriber.expired(); } );
+		Last = rBus.Subscribers.empty();
+	}
+
+	// Nothing is listening anymore, so there is no need to keep monitoring
+	if( Last )
+		rBus.Stop();
+
+} // ~xyConfigurationSubscriptionImpl
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyConfigurationBus::Check( void )
+{
+	xyInlineLanguage                           NewLanguage;
+	xySmallVector< xyInlineDisplayAdapter, 4 > NewDisplays;
+	const xyTheme                              NewTheme = xyGetPreferredTheme();
+
+	xyGetLanguage( NewLanguage );
+	xyGetDisplayAdapters( NewDisplays );
+
+	const bool DisplaysMatch = std::equal( NewDisplays.begin(), NewDisplays.end(), Displays.begin(), Displays.end(), []( const xyInlineDisplayAdapter& rLeft, const xyInlineDisplayAdapter& rRight )
+	{
+		return rLeft.Name == rRight.Name && std::memcmp( &rLeft.FullRect, &rRight.FullRect, sizeof( xyRect ) ) == 0 && std::memcmp( &rLeft.WorkRect, &rRight.WorkRect, sizeof( xyRect ) ) == 0;
+	} );
+
+	if( NewTheme != Theme )                               xyPostConfigurationChange( { .Type=xyConfigurationChange::Theme, .Theme=NewTheme } );
+	if( NewLanguage.LocaleName != Language.LocaleName )   xyPostConfigurationChange( { .Type=xyConfigurationChange::Language } );
+	if( !DisplaysMatch )                                  xyPostConfigurationChange( { .Type=xyConfigurationChange::Displays } );
+
+	Theme    = NewTheme;
+	Language = NewLanguage;
+	Displays = std::move( NewDisplays );
+
+} // Check
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyConfigurationBus::Poll( std::chrono::milliseconds Interval )
+{
+	std::unique_lock Lock( Mutex );
+
+	while( !Condition.wait_for( Lock, Interval, [ this ]{ return Stopping; } ) )
+	{
+		Lock.unlock();
+		Check();
+		Lock.lock();
+	}
+
+} // Poll
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyConfigurationBus::Run( void )
+{
+	if( xyBackend* pBackend = xyGetBackend() )
+	{
+		Poll( pBackend->GetPollInterval() );
+		return;
+	}
+
+#if defined( XY_OS_WINDOWS )
+
+	// Message-only windows don't receive broadcasts, so this has to be a regular top-level window. It is never shown.
+	const WNDCLASSEXW WindowClass = { .cbSize=sizeof( WNDCLASSEXW ), .lpfnWndProc=[]( HWND Window, UINT Message, WPARAM WParam, LPARAM LParam ) -> LRESULT
+	{
+		switch( Message )
+		{
+			case WM_SETTINGCHANGE:
+			case WM_DISPLAYCHANGE:
+			{
+				xyGetConfigurationBus().Check();
+			} break;
+
+			case WM_CLOSE:
+			{
+				PostQuitMessage( 0 );
+			} return 0;
+		}
+
+		return DefWindowProcW( Window, Message, WParam, LParam );
+
+	}, .hInstance=GetModuleHandleW( NULL ), .lpszClassName=L"xyConfiguration" };
+
+	RegisterClassExW( &WindowClass );
+
+	HWND NewWindow = CreateWindowExW( 0, WindowClass.lpszClassName, NULL, WS_OVERLAPPED, 0, 0, 0, 0, NULL, NULL, WindowClass.hInstance, NULL );
+
+	// Called on a thread pool thread whenever an interface is added, removed or changes its addresses
+	HANDLE NetworkNotification = NULL;
+	NotifyIpInterfaceChange( AF_UNSPEC, []( PVOID, PMIB_IPINTERFACE_ROW, MIB_NOTIFICATION_TYPE )
+	{
+		xyPostConfigurationChange( { .Type=xyConfigurationChange::Network } );
+
+	}, nullptr, FALSE, &NetworkNotification );
+
+	{
+		std::lock_guard Lock( Mutex );
+		Window = NewWindow;
+
+		if( Stopping && Window )
+			PostMessageW( Window, WM_CLOSE, 0, 0 );
+	}
+
+	MSG Message;
+	while( Window && GetMessageW( &Message, NULL, 0, 0 ) > 0 )
+	{
+		TranslateMessage( &Message );
+		DispatchMessageW( &Message );
+	}
+
+	if( NetworkNotification )
+		CancelMibChangeNotify2( NetworkNotification );
+
+	if( Window )
+		DestroyWindow( Window );
+
+#elif defined( XY_OS_LINUX ) // XY_OS_WINDOWS
+
+	// The kernel announces display hotplugs as uevents of the DRM subsystem
+	const int Socket = socket( AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT );
+	if( Socket < 0 )
+		return;
+
+	sockaddr_nl Address = { .nl_family=AF_NETLINK, .nl_pad=0, .nl_pid=0, .nl_groups=1 };
+	if( bind( Socket, reinterpret_cast< sockaddr* >( &Address ), sizeof( Address ) ) != 0 )
+	{
+		close( Socket );
+		return;
+	}
+
+	// Links and addresses coming and going are announced over rtnetlink
+	const int   RouteSocket  = socket( AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_ROUTE );
+	sockaddr_nl RouteAddress = { .nl_family=AF_NETLINK, .nl_pad=0, .nl_pid=0, .nl_groups=RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR };
+	if( RouteSocket >= 0 )
+		bind( RouteSocket, reinterpret_cast< sockaddr* >( &RouteAddress ), sizeof( RouteAddress ) );
+
+	pollfd PollFiles[ 3 ] = { { .fd=Socket, .events=POLLIN, .revents=0 }, { .fd=StopEvent, .events=POLLIN, .revents=0 }, { .fd=RouteSocket, .events=POLLIN, .revents=0 } };
+	char   Buffer[ 4096 ];
+
+	while( poll( PollFiles, 3, -1 ) >= 0 && !( PollFiles[ 1 ].revents & POLLIN ) )
+	{
+		if( PollFiles[ 2 ].revents & POLLIN )
+		{
+			// The contents do not matter, since xyGetNetworkInterfaces reads everything anew
+			while( recv( RouteSocket, Buffer, sizeof( Buffer ), MSG_DONTWAIT ) > 0 ) { }
+
+			xyPostConfigurationChange( { .Type=xyConfigurationChange::Network } );
+		}
+
+		const ssize_t Size = recv( Socket, Buffer, sizeof( Buffer ), MSG_DONTWAIT );
+		if( Size <= 0 )
+			continue;
+
+		// The message is a header followed by null-terminated KEY=VALUE pairs
+		for( std::string_view Message( Buffer, Size ); !Message.empty(); )
+		{
+			const std::string_view Pair = Message.substr( 0, Message.find( '\0' ) );
+			if( Pair == "SUBSYSTEM=drm" )
+			{
+				xyPostConfigurationChange( { .Type=xyConfigurationChange::Displays } );
+				break;
+			}
+
+			Message.remove_prefix( std::min( Pair.size() + 1, Message.size() ) );
+		}
+	}
+
+	if( RouteSocket >= 0 )
+		close( RouteSocket );
+
+	close( Socket );
+
+#elif defined( XY_OS_MACOS ) || defined( XY_OS_IOS ) // XY_OS_LINUX
+
+	Poll( std::chrono::seconds( 1 ) );
+
+#endif // XY_OS_MACOS || XY_OS_IOS
+
+} // Run
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyConfigurationBus::Start( void )
+{
+	if( Thread.joinable() )
+		return;
+
+#if !defined( XY_OS_WINDOWS ) && !defined( XY_OS_LINUX ) && !defined( XY_OS_MACOS ) && !defined( XY_OS_IOS )
+
+	// Android reports changes through onConfigurationChanged, so there is only something to monitor when a backend is installed
+	if( !xyGetBackend() )
+		return;
+
+#endif // !XY_OS_WINDOWS && !XY_OS_LINUX && !XY_OS_MACOS && !XY_OS_IOS
+
+	Theme    = xyGetPreferredTheme();
+	Stopping = false;
+
+	xyGetLanguage( Language );
+	xyGetDisplayAdapters( Displays );
+
+#if defined( XY_OS_LINUX )
+	StopEvent = eventfd( 0, EFD_CLOEXEC );
+#endif // XY_OS_LINUX
+
+	Thread = std::thread( &xyConfigurationBus::Run, this );
+
+} // Start
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyConfigurationBus::Stop( void )
+{
+	if( !Thread.joinable() )
+		return;
+
+	{
+		std::lock_guard Lock( Mutex );
+		Stopping = true;
+
+	#if defined( XY_OS_WINDOWS )
+		if( Window )
+			PostMessageW( Window, WM_CLOSE, 0, 0 );
+	#endif // XY_OS_WINDOWS
+	}
+
+#if defined( XY_OS_LINUX )
+	eventfd_write( StopEvent, 1 );
+#endif // XY_OS_LINUX
+
+	Condition.notify_all();
+	Thread.join();
+
+#if defined( XY_OS_WINDOWS )
+	Window = NULL;
+#elif defined( XY_OS_LINUX ) // XY_OS_WINDOWS
+	close( StopEvent );
+	StopEvent = -1;
+#endif // XY_OS_LINUX
+
+} // Stop
+
+//////////////////////////////////////////////////////////////////////////
+
+xyConfigurationSubscription xySubscribeConfigurationChanges( xyConfigurationCallback Callback, void* pUserData )
+{
+	xyConfigurationBus& rBus  = xyGetConfigurationBus();
+	auto                pImpl = std::make_shared< xyConfigurationSubscriptionImpl >();
+	pImpl->Callback           = Callback;
+	pImpl->pUserData          = pUserData;
+
+	std::lock_guard LifetimeLock( rBus.LifetimeMutex );
+	bool            First;
+
+	{
+		std::lock_guard Lock( rBus.Mutex );
+		rBus.Subscribers.push_back( pImpl );
+		First = rBus.Subscribers.size() == 1;
+	}
+
+	if( First )
+		rBus.Start();
+
+	return { .pImpl=std::move( pImpl ) };
+
+} // xySubscribeConfigurationChanges
+
+//////////////////////////////////////////////////////////////////////////
+
+size_t xyDispatchConfigurationChanges( bool Wait )
+{
+	xyConfigurationBus& rBus = xyGetConfigurationBus();
+
+	{
+		std::unique_lock Lock( rBus.Mutex );
+
+		if( Wait )
+			rBus.Condition.wait( Lock, [ & ]{ return !rBus.Pending.empty(); } );
+
+		std::swap( rBus.Pending, rBus.Delivering );
+
+		// Hold on to the subscribers, so that none of them can be destroyed while the lock is not held
+		for( const std::weak_ptr< xyConfigurationSubscriptionImpl >& rSubscriber : rBus.Subscribers )
+		{
+			if( auto pSubscriber = rSubscriber.lock() )
+				rBus.Recipients.push_back( std::move( pSubscriber ) );
+		}
+	}
+
+	for( const xyConfigurationEvent& rEvent : rBus.Delivering )
+	{
+		for( const std::shared_ptr< xyConfigurationSubscriptionImpl >& rSubscriber : rBus.Recipients )
+			rSubscriber->Callback( rEvent, rSubscriber->pUserData );
+	}
+
+	const size_t Count = rBus.Delivering.size();
+	rBus.Delivering.clear();
+
+	// Subscriptions whose handles were released during the dispatch end here
+	rBus.Recipients.clear();
+
+	return Count;
+
+} // xyDispatchConfigurationChanges
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyPostConfigurationChange( const xyConfigurationEvent& Event )
+{
+	xyConfigurationBus& rBus = xyGetConfigurationBus();
+
+	{
+		std::lock_guard Lock( rBus.Mutex );
+
+		// Only the latest change of each type is of interest
+		auto It = std::find_if( rBus.Pending.begin(), rBus.Pending.end(), [ & ]( const xyConfigurationEvent& rPending ) { return rPending.Type == Event.Type; } );
+		if( It != rBus.Pending.end() ) *It = Event;
+		else                           rBus.Pending.push_back( Event );
+	}
+
+	rBus.Condition.notify_all();
+
+} // xyPostConfigurationChange
+
+//////////////////////////////////////////////////////////////////////////
+
+#if defined( XY_OS_ANDROID )
+
+uint32_t xyGetUIMode( AConfiguration* pConfiguration )
+{
+	switch( AConfiguration_getUiModeType( pConfiguration ) )
+	{
+		case ACONFIGURATION_UI_MODE_TYPE_CAR:        return XY_UI_MODE_CAR;
+		case ACONFIGURATION_UI_MODE_TYPE_TELEVISION: return XY_UI_MODE_TV;
+		case ACONFIGURATION_UI_MODE_TYPE_APPLIANCE:  return XY_UI_MODE_HEADLESS;
+		case ACONFIGURATION_UI_MODE_TYPE_WATCH:      return XY_UI_MODE_WATCH;
+		case ACONFIGURATION_UI_MODE_TYPE_VR_HEADSET: return XY_UI_MODE_VR;
+		default:                                     return XY_UI_MODE_PHONE; // Default to phone UI
+	}
+
+} // xyGetUIMode
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyOnConfigurationChanged( ANativeActivity* pActivity )
+{
+	xyContext&      rContext       = xyGetContext();
+	AConfiguration* pConfiguration = AConfiguration_new();
+
+	AConfiguration_fromAssetManager( pConfiguration, pActivity->assetManager );
+
+	const int32_t Changes = AConfiguration_diff( rContext.pPlatformImpl->pConfiguration, pConfiguration );
+
+	// Copy into the existing configuration rather than replacing it, since other threads may be reading from it
+	AConfiguration_copy( rContext.pPlatformImpl->pConfiguration, pConfiguration );
+	AConfiguration_delete( pConfiguration );
+
+	if( Changes & ACONFIGURATION_UI_MODE )
+	{
+		const uint32_t UIMode = xyGetUIMode( rContext.pPlatformImpl->pConfiguration );
+
+		if( UIMode != rContext.UIMode )
+		{
+			rContext.UIMode = UIMode;
+			xyPostConfigurationChange( { .Type=xyConfigurationChange::UIMode, .UIMode=UIMode } );
+		}
+
+		// The night mode is part of the UI mode, so the theme may have changed as well
+		xyPostConfigurationChange( { .Type=xyConfigurationChange::Theme, .Theme=xyGetPreferredTheme() } );
+	}
+
+	if( Changes & ACONFIGURATION_LOCALE )
+		xyPostConfigurationChange( { .Type=xyConfigurationChange::Language } );
+
+	if( Changes & ( ACONFIGURATION_ORIENTATION | ACONFIGURATION_DENSITY | ACONFIGURATION_SCREEN_SIZE | ACONFIGURATION_SCREEN_LAYOUT | ACONFIGURATION_SMALLEST_SCREEN_SIZE ) )
+		xyPostConfigurationChange( { .Type=xyConfigurationChange::Displays } );
+
+} // xyOnConfigurationChanged
+
+#endif // XY_OS_ANDROID
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyTelemetrySegment
+{
+	struct Counter
+	{
+		char    Name[ 32 ];
+		int64_t Value;
+
+	}; // Counter
+
+	struct Thread
+	{
+		char     Name[ 16 ];
+		uint32_t ID;
+		char     State;
+		uint64_t CpuTime;
+
+	}; // Thread
+
+	static constexpr uint32_t Magic        = 0x4D545958; // "XYTM"
+	static constexpr uint32_t Version      = 1;
+	static constexpr uint32_t MaxCounters  = 64;
+	static constexpr uint32_t MaxThreads   = 128;
+
+	uint32_t                FileMagic;
+	uint32_t                FileVersion;
+	uint32_t                ProcessID;
+	uint32_t                Size;
+	std::atomic< uint32_t > Sequence; // Odd while the writer is updating the fields below
+
+	uint64_t                Updates;
+	int64_t                 Uptime;
+	float                   Temperature; // NaN if unknown
+	uint8_t                 BatteryPercentage;
+	uint8_t                 BatteryValid;
+	uint8_t                 BatteryCharging;
+	uint8_t                 ThermalStatus;
+	uint8_t                 Tier;
+	uint64_t                LogBacklog;
+	uint64_t                LogDropped;
+	uint32_t                PendingFileRequests;
+	uint32_t                PendingConfigurationChanges;
+	uint32_t                CounterCount;
+	uint32_t                ThreadCount;
+	Counter                 Counters[ MaxCounters ];
+	Thread                  Threads[ MaxThreads ];
+
+}; // xyTelemetrySegment
+
+static_assert( std::atomic< uint32_t >::is_always_lock_free, "The sequence lock is shared between processes" );
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyTelemetryViewImpl
+{
+	~xyTelemetryViewImpl( void );
+
+	xyTelemetrySegment* pSegment = nullptr;
+
+#if defined( XY_OS_WINDOWS )
+	HANDLE              Mapping  = NULL;
+#endif // XY_OS_WINDOWS
+
+}; // xyTelemetryViewImpl
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyTelemetryPublisher
+{
+	~xyTelemetryPublisher( void ) { Stop(); }
+
+	void Stop   ( void );
+	void Run    ( void );
+	void Publish( void );
+
+	std::mutex                                                            Mutex;
+	std::condition_variable                                               Condition;
+	std::thread                                                           Thread;
+	std::vector< std::pair< xyTelemetryCounter, const std::atomic< int64_t >* > > Counters;
+	std::chrono::milliseconds                                             Interval = std::chrono::milliseconds( 500 );
+	std::string                                                           Name;
+	std::unique_ptr< xyTelemetryViewImpl >                                pView;
+	bool                                                                  Stopping = false;
+
+}; // xyTelemetryPublisher
+
+//////////////////////////////////////////////////////////////////////////
+
+static xyTelemetryPublisher& xyGetTelemetryPublisher( void )
+{
+	static xyTelemetryPublisher TelemetryPublisher;
+	return TelemetryPublisher;
+
+} // xyGetTelemetryPublisher
+
+//////////////////////////////////////////////////////////////////////////
+
+static std::string xyGetTelemetryPath( std::string_view Name )
+{
+	std::string Path;
+
+#if defined( XY_OS_WINDOWS )
+	Path = "Local\\";
+#else // XY_OS_WINDOWS
+	Path = "/";
+#endif // !XY_OS_WINDOWS
+
+	// A process ID refers to the default name
+	if( !Name.empty() && std::all_of( Name.begin(), Name.end(), []( char c ) { return c >= '0' && c <= '9'; } ) )
+		Path += "xy-";
+
+	return Path.append( Name );
+
+} // xyGetTelemetryPath
+
+//////////////////////////////////////////////////////////////////////////
+
+static xyTelemetrySegment* xyMapTelemetry( const std::string& rPath, bool Create, xyTelemetryViewImpl& rView )
+{
+	const size_t Size = sizeof( xyTelemetrySegment );
+	void*        pMap = nullptr;
+
+#if defined( XY_OS_WINDOWS )
+
+	std::wstring WidePath( rPath.begin(), rPath.end() );
+
+	rView.Mapping = Create ? CreateFileMappingW( INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, static_cast< DWORD >( Size ), WidePath.c_str() )
+	                       : OpenFileMappingW( FILE_MAP_READ, FALSE, WidePath.c_str() );
+	if( rView.Mapping == NULL )
+		return nullptr;
+
+	pMap = MapViewOfFile( rView.Mapping, Create ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, Size );
+	if( pMap == nullptr )
+	{
+		CloseHandle( rView.Mapping );
+		rView.Mapping = NULL;
+		return nullptr;
+	}
+
+#elif !defined( XY_OS_ANDROID ) // XY_OS_WINDOWS
+
+	// The mapping doesn't need a handle once the file is closed, so the view has nothing to keep
+	( void )rView;
+
+	const int File = shm_open( rPath.c_str(), Create ? ( O_RDWR | O_CREAT | O_TRUNC ) : O_RDONLY, 0600 );
+	if( File < 0 )
+		return nullptr;
+
+	struct stat Status;
+	if( ( Create && ftruncate( File, Size ) != 0 ) || fstat( File, &Status ) != 0 || static_cast< size_t >( Status.st_size ) < Size )
+	{
+		close( File );
+		if( Create )
+			shm_unlink( rPath.c_str() );
+		return nullptr;
+	}
+
+	pMap = mmap( nullptr, Size, Create ? ( PROT_READ | PROT_WRITE ) : PROT_READ, MAP_SHARED, File, 0 );
+	close( File );
+
+	if( pMap == MAP_FAILED )
+	{
+		if( Create )
+			shm_unlink( rPath.c_str() );
+		return nullptr;
+	}
+
+#else // XY_OS_ANDROID
+
+	( void )rPath;
+	( void )Create;
+	( void )rView;
+
+#endif // XY_OS_ANDROID
+
+	return static_cast< xyTelemetrySegment* >( pMap );
+
+} // xyMapTelemetry
+
+//////////////////////////////////////////////////////////////////////////
+
+xyTelemetryViewImpl::~xyTelemetryViewImpl( void )
+{
+
+#if defined( XY_OS_WINDOWS )
+	if( pSegment ) UnmapViewOfFile( pSegment );
+	if( Mapping )  CloseHandle( Mapping );
+#elif !defined( XY_OS_ANDROID ) // XY_OS_WINDOWS
+	if( pSegment ) munmap( pSegment, sizeof( xyTelemetrySegment ) );
+#endif // !XY_OS_WINDOWS && !XY_OS_ANDROID
+
+} // ~xyTelemetryViewImpl
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyTelemetryPublisher::Publish( void )
+{
+	xyTelemetrySegment& rSegment = *pView->pSegment;
+
+	// Gather everything before entering the write section, so that readers retry as rarely as possible
+	const xyBatteryState BatteryState = xyGetBatteryState();
+	const xyThermalState ThermalState = xyGetThermalState();
+	float                Temperature  = std::numeric_limits< float >::quiet_NaN();
+
+	for( const xyThermalZone& rZone : ThermalState.Zones )
+		Temperature = std::isnan( Temperature ) ? rZone.Temperature : std::max( Temperature, rZone.Temperature );
+
+	uint64_t LogBacklog = 0;
+	{
+		xyLogger&       rLogger = xyGetLogger();
+		std::lock_guard Lock( rLogger.Mutex );
+
+		for( const std::shared_ptr< xyLogBuffer >& rBuffer : rLogger.Buffers )
+			LogBacklog += rBuffer->Tail.load( std::memory_order_relaxed ) - rBuffer->Head.load( std::memory_order_relaxed );
+	}
+
+	uint32_t PendingFileRequests = 0;
+	if( xyFileIOCreated.load( std::memory_order_relaxed ) )
+	{
+		xyFileIO&       rFileIO = xyGetFileIO();
+		std::lock_guard Lock( rFileIO.Mutex );
+		PendingFileRequests = static_cast< uint32_t >( rFileIO.Queued.size() + rFileIO.InFlight + rFileIO.Completed.size() );
+	}
+
+	uint32_t PendingConfigurationChanges;
+	{
+		xyConfigurationBus& rBus = xyGetConfigurationBus();
+		std::lock_guard     Lock( rBus.Mutex );
+		PendingConfigurationChanges = static_cast< uint32_t >( rBus.Pending.size() );
+	}
+
+	std::vector< xyTelemetrySegment::Thread > Threads;
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+	if( DIR* pDirectory = opendir( "/proc/self/task" ) )
+	{
+		const long TicksPerSecond = sysconf( _SC_CLK_TCK );
+
+		while( dirent* pEntry = readdir( pDirectory ) )
+		{
+			if( pEntry->d_name[ 0 ] == '.' || Threads.size() == xyTelemetrySegment::MaxThreads )
+				continue;
+
+			char             Path[ 300 ];
+			char             Buffer[ 512 ];
+			std::snprintf( Path, sizeof( Path ), "/proc/self/task/%s/stat", pEntry->d_name );
+			std::string_view Stat  = xyReadSmallFile( Path, Buffer );
+			const size_t     Open  = Stat.find( '(' );
+			const size_t     Close = Stat.rfind( ')' );
+			if( Open == std::string_view::npos || Close == std::string_view::npos || Close < Open )
+				continue;
+
+			xyTelemetrySegment::Thread Thread    = { };
+			const std::string_view     Name      = Stat.substr( Open + 1, Close - Open - 1 );
+			unsigned long              UserTicks = 0;
+			unsigned long              KernelTicks = 0;
+
+			std::copy_n( Name.begin(), std::min( Name.size(), sizeof( Thread.Name ) - 1 ), Thread.Name );
+			Thread.ID = static_cast< uint32_t >( std::strtoul( pEntry->d_name, nullptr, 10 ) );
+
+			// The state is the third field, and the user and kernel times are the 14th and 15th
+			if( std::sscanf( std::string( Stat.substr( Close + 1 ) ).c_str(), " %c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu", &Thread.State, &UserTicks, &KernelTicks ) >= 1 )
+			{
+				Thread.CpuTime = static_cast< uint64_t >( UserTicks + KernelTicks ) * 1'000'000'000 / static_cast< uint64_t >( TicksPerSecond );
+				Threads.push_back( Thread );
+			}
+		}
+
+		closedir( pDirectory );
+	}
+
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+	const uint32_t Sequence = rSegment.Sequence.load( std::memory_order_relaxed );
+	rSegment.Sequence.store( Sequence + 1, std::memory_order_relaxed );
+	std::atomic_thread_fence( std::memory_order_release );
+
+	rSegment.Updates                     += 1;
+	rSegment.Uptime                       = ( std::chrono::steady_clock::now() - xyGetContext().StartTime ).count();
+	rSegment.Temperature                  = Temperature;
+	rSegment.BatteryPercentage            = BatteryState.CapacityPercentage;
+	rSegment.BatteryValid                 = BatteryState.Valid;
+	rSegment.BatteryCharging              = BatteryState.Charging;
+	rSegment.ThermalStatus                = static_cast< uint8_t >( ThermalState.Status );
+	rSegment.Tier                         = static_cast< uint8_t >( xyGetPowerMonitor().Tier.load( std::memory_order_relaxed ) );
+	rSegment.LogBacklog                   = LogBacklog;
+	rSegment.LogDropped                   = xyGetLogger().Dropped.load( std::memory_order_relaxed );
+	rSegment.PendingFileRequests          = PendingFileRequests;
+	rSegment.PendingConfigurationChanges  = PendingConfigurationChanges;
+	rSegment.CounterCount                 = static_cast< uint32_t >( Counters.size() );
+	rSegment.ThreadCount                  = static_cast< uint32_t >( Threads.size() );
+
+	for( size_t i = 0; i < Counters.size(); ++i )
+	{
+		const std::string_view Name = Counters[ i ].first.Name;
+
+		std::fill( std::begin( rSegment.Counters[ i ].Name ), std::end( rSegment.Counters[ i ].Name ), '\0' );
+		std::copy( Name.begin(), Name.end(), rSegment.Counters[ i ].Name );
+		rSegment.Counters[ i ].Value = Counters[ i ].second->load( std::memory_order_relaxed );
+	}
+
+	std::copy( Threads.begin(), Threads.end(), rSegment.Threads );
+
+	rSegment.Sequence.store( Sequence + 2, std::memory_order_release );
+
+} // Publish
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyTelemetryPublisher::Run( void )
+{
+	std::unique_lock Lock( Mutex );
+
+	do
+	{
+		Publish();
+
+	} while( !Condition.wait_for( Lock, Interval, [ this ]{ return Stopping; } ) );
+
+} // Run
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyTelemetryPublisher::Stop( void )
+{
+	if( !Thread.joinable() )
+		return;
+
+	{
+		std::lock_guard Lock( Mutex );
+		Stopping = true;
+	}
+
+	Condition.notify_all();
+	Thread.join();
+
+#if !defined( XY_OS_WINDOWS ) && !defined( XY_OS_ANDROID )
+	shm_unlink( Name.c_str() );
+#endif // !XY_OS_WINDOWS && !XY_OS_ANDROID
+
+	pView.reset();
+
+} // Stop
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyStartTelemetry( std::string_view Name, std::chrono::milliseconds Interval )
+{
+	xyTelemetryPublisher& rPublisher = xyGetTelemetryPublisher();
+
+	if( rPublisher.Thread.joinable() )
+		return false;
+
+#if defined( XY_OS_WINDOWS )
+	const uint32_t ProcessID = static_cast< uint32_t >( GetCurrentProcessId() );
+#else // XY_OS_WINDOWS
+	const uint32_t ProcessID = static_cast< uint32_t >( getpid() );
+#endif // !XY_OS_WINDOWS
+
+	const std::string Path = xyGetTelemetryPath( Name.empty() ? std::to_string( ProcessID ) : std::string( Name ) );
+
+	rPublisher.pView             = std::make_unique< xyTelemetryViewImpl >();
+	xyTelemetrySegment* pSegment = xyMapTelemetry( Path, true, *rPublisher.pView );
+	if( pSegment == nullptr )
+	{
+		rPublisher.pView.reset();
+		return false;
+	}
+
+	// The version is written last, so that readers can't see a half-initialized segment
+	pSegment->FileMagic = xyTelemetrySegment::Magic;
+	pSegment->ProcessID = ProcessID;
+	pSegment->Size      = sizeof( xyTelemetrySegment );
+	std::atomic_ref( pSegment->FileVersion ).store( xyTelemetrySegment::Version, std::memory_order_release );
+
+	rPublisher.pView->pSegment = pSegment;
+	rPublisher.Name            = Path;
+	rPublisher.Interval        = Interval;
+	rPublisher.Stopping        = false;
+	rPublisher.Thread          = std::thread( &xyTelemetryPublisher::Run, &rPublisher );
+
+	return true;
+
+} // xyStartTelemetry
 
-	// Note: Trailing space in "Cancel " is intended
-	// NSAlert has special layouts for common titles (such as "Cancel") that we would like to avoid
-	switch( Buttons )
+//////////////////////////////////////////////////////////////////////////
+
+void xyStopTelemetry( void )
+{
+	xyGetTelemetryPublisher().Stop();
+
+} // xyStopTelemetry
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyRegisterTelemetryCounter( std::string_view Name, const std::atomic< int64_t >& rValue )
+{
+	xyTelemetryPublisher& rPublisher = xyGetTelemetryPublisher();
+	std::lock_guard       Lock( rPublisher.Mutex );
+
+	if( rPublisher.Counters.size() < xyTelemetrySegment::MaxCounters )
+		rPublisher.Counters.emplace_back( xyTelemetryCounter{ .Name=Name }, &rValue );
+
+} // xyRegisterTelemetryCounter
+
+//////////////////////////////////////////////////////////////////////////
+
+xyTelemetryView xyOpenTelemetry( std::string_view Name )
+{
+	auto pImpl      = std::make_shared< xyTelemetryViewImpl >();
+	pImpl->pSegment = xyMapTelemetry( xyGetTelemetryPath( Name ), false, *pImpl );
+
+	if( pImpl->pSegment == nullptr || pImpl->pSegment->FileMagic != xyTelemetrySegment::Magic || std::atomic_ref( pImpl->pSegment->FileVersion ).load( std::memory_order_acquire ) != xyTelemetrySegment::Version || pImpl->pSegment->Size != sizeof( xyTelemetrySegment ) )
+		return { };
+
+	return { .pImpl=std::move( pImpl ) };
+
+} // xyOpenTelemetry
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyReadTelemetry( const xyTelemetryView& rView, xyTelemetrySnapshot& rSnapshot )
+{
+	if( !rView )
+		return false;
+
+	const xyTelemetrySegment&                 rSegment = *rView.pImpl->pSegment;
+	std::unique_ptr< xyTelemetrySegment >     pCopy    = std::make_unique< xyTelemetrySegment >();
+	constexpr size_t                          Offset   = offsetof( xyTelemetrySegment, Updates );
+
+	// The writer only holds the sequence odd for as long as it takes to copy a few kilobytes, so retrying is cheap
+	for( int Attempt = 0; Attempt < 100; ++Attempt )
 	{
-		case xyMessageButtons::Ok:
-			[ pAlert addButtonWithTitle:@"OK" ].tag = ( NSInteger )xyMessageResult::Ok;
-		break;
+		const uint32_t Before = rSegment.Sequence.load( std::memory_order_acquire );
+		if( Before & 1 )
+		{
+			std::this_thread::yield();
+			continue;
+		}
 
-		case xyMessageButtons::OkCancel:
-			[ pAlert addButtonWithTitle:@"OK"     ].tag = ( NSInteger )xyMessageResult::Ok;
-			[ pAlert addButtonWithTitle:@"Cancel" ].tag = ( NSInteger )xyMessageResult::Cancel;
-		break;
+		std::memcpy( reinterpret_cast< std::byte* >( pCopy.get() ) + Offset, reinterpret_cast< const std::byte* >( &rSegment ) + Offset, sizeof( xyTelemetrySegment ) - Offset );
+		std::atomic_thread_fence( std::memory_order_acquire );
+
+		if( rSegment.Sequence.load( std::memory_order_relaxed ) != Before )
+			continue;
+
+		const xyTelemetrySegment& rCopy = *pCopy;
+
+		rSnapshot.ProcessID                   = rSegment.ProcessID;
+		rSnapshot.Updates                     = rCopy.Updates;
+		rSnapshot.Uptime                      = std::chrono::nanoseconds( rCopy.Uptime );
+		rSnapshot.Battery                     = { .CapacityPercentage=rCopy.BatteryPercentage, .Charging=rCopy.BatteryCharging != 0, .Valid=rCopy.BatteryValid != 0 };
+		rSnapshot.Temperature                 = std::isnan( rCopy.Temperature ) ? std::nullopt : std::optional< float >( rCopy.Temperature );
+		rSnapshot.ThermalStatus               = static_cast< xyThermalStatus >( rCopy.ThermalStatus );
+		rSnapshot.Tier                        = static_cast< xyPerformanceTier >( rCopy.Tier );
+		rSnapshot.LogBacklog                  = rCopy.LogBacklog;
+		rSnapshot.LogDropped                  = rCopy.LogDropped;
+		rSnapshot.PendingFileRequests         = rCopy.PendingFileRequests;
+		rSnapshot.PendingConfigurationChanges = rCopy.PendingConfigurationChanges;
+		rSnapshot.Counters.clear();
+		rSnapshot.Threads.clear();
+
+		for( uint32_t i = 0; i < std::min( rCopy.CounterCount, xyTelemetrySegment::MaxCounters ); ++i )
+		{
+			const xyTelemetrySegment::Counter& rCounter = rCopy.Counters[ i ];
+			rSnapshot.Counters.push_back( { .Name=std::string_view( rCounter.Name, strnlen( rCounter.Name, sizeof( rCounter.Name ) ) ), .Value=rCounter.Value } );
+		}
 
-		case xyMessageButtons::YesNo:
-			[ pAlert addButtonWithTitle:@"Yes" ].tag = ( NSInteger )xyMessageResult::Yes;
-			[ pAlert addButtonWithTitle:@"No"  ].tag = ( NSInteger )xyMessageResult::No;
-		break;
+		for( uint32_t i = 0; i < std::min( rCopy.ThreadCount, xyTelemetrySegment::MaxThreads ); ++i )
+		{
+			const xyTelemetrySegment::Thread& rThread = rCopy.Threads[ i ];
+			rSnapshot.Threads.push_back( { .Name=std::string_view( rThread.Name, strnlen( rThread.Name, sizeof( rThread.Name ) ) ), .ID=rThread.ID, .State=rThread.State, .CpuTime=std::chrono::nanoseconds( rThread.CpuTime ) } );
+		}
 
-		case xyMessageButtons::YesNoCancel:
-			[ pAlert addButtonWithTitle:@"Yes"     ].tag = ( NSInteger )xyMessageResult::Yes;
-			[ pAlert addButtonWithTitle:@"No"      ].tag = ( NSInteger )xyMessageResult::No;
-			[ pAlert addButtonWithTitle:@"Cancel " ].tag = ( NSInteger )xyMessageResult::Cancel;
-		break;
+		return true;
+	}
 
-		case xyMessageButtons::AbortRetryIgnore:
-			[ pAlert addButtonWithTitle:@"Abort"  ].tag = ( NSInteger )xyMessageResult::Abort;
-			[ pAlert addButtonWithTitle:@"Retry"  ].tag = ( NSInteger )xyMessageResult::Retry;
-			[ pAlert addButtonWithTitle:@"Ignore" ].tag = ( NSInteger )xyMessageResult::Ignore;
-		break;
+	return false;
 
-		case xyMessageButtons::CancelTryagainContinue:
-			[ pAlert addButtonWithTitle:@"Cancel "   ].tag = ( NSInteger )xyMessageResult::Cancel;
-			[ pAlert addButtonWithTitle:@"Try Again" ].tag = ( NSInteger )xyMessageResult::Tryagain;
-			[ pAlert addButtonWithTitle:@"Continue"  ].tag = ( NSInteger )xyMessageResult::Continue;
-		break;
+} // xyReadTelemetry
 
-		case xyMessageButtons::RetryCancel:
-			[ pAlert addButtonWithTitle:@"Retry"   ].tag = ( NSInteger )xyMessageResult::Retry;
-			[ pAlert addButtonWithTitle:@"Cancel " ].tag = ( NSInteger )xyMessageResult::Cancel;
-		break;
+//////////////////////////////////////////////////////////////////////////
+
+std::vector< std::string > xyListTelemetry( void )
+{
+	std::vector< std::string > Names;
+
+#if defined( XY_OS_LINUX )
+
+	// POSIX shared memory objects live in /dev/shm on Linux. Other platforms have no way of listing them.
+	if( DIR* pDirectory = opendir( "/dev/shm" ) )
+	{
+		while( dirent* pEntry = readdir( pDirectory ) )
+		{
+			xyTelemetryViewImpl View;
+			if( pEntry->d_name[ 0 ] != '.' && ( View.pSegment = xyMapTelemetry( std::string( "/" ) + pEntry->d_name, false, View ) ) && View.pSegment->FileMagic == xyTelemetrySegment::Magic )
+				Names.emplace_back( pEntry->d_name );
+		}
+
+		closedir( pDirectory );
 	}
 
-	xyMessageResult Result = ( xyMessageResult )[ pAlert runModal ];
+#endif // XY_OS_LINUX
 
-	[ pInformativeText release ];
-	[ pMessageText release ];
-	[ pAlert release ];
+	return Names;
 
-	return Result;
+} // xyListTelemetry
 
-#elif defined( XY_OS_ANDROID ) // XY_OS_MACOS
+//////////////////////////////////////////////////////////////////////////
 
-	jobject Spinner = xyRunOnJavaThread( []( std::string Title, std::string Message, int Buttons )
+struct xyChannelRing
+{
+	struct Header
 	{
-		xyContext& rContext = xyGetContext();
-		JNIEnv*    pJNI     = rContext.pPlatformImpl->pNativeActivity->env;
+		std::atomic< uint64_t > Committed; // Position of the record plus one once it is committed, so that zeroed memory never reads as committed
+		uint32_t                Size;      // Of the payload, or of the whole record for padding
+		uint32_t                Padding;   // Whether the record only fills the gap up to the end of the ring
 
-		// Easy way to tidy up all our local references when we're done
-		pJNI->PushLocalFrame( 16 );
+	}; // Header
 
-		// Obtain all necessary classes and method IDs
-		jclass    ClassBuilder            = pJNI->FindClass( "android/app/AlertDialog$Builder" );
-		jmethodID CtorBuilder             = pJNI->GetMethodID( ClassBuilder, "<init>", "(Landroid/content/Context;)V" );
-		jmethodID MethodSetTitle          = pJNI->GetMethodID( ClassBuilder, "setTitle", "(Ljava/lang/CharSequence;)Landroid/app/AlertDialog$Builder;" );
-		jmethodID MethodSetMessage        = pJNI->GetMethodID( ClassBuilder, "setMessage", "(Ljava/lang/CharSequence;)Landroid/app/AlertDialog$Builder;" );
-		jmethodID MethodSetNeutralButton  = pJNI->GetMethodID( ClassBuilder, "setNeutralButton", "(Ljava/lang/CharSequence;Landroid/content/DialogInterface$OnClickListener;)Landroid/app/AlertDialog$Builder;" );
-		jmethodID MethodSetNegativeButton = pJNI->GetMethodID( ClassBuilder, "setNegativeButton", "(Ljava/lang/CharSequence;Landroid/content/DialogInterface$OnClickListener;)Landroid/app/AlertDialog$Builder;" );
-		jmethodID MethodSetPositiveButton = pJNI->GetMethodID( ClassBuilder, "setPositiveButton", "(Ljava/lang/CharSequence;Landroid/content/DialogInterface$OnClickListener;)Landroid/app/AlertDialog$Builder;" );
-		jmethodID MethodSetCancelable     = pJNI->GetMethodID( ClassBuilder, "setCancelable", "(Z)Landroid/app/AlertDialog$Builder;" );
-		jmethodID MethodShow              = pJNI->GetMethodID( ClassBuilder, "show", "()Landroid/app/AlertDialog;" );
+	alignas( 64 ) std::atomic< uint64_t > Head            = 0; // Advanced by the receiver
+	alignas( 64 ) std::atomic< uint64_t > Tail            = 0; // Advanced by the senders as they reserve
+	alignas( 64 ) std::atomic< uint32_t > DataSignal      = 0; // Futex that the receiver waits on
+	std::atomic< uint32_t >               ReceiverWaiting = 0;
+	alignas( 64 ) std::atomic< uint32_t > SpaceSignal     = 0; // Futex that the senders wait on
+	std::atomic< uint32_t >               SendersWaiting  = 0;
 
-		// Create a dummy spinner that will keep track of which button was clicked.
-		// This is done because we need a built-in class that implements DialogInterface.OnClickListener and has an easy way to query which button was clicked
-		jclass    ClassSpinner           = pJNI->FindClass( "android/widget/Spinner" );
-		jmethodID CtorSpinner            = pJNI->GetMethodID( ClassSpinner, "<init>", "(Landroid/content/Context;)V" );
-		jmethodID MethodSetSelection     = pJNI->GetMethodID( ClassSpinner, "setSelection", "(I)V" );
-		jobject   Spinner                = pJNI->NewObject( ClassSpinner, CtorSpinner, rContext.pPlatformImpl->pNativeActivity->clazz );
-		Spinner                          = pJNI->NewGlobalRef( Spinner );
-		pJNI->CallVoidMethod( Spinner, MethodSetSelection, 0 );
+}; // xyChannelRing
 
-		// Create the alert dialog
-		jobject Builder = pJNI->NewObject( ClassBuilder, CtorBuilder, rContext.pPlatformImpl->pNativeActivity->clazz );
-		pJNI->CallObjectMethod( Builder, MethodSetTitle, pJNI->NewStringUTF( Title.data() ) );
-		pJNI->CallObjectMethod( Builder, MethodSetMessage, pJNI->NewStringUTF( Message.data() ) );
-		pJNI->CallObjectMethod( Builder, MethodSetCancelable, false );
+static_assert( std::atomic< uint64_t >::is_always_lock_free, "Channel rings are shared between processes" );
 
-		switch( ( xyMessageButtons )Buttons )
+//////////////////////////////////////////////////////////////////////////
+
+struct xyChannelMemory
+{
+	static constexpr uint32_t Magic   = 0x48435958; // "XYCH"
+	static constexpr uint32_t Version = 1;
+
+	uint32_t      FileMagic;
+	uint32_t      FileVersion;
+	uint64_t      Capacity;   // Of each ring, in bytes
+	xyChannelRing Rings[ 2 ]; // The listening side sends on the first ring and receives on the second
+
+}; // xyChannelMemory
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyChannelImpl
+{
+	~xyChannelImpl( void );
+
+	bool IsConnected( void ) const;
+	bool Wait( std::atomic< uint32_t >& rSignal, std::atomic< uint32_t >& rWaiting, uint32_t Value );
+	void Wake( std::atomic< uint32_t >& rSignal, std::atomic< uint32_t >& rWaiting );
+
+	xyChannelMemory* pMemory      = nullptr;
+	size_t           MappedSize   = 0;
+	xyChannelRing*   pSend        = nullptr;
+	xyChannelRing*   pReceive     = nullptr;
+	std::byte*       pSendData    = nullptr;
+	std::byte*       pReceiveData = nullptr;
+	uint64_t         Capacity     = 0;
+	uint64_t         ReceiveSize  = 0;  // Of the record that is being held by the receiver
+	int              Socket       = -1; // Kept open to notice when the other process goes away
+
+}; // xyChannelImpl
+
+//////////////////////////////////////////////////////////////////////////
+
+struct xyChannelListenerImpl
+{
+	~xyChannelListenerImpl( void );
+
+	int    Socket   = -1;
+	size_t Capacity = 0;
+
+}; // xyChannelListenerImpl
+
+//////////////////////////////////////////////////////////////////////////
+
+static constexpr uint64_t xyGetChannelRecordSize( uint64_t Size )
+{
+	// Keeping records a multiple of the header size guarantees that there is room for a padding header at the end of the ring
+	constexpr uint64_t Alignment = sizeof( xyChannelRing::Header );
+
+	return Alignment + ( ( Size + Alignment - 1 ) & ~( Alignment - 1 ) );
+
+} // xyGetChannelRecordSize
+
+//////////////////////////////////////////////////////////////////////////
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+static socklen_t xyGetChannelAddress( std::string_view Name, sockaddr_un& rAddress )
+{
+	// Abstract socket names start with a null character. They never touch the file system and disappear with the process that bound them.
+	rAddress                    = { .sun_family=AF_UNIX, .sun_path={ } };
+	const std::string_view Path = "xy-channel-";
+	const size_t           Size = std::min( Path.size() + Name.size(), sizeof( rAddress.sun_path ) - 1 );
+
+	std::copy( Path.begin(), Path.end(), rAddress.sun_path + 1 );
+	std::copy_n( Name.begin(), Size - Path.size(), rAddress.sun_path + 1 + Path.size() );
+
+	return static_cast< socklen_t >( offsetof( sockaddr_un, sun_path ) + 1 + Size );
+
+} // xyGetChannelAddress
+
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+//////////////////////////////////////////////////////////////////////////
+
+static xyChannel xyMapChannel( int Socket, int MemoryFile, bool Listening )
+{
+	xyChannel Channel;
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+	struct stat Status;
+	if( fstat( MemoryFile, &Status ) != 0 || static_cast< size_t >( Status.st_size ) < sizeof( xyChannelMemory ) )
+		return Channel;
+
+	void* pMap = mmap( nullptr, Status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, MemoryFile, 0 );
+	if( pMap == MAP_FAILED )
+		return Channel;
+
+	auto pImpl        = std::make_shared< xyChannelImpl >();
+	pImpl->pMemory    = static_cast< xyChannelMemory* >( pMap );
+	pImpl->MappedSize = Status.st_size;
+	pImpl->Socket     = Socket;
+
+	if( pImpl->pMemory->FileMagic != xyChannelMemory::Magic || pImpl->pMemory->FileVersion != xyChannelMemory::Version || sizeof( xyChannelMemory ) + 2 * pImpl->pMemory->Capacity > pImpl->MappedSize )
+	{
+		// The socket is closed by the destructor
+		return Channel;
+	}
+
+	std::byte* pData      = static_cast< std::byte* >( pMap ) + sizeof( xyChannelMemory );
+	pImpl->Capacity       = pImpl->pMemory->Capacity;
+	pImpl->pSend          = &pImpl->pMemory->Rings[ Listening ? 0 : 1 ];
+	pImpl->pReceive       = &pImpl->pMemory->Rings[ Listening ? 1 : 0 ];
+	pImpl->pSendData      = pData + ( Listening ? 0 : pImpl->Capacity );
+	pImpl->pReceiveData   = pData + ( Listening ? pImpl->Capacity : 0 );
+	Channel.pImpl         = std::move( pImpl );
+
+#else // XY_OS_LINUX || XY_OS_ANDROID
+
+	( void )Socket;
+	( void )MemoryFile;
+	( void )Listening;
+
+#endif // !XY_OS_LINUX && !XY_OS_ANDROID
+
+	return Channel;
+
+} // xyMapChannel
+
+//////////////////////////////////////////////////////////////////////////
+
+xyChannelImpl::~xyChannelImpl( void )
+{
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+	if( pMemory )     munmap( pMemory, MappedSize );
+	if( Socket >= 0 ) close( Socket );
+
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+} // ~xyChannelImpl
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyChannelImpl::IsConnected( void ) const
+{
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+	pollfd PollFile = { .fd=Socket, .events=POLLRDHUP, .revents=0 };
+
+	return poll( &PollFile, 1, 0 ) == 0;
+
+#else // XY_OS_LINUX || XY_OS_ANDROID
+
+	return false;
+
+#endif // !XY_OS_LINUX && !XY_OS_ANDROID
+
+} // IsConnected
+
+//////////////////////////////////////////////////////////////////////////
+
+bool xyChannelImpl::Wait( std::atomic< uint32_t >& rSignal, std::atomic< uint32_t >& rWaiting, uint32_t Value )
+{
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+	rWaiting.fetch_add( 1, std::memory_order_seq_cst );
+
+	// Wake up now and then to notice if the other process has gone away without saying so
+	if( rSignal.load( std::memory_order_seq_cst ) == Value )
+	{
+		const timespec Timeout = { .tv_sec=0, .tv_nsec=100'000'000 };
+		syscall( SYS_futex, reinterpret_cast< uint32_t* >( &rSignal ), FUTEX_WAIT, Value, &Timeout, nullptr, 0 );
+	}
+
+	rWaiting.fetch_sub( 1, std::memory_order_relaxed );
+
+	return IsConnected();
+
+#else // XY_OS_LINUX || XY_OS_ANDROID
+
+	( void )rSignal;
+	( void )rWaiting;
+	( void )Value;
+
+	return false;
+
+#endif // !XY_OS_LINUX && !XY_OS_ANDROID
+
+} // Wait
+
+//////////////////////////////////////////////////////////////////////////
+
+void xyChannelImpl::Wake( std::atomic< uint32_t >& rSignal, std::atomic< uint32_t >& rWaiting )
+{
+	rSignal.fetch_add( 1, std::memory_order_seq_cst );
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+	// Skip the system call unless somebody is asleep. The futex is shared between processes, so FUTEX_PRIVATE_FLAG must not be used.
+	if( rWaiting.load( std::memory_order_seq_cst ) )
+		syscall( SYS_futex, reinterpret_cast< uint32_t* >( &rSignal ), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0 );
+
+#else // XY_OS_LINUX || XY_OS_ANDROID
+
+	( void )rWaiting;
+
+#endif // !XY_OS_LINUX && !XY_OS_ANDROID
+
+} // Wake
+
+//////////////////////////////////////////////////////////////////////////
+
+xyChannelListenerImpl::~xyChannelListenerImpl( void )
+{
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+	if( Socket >= 0 )
+		close( Socket );
+#endif // XY_OS_LINUX || XY_OS_ANDROID
+
+} // ~xyChannelListenerImpl
+
+//////////////////////////////////////////////////////////////////////////
+
+xyChannelListener xyListenChannel( std::string_view Name, size_t Capacity )
+{
+	xyChannelListener Listener;
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+	auto pImpl      = std::make_shared< xyChannelListenerImpl >();
+	pImpl->Socket   = socket( AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0 ); // So that accepting can return when nobody is connecting
+	pImpl->Capacity = std::max< size_t >( ( Capacity + 63 ) & ~size_t( 63 ), 4096 );
+
+	sockaddr_un     Address;
+	const socklen_t AddressSize = xyGetChannelAddress( Name, Address );
+
+	// Binding fails with EADDRINUSE if another process is already listening on the name
+	if( pImpl->Socket >= 0 && bind( pImpl->Socket, reinterpret_cast< sockaddr* >( &Address ), AddressSize ) == 0 && listen( pImpl->Socket, 16 ) == 0 )
+		Listener.pImpl = std::move( pImpl );
+
+#else // XY_OS_LINUX || XY_OS_ANDROID
+
+	( void )Name;
+	( void )Capacity;
+
+#endif // !XY_OS_LINUX && !XY_OS_ANDROID
+
+	return Listener;
+
+} // xyListenChannel
+
+//////////////////////////////////////////////////////////////////////////
+
+xyChannel xyAcceptChannel( const xyChannelListener& rListener, bool Wait )
+{
+	xyChannel Channel;
+
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
+
+	if( !rListener )
+		return Channel;
+
+	// The listener is non-blocking, so waiting is done by polling it. The accepted socket blocks, since it does not inherit the mode.
+	int Socket;
+	while( ( Socket = accept4( rListener.pImpl->Socket, nullptr, nullptr, SOCK_CLOEXEC ) ) < 0 && Wait && ( errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ) )
+	{
+		pollfd PollFile = { .fd=rListener.pImpl->Socket, .events=POLLIN, .revents=0 };
+		poll( &PollFile, 1, -1 );
+	}
+
+	if( Socket < 0 )
+		return Channel;
+
+	const size_t Capacity   = rListener.pImpl->Capacity;
+	const int    MemoryFile = static_cast< int >( syscall( SYS_memfd_create, "xy-channel", 1u /* MFD_CLOEXEC */ ) );
+	if( MemoryFile < 0 || ftruncate( MemoryFile, static_cast< off_t >( sizeof( xyChannelMemory ) + 2 * Capacity ) ) != 0 )
+	{
+		if( MemoryFile >= 0 )
+			close( MemoryFile );
+
+		close( Socket );
+		return Channel;
+	}
+
+	// The memory file is zero-filled, which is a valid empty ring
+	if( void* pMap = mmap( nullptr, sizeof( xyChannelMemory ), PROT_READ | PROT_WRITE, MAP_SHARED, MemoryFile, 0 ); pMap != MAP_FAILED )
+	{
+		xyChannelMemory* pMemory = static_cast< xyChannelMemory* >( pMap );
+		pMemory->FileMagic       = xyChannelMemory::Magic;
+		pMemory->FileVersion     = xyChannelMemory::Version;
+		pMemory->Capacity        = Capacity;
+
+		munmap( pMap, sizeof( xyChannelMemory ) );
+
+		// Hand the memory file over to the other process
+		uint32_t Hello                            = xyChannelMemory::Magic;
+		iovec    Vector                           = { .iov_base=&Hello, .iov_len=sizeof( Hello ) };
+		alignas( cmsghdr ) char Control[ CMSG_SPACE( sizeof( int ) ) ] = { };
+		msghdr   Message                          = { .msg_name=nullptr, .msg_namelen=0, .msg_iov=&Vector, .msg_iovlen=1, .msg_control=Control, .msg_controllen=sizeof( Control ), .msg_flags=0 };
+		cmsghdr* pControl                         = CMSG_FIRSTHDR( &Message );
+		pControl->cmsg_level                      = SOL_SOCKET;
+		pControl->cmsg_type                       = SCM_RIGHTS;
+		pControl->cmsg_len                        = CMSG_LEN( sizeof( int ) );
+		std::memcpy( CMSG_DATA( pControl ), &MemoryFile, sizeof( int ) );
+
+		if( sendmsg( Socket, &Message, MSG_NOSIGNAL ) == sizeof( Hello ) )
 		{
-			case xyMessageButtons::Ok:
-				pJNI->CallObjectMethod( Builder, MethodSetPositiveButton, pJNI->NewStringUTF( "OK" ), Spinner );
-			break;
+			Channel = xyMapChannel( Socket, MemoryFile, true );
+			close( MemoryFile );
+			return Channel;
+		}
+	}
 
-			case xyMessageButtons::OkCancel:
-				pJNI->CallObjectMethod( Builder, MethodSetNeutralButton,  pJNI->NewStringUTF( "OK" ),     Spinner );
-				pJNI->CallObjectMethod( Builder, MethodSetPositiveButton, pJNI->NewStringUTF( "Cancel" ), Spinner );
-			break;
+	close( MemoryFile );
+	close( Socket );
+
+#else // XY_OS_LINUX || XY_OS_ANDROID
+
+	( void )rListener;
+	( void )Wait;
+
+#endif // !XY_OS_LINUX && !XY_OS_ANDROID
+
+	return Channel;
+
+} // xyAcceptChannel
+
+//////////////////////////////////////////////////////////////////////////
 
-			case xyMessageButtons::YesNo:
-				pJNI->CallObjectMethod( Builder, MethodSetNeutralButton,  pJNI->NewStringUTF( "Yes" ),  Spinner );
-				pJNI->CallObjectMethod( Builder, MethodSetPositiveButton, pJNI->NewStringUTF( "No" ),   Spinner );
-			break;
+xyChannel xyConnectChannel( std::string_view Name )
+{
+	xyChannel Channel;
 
-			case xyMessageButtons::YesNoCancel:
-				pJNI->CallObjectMethod( Builder, MethodSetNeutralButton,  pJNI->NewStringUTF( "Yes" ),    Spinner );
-				pJNI->CallObjectMethod( Builder, MethodSetNegativeButton, pJNI->NewStringUTF( "No" ),     Spinner );
-				pJNI->CallObjectMethod( Builder, MethodSetPositiveButton, pJNI->NewStringUTF( "Cancel" ), Spinner );
-			break;
+#if defined( XY_OS_LINUX ) || defined( XY_OS_ANDROID )
 
-			case xyMessageButtons::AbortRetryIgnore:
-				pJNI->CallObjectMethod( Builder, MethodSetNeutralButton,  pJNI->NewStringUTF( "Abort" ),  Spinner );
-				pJNI->CallObjectMethod( Builder, MethodSetNegativeButton, pJNI->NewStringUTF( "Retry" ),  Spinner );
-				pJNI->CallObjectMethod( Builder, MethodSetPositiveButton, pJNI->NewStringUTF( "Ignore" ), Spinner );
-			break;
+	const int Socket = socket( AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0 );
+	if( Socket < 0 )
+		return Channel;
 
-			case xyMessageButtons::CancelTryagainContinue:
-				pJNI->CallObjectMethod( Builder, MethodSetNeutralButton,  pJNI->NewStringUTF( "Cancel" ),    Spinner );
-				pJNI->CallObjectMethod( Builder, MethodSetNegativeButton, pJNI->NewStringUTF( "Try Again" ), Spinner );
-				pJNI->CallObjectMethod( Builder, MethodSetPositiveButton, pJNI->NewStringUTF( "Continue" ),  Spinner );
-			break;
+	sockaddr_un     Address;
+	const socklen_t AddressSize = xyGetChannelAddress( Name, Address );
 
-			case xyMessageButtons::RetryCancel:
-				pJNI->CallObjectMethod( Builder, MethodSetNeutralButton,  pJNI->NewStringUTF( "Retry" ),  Spinner );
-				pJNI->CallObjectMethod( Builder, MethodSetPositiveButton, pJNI->NewStringUTF( "Cancel" ), Spinner );
-			break;
+	uint32_t Hello                                         = 0;
+	iovec    Vector                                        = { .iov_base=&Hello, .iov_len=sizeof( Hello ) };
+	alignas( cmsghdr ) char Control[ CMSG_SPACE( sizeof( int ) ) ] = { };
+	msghdr   Message                                       = { .msg_name=nullptr, .msg_namelen=0, .msg_iov=&Vector, .msg_iovlen=1, .msg_control=Control, .msg_controllen=sizeof( Control ), .msg_flags=0 };
+
+	if( connect( Socket, reinterpret_cast< sockaddr* >( &Address ), AddressSize ) == 0 && recvmsg( Socket, &Message, MSG_CMSG_CLOEXEC ) == sizeof( Hello ) && Hello == xyChannelMemory::Magic )
+	{
+		if( cmsghdr* pControl = CMSG_FIRSTHDR( &Message ); pControl && pControl->cmsg_level == SOL_SOCKET && pControl->cmsg_type == SCM_RIGHTS )
+		{
+			int MemoryFile;
+			std::memcpy( &MemoryFile, CMSG_DATA( pControl ), sizeof( int ) );
+
+			Channel = xyMapChannel( Socket, MemoryFile, false );
+			close( MemoryFile );
+			return Channel;
 		}
+	}
 
-		// Show the alert
-		pJNI->CallObjectMethod( Builder, MethodShow );
+	close( Socket );
 
-		pJNI->PopLocalFrame( nullptr );
+#else // XY_OS_LINUX || XY_OS_ANDROID
 
-		return Spinner;
+	( void )Name;
 
-	}, std::string( Title ), std::string( Message ), ( int )Buttons );
+#endif // !XY_OS_LINUX && !XY_OS_ANDROID
 
-	xyContext& rContext = xyGetContext();
-	JavaVM*    pJVM     = rContext.pPlatformImpl->pNativeActivity->vm;
-	JNIEnv*    pJNI;
-	pJVM->AttachCurrentThread( &pJNI, nullptr );
-
-	// Sleep until the alert is closed
-	jclass    ClassSpinner                  = pJNI->GetObjectClass( Spinner );
-	jmethodID MethodGetSelectedItemPosition = pJNI->GetMethodID( ClassSpinner, "getSelectedItemPosition", "()I" );
-	int       Result;
-	while( ( Result = pJNI->CallIntMethod( Spinner, MethodGetSelectedItemPosition ) ) == 0 )
-		std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+	return Channel;
 
-	pJNI->DeleteGlobalRef( Spinner );
+} // xyConnectChannel
 
-	pJVM->DetachCurrentThread();
+//////////////////////////////////////////////////////////////////////////
 
-	std::array< xyMessageResult, 3 > ResultTable;
-	switch( Buttons )
-	{
-		default:
-		case xyMessageButtons::Ok:                     ResultTable = { xyMessageResult::Ok,       { },                       { }                     }; break;
-		case xyMessageButtons::OkCancel:               ResultTable = { xyMessageResult::Cancel,   { },                       xyMessageResult::Ok     }; break;
-		case xyMessageButtons::YesNo:                  ResultTable = { xyMessageResult::No,       { },                       xyMessageResult::Yes    }; break;
-		case xyMessageButtons::YesNoCancel:            ResultTable = { xyMessageResult::Cancel,   xyMessageResult::No,       xyMessageResult::Yes    }; break;
-		case xyMessageButtons::AbortRetryIgnore:       ResultTable = { xyMessageResult::Ignore,   xyMessageResult::Retry,    xyMessageResult::Abort  }; break;
-		case xyMessageButtons::CancelTryagainContinue: ResultTable = { xyMessageResult::Continue, xyMessageResult::Tryagain, xyMessageResult::Cancel }; break;
-		case xyMessageButtons::RetryCancel:            ResultTable = { xyMessageResult::Cancel,   { },                       xyMessageResult::Retry  }; break;
-	}
+xyChannelMessage xyBeginChannelMessage( const xyChannel& rChannel, size_t Size, bool Wait )
+{
+	if( !rChannel )
+		return { };
 
-	// Results ranges from -1 to -3
-	return ResultTable[ -( Result + 1 ) ];
+	xyChannelImpl& rImpl    = *rChannel.pImpl;
+	xyChannelRing& rRing    = *rImpl.pSend;
+	const uint64_t Capacity = rImpl.Capacity;
+	const uint64_t Record   = xyGetChannelRecordSize( Size );
 
-#elif defined( XY_OS_IOS ) // XY_OS_ANDROID
+	// Guarantees that a record always fits, even after padding out the end of the ring
+	if( Record > Capacity / 2 )
+		return { };
 
-	__block int Result = -1;
+	uint64_t Tail = rRing.Tail.load( std::memory_order_relaxed );
 
-	dispatch_async_and_wait( dispatch_get_main_queue(), ^
+	for( ;; )
 	{
-		UIApplication*     pApplication     = [ UIApplication sharedApplication ];
-		UIScene*           pScene           = [ [ [ pApplication connectedScenes ] allObjects ] firstObject ];
-		UIViewController*  pViewController  = [ [ [ ( UIWindowScene* )pScene windows ] firstObject ] rootViewController ];
-		NSString*          pTitle           = [ NSString stringWithUTF8String:Title.data() ];
-		NSString*          pMessage         = [ NSString stringWithUTF8String:Message.data() ];
-		UIAlertController* pAlertController = [ UIAlertController alertControllerWithTitle:pTitle message:pMessage preferredStyle:UIAlertControllerStyleAlert ];
+		const uint64_t Offset = Tail % Capacity;
+		const uint64_t Gap    = ( Offset + Record > Capacity ) ? Capacity - Offset : 0;
+		const uint32_t Signal = rRing.SpaceSignal.load( std::memory_order_acquire );
 
-		switch( Buttons )
+		if( Tail + Gap + Record - rRing.Head.load( std::memory_order_acquire ) > Capacity )
 		{
-			case xyMessageButtons::Ok:
-				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"OK" style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Ok; } ] ];
-			break;
+			if( !Wait || !rImpl.Wait( rRing.SpaceSignal, rRing.SendersWaiting, Signal ) )
+				return { };
 
-			case xyMessageButtons::OkCancel:
-				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"OK"     style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Ok;     } ] ];
-				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Cancel" style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Cancel; } ] ];
-			break;
+			Tail = rRing.Tail.load( std::memory_order_relaxed );
+			continue;
+		}
 
-			case xyMessageButtons::YesNo:
-				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Yes" style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Yes; } ] ];
-				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"No"  style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::No;  } ] ];
-			break;
+		if( !rRing.Tail.compare_exchange_weak( Tail, Tail + Gap + Record, std::memory_order_relaxed ) )
+			continue;
 
-			case xyMessageButtons::YesNoCancel:
-				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Yes"    style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Yes;    } ] ];
-				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"No"     style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::No;     } ] ];
-				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Cancel" style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Cancel; } ] ];
-			break;
+		if( Gap )
+		{
+			auto* pPadding    = reinterpret_cast< xyChannelRing::Header* >( rImpl.pSendData + Offset );
+			pPadding->Size    = static_cast< uint32_t >( Gap );
+			pPadding->Padding = 1;
+			pPadding->Committed.store( Tail + 1, std::memory_order_release );
+		}
 
-			case xyMessageButtons::AbortRetryIgnore:
-				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Abort"  style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Abort;  } ] ];
-				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Retry"  style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Retry;  } ] ];
-				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Ignore" style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Ignore; } ] ];
-			break;
+		auto* pHeader    = reinterpret_cast< xyChannelRing::Header* >( rImpl.pSendData + ( Tail + Gap ) % Capacity );
+		pHeader->Size    = static_cast< uint32_t >( Size );
+		pHeader->Padding = 0;
 
-			case xyMessageButtons::CancelTryagainContinue:
-				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Cancel"    style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Cancel;   } ] ];
-				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Try Again" style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Tryagain; } ] ];
-				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Continue"  style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Continue; } ] ];
-			break;
+		return { .Data=std::span< std::byte >( reinterpret_cast< std::byte* >( pHeader + 1 ), Size ), .Position=Tail + Gap };
+	}
 
-			case xyMessageButtons::RetryCancel:
-				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Retry"  style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Retry;  } ] ];
-				[ pAlertController addAction:[ UIAlertAction actionWithTitle:@"Cancel" style:UIAlertActionStyleDefault handler:^( UIAlertAction* pAction ) { Result = ( int )xyMessageResult::Cancel; } ] ];
-			break;
-		}
+} // xyBeginChannelMessage
 
-		[ pViewController presentViewController:pAlertController animated:NO completion:^{ } ];
-	} );
+//////////////////////////////////////////////////////////////////////////
 
-	// Sleep until selection has been made
-	while( Result < 0 )
-		std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
-	
-	return ( xyMessageResult )Result;
+void xyCommitChannelMessage( const xyChannel& rChannel, const xyChannelMessage& rMessage )
+{
+	if( !rChannel || rMessage.Data.data() == nullptr )
+		return;
 
-#endif // XY_OS_IOS
+	xyChannelImpl& rImpl   = *rChannel.pImpl;
+	auto*          pHeader = reinterpret_cast< xyChannelRing::Header* >( rImpl.pSendData + rMessage.Position % rImpl.Capacity );
 
-} // xyMessageBox
+	pHeader->Committed.store( rMessage.Position + 1, std::memory_order_release );
+
+	rImpl.Wake( rImpl.pSend->DataSignal, rImpl.pSend->ReceiverWaiting );
+
+} // xyCommitChannelMessage
 
 //////////////////////////////////////////////////////////////////////////
 
-void xyMessageBox( std::string_view Title, std::string_view Message )
+bool xySendChannelMessage( const xyChannel& rChannel, std::span< const std::byte > Message, bool Wait )
 {
-	( void )xyMessageBox( Title, Message, xyMessageButtons::Ok );
+	xyChannelMessage Reserved = xyBeginChannelMessage( rChannel, Message.size(), Wait );
+	if( Reserved.Data.data() == nullptr )
+		return false;
 
-} // xyMessageBox
+	std::copy( Message.begin(), Message.end(), Reserved.Data.begin() );
+	xyCommitChannelMessage( rChannel, Reserved );
+
+	return true;
+
+} // xySendChannelMessage
 
 //////////////////////////////////////////////////////////////////////////
 
-xyDevice xyGetDevice( void )
+std::optional< std::span< const std::byte > > xyReceiveChannelMessage( const xyChannel& rChannel, bool Wait )
 {
+	if( !rChannel )
+		return std::nullopt;
 
-#if defined( XY_OS_WINDOWS )
+	xyChannelImpl& rImpl = *rChannel.pImpl;
+	xyChannelRing& rRing = *rImpl.pReceive;
 
-	CHAR  Buffer[ CNLEN + 1 ];
-	DWORD Size = static_cast< DWORD >( std::size( Buffer ) );
-	if( GetComputerNameA( Buffer, &Size ) )
+	// The previous message was never released
+	if( rImpl.ReceiveSize )
+		xyReleaseChannelMessage( rChannel );
+
+	for( ;; )
 	{
-		return { .Name={ Buffer, Size } };
-	}
+		const uint64_t Head    = rRing.Head.load( std::memory_order_relaxed );
+		auto*          pHeader = reinterpret_cast< xyChannelRing::Header* >( rImpl.pReceiveData + Head % rImpl.Capacity );
+		const uint32_t Signal  = rRing.DataSignal.load( std::memory_order_acquire );
 
-	return { };
+		// Released records are zeroed, so free space never holds a stale position
+		if( pHeader->Committed.load( std::memory_order_acquire ) == Head + 1 )
+		{
+			if( pHeader->Padding )
+			{
+				const uint32_t Gap = pHeader->Size;
+				pHeader->Committed.store( 0, std::memory_order_relaxed );
+				rRing.Head.store( Head + Gap, std::memory_order_release );
+				continue;
+			}
 
-#elif defined( XY_OS_MACOS ) // XY_OS_WINDOWS
+			rImpl.ReceiveSize = xyGetChannelRecordSize( pHeader->Size );
 
-	NSString* pName = [ [ NSHost currentHost ] name ];
+			return std::span< const std::byte >( reinterpret_cast< const std::byte* >( pHeader + 1 ), pHeader->Size );
+		}
 
-	return { .Name=[ pName UTF8String ] };
+		if( !Wait || !rImpl.Wait( rRing.DataSignal, rRing.ReceiverWaiting, Signal ) )
+			return std::nullopt;
+	}
 
-#elif defined( XY_OS_ANDROID ) // XY_OS_MACOS
+} // xyReceiveChannelMessage
 
-	xyContext& rContext = xyGetContext();
-	JNIEnv*    pJNI;
-	rContext.pPlatformImpl->pNativeActivity->vm->AttachCurrentThread( &pJNI, nullptr );
-
-	jclass      BuildClass           = pJNI->FindClass( "android/os/Build" );
-	jfieldID    ManufacturerField    = pJNI->GetStaticFieldID( BuildClass, "MANUFACTURER", "Ljava/lang/String;" );
-	jfieldID    ModelField           = pJNI->GetStaticFieldID( BuildClass, "MODEL", "Ljava/lang/String;" );
-	jstring     ManufacturerName     = static_cast< jstring >( pJNI->GetStaticObjectField( BuildClass, ManufacturerField ) );
-	jstring     ModelName            = static_cast< jstring >( pJNI->GetStaticObjectField( BuildClass, ModelField ) );
-	const char* pManufacturerNameUTF = pJNI->GetStringUTFChars( ManufacturerName, nullptr );
-	const char* pModelNameUTF        = pJNI->GetStringUTFChars( ModelName, nullptr );
-	std::string DeviceName           = std::string( pManufacturerNameUTF ) + ' ' + pModelNameUTF;
+//////////////////////////////////////////////////////////////////////////
 
-	pJNI->ReleaseStringUTFChars( ModelName, pModelNameUTF );
-	pJNI->ReleaseStringUTFChars( ManufacturerName, pManufacturerNameUTF );
-	rContext.pPlatformImpl->pNativeActivity->vm->DetachCurrentThread();
+void xyReleaseChannelMessage( const xyChannel& rChannel )
+{
+	if( !rChannel || rChannel.pImpl->ReceiveSize == 0 )
+		return;
 
-	return { .Name=std::move( DeviceName ) };
+	xyChannelImpl& rImpl = *rChannel.pImpl;
+	xyChannelRing& rRing = *rImpl.pReceive;
 
-#elif defined( XY_OS_IOS ) // XY_OS_ANDROID
+	const uint64_t Head    = rRing.Head.load( std::memory_order_relaxed );
+	auto*          pHeader = reinterpret_cast< xyChannelRing::Header* >( rImpl.pReceiveData + Head % rImpl.Capacity );
 
-	NSString* pDeviceName = [ [ UIDevice currentDevice ] name ];
+	// Any part of the record may hold a header on the next lap
+	pHeader->Committed.store( 0, std::memory_order_relaxed );
+	std::memset( reinterpret_cast< std::byte* >( pHeader + 1 ), 0, rImpl.ReceiveSize - sizeof( xyChannelRing::Header ) );
 
-	return { .Name=[ pDeviceName UTF8String ] };
+	rRing.Head.store( Head + rImpl.ReceiveSize, std::memory_order_release );
+	rImpl.ReceiveSize = 0;
 
-#endif // XY_OS_IOS
+	rImpl.Wake( rRing.SpaceSignal, rRing.SendersWaiting );
 
-} // xyGetDevice
+} // xyReleaseChannelMessage
 
 //////////////////////////////////////////////////////////////////////////
 
-xyTheme xyGetPreferredTheme( void )
+bool xyIsChannelConnected( const xyChannel& rChannel )
 {
-	// Default to light theme
-	xyTheme Theme = xyTheme::Light;
-
-#if defined( XY_OS_WINDOWS )
+	return rChannel && rChannel.pImpl->IsConnected();
 
-	DWORD AppsUseLightTheme;
-	DWORD DataSize = sizeof( AppsUseLightTheme );
-	if( RegGetValueA( HKEY_CURRENT_USER, "Software\\Microsoft\\Windows\\CurrentVersion\\Themes\\Personalize", "AppsUseLightTheme", RRF_RT_REG_DWORD, NULL, &AppsUseLightTheme, &DataSize ) == ERROR_SUCCESS )
-		Theme = AppsUseLightTheme ? xyTheme::Light : xyTheme::Dark;
+} // xyIsChannelConnected
 
-#elif defined( XY_OS_MACOS ) // XY_OS_WINDOWS
+//////////////////////////////////////////////////////////////////////////
 
-	NSString* pStyle = [ [ NSUserDefaults standardUserDefaults ] stringForKey:@"AppleInterfaceStyle" ];
-	if( [ pStyle isEqualToString:@"Dark" ] )
-		Theme = xyTheme::Dark;
+struct xyLocalizationCatalog
+{
+	static constexpr uint32_t Magic   = 0x434C5958; // "XYLC"
+	static constexpr uint32_t Version = 1;
 
-#elif defined( XY_OS_ANDROID ) // XY_OS_MACOS
+	struct FileHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t EntryCount;
+		uint32_t BucketCount;
 
-	xyContext& rContext = xyGetContext();
+	}; // FileHeader
 
-	switch( AConfiguration_getUiModeNight( rContext.pPlatformImpl->pConfiguration ) )
+	struct Entry
 	{
-		case ACONFIGURATION_UI_MODE_NIGHT_NO:  { Theme = xyTheme::Light; } break;
-		case ACONFIGURATION_UI_MODE_NIGHT_YES: { Theme = xyTheme::Dark;  } break;
+		uint64_t Hash;   // Of the key, so that keys missing from the catalog are not mistaken for whatever landed in their slot
+		uint32_t Offset; // Into the strings, which are null-terminated
+		uint32_t Size;
 
-		default: break;
-	}
+	}; // Entry
 
-#elif defined( XY_OS_IOS ) // XY_OS_ANDROID
+	static uint64_t GetSlot( uint64_t Hash, uint32_t Displacement );
+	static size_t   GetEntriesOffset( uint32_t BucketCount );
 
-	UITraitCollection* pTraitCollection = [ UITraitCollection currentTraitCollection ];
+	std::optional< std::string_view > Find( uint64_t Hash ) const;
 
-	switch( [ pTraitCollection userInterfaceStyle ] )
-	{
-		case UIUserInterfaceStyleLight: { Theme = xyTheme::Light; } break;
-		case UIUserInterfaceStyleDark:  { Theme = xyTheme::Dark;  } break;
+	xyMappedFile    File;
+	std::string     Path;
+	const uint32_t* pDisplacements = nullptr; // One per bucket. Moves the keys of a bucket to slots that no other key uses.
+	const Entry*    pEntries       = nullptr;
+	const char*     pStrings       = nullptr;
+	size_t          StringsSize    = 0;
+	uint32_t        EntryCount     = 0;
+	uint32_t        BucketCount    = 0;
 
-		default: break;
-	}
+}; // xyLocalizationCatalog
 
-#endif // XY_OS_IOS
+//////////////////////////////////////////////////////////////////////////
+
+struct xyLocalization
+{
+	static void OnConfigurationChanged( const xyConfigurationEvent& rEvent, void* pUserData );
 
-	return Theme;
+	bool Load( std::string_view LocaleName );
 
-} // xyGetPreferredTheme
+	std::mutex                                              Mutex;
+	std::string                                             Directory;
+	std::vector< std::unique_ptr< xyLocalizationCatalog > > Catalogs; // Never unmapped, since xyLocalize hands out views into them
+	std::atomic< const xyLocalizationCatalog* >             pActive = nullptr;
+	xyConfigurationSubscription                             Subscription;
+
+}; // xyLocalization
 
 //////////////////////////////////////////////////////////////////////////
 
-xyLanguage xyGetLanguage( void )
+static xyLocalization& xyGetLocalization( void )
 {
+	static xyLocalization Localization;
+	return Localization;
 
-#if defined( XY_OS_WINDOWS )
+} // xyGetLocalization
 
-	xyLanguage Language;
-	WCHAR      Buffer[ LOCALE_NAME_MAX_LENGTH ];
-	GetUserDefaultLocaleName( Buffer, static_cast< int >( std::size( Buffer ) ) );
+//////////////////////////////////////////////////////////////////////////
 
-	return { .LocaleName=xyUTF( Buffer ) };
+uint64_t xyLocalizationCatalog::GetSlot( uint64_t Hash, uint32_t Displacement )
+{
+	// SplitMix64 finalizer, so that every displacement scatters the keys of a bucket anew
+	uint64_t Value = Hash + ( Displacement + 1 ) * 0x9E3779B97F4A7C15ull;
+	Value          = ( Value ^ ( Value >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+	Value          = ( Value ^ ( Value >> 27 ) ) * 0x94D049BB133111EBull;
 
-#elif defined( XY_OS_MACOS ) // XY_OS_WINDOWS
+	return Value ^ ( Value >> 31 );
 
-	NSString* pLanguageCode = [ [ NSLocale currentLocale ] languageCode ];
+} // GetSlot
 
-	return { .LocaleName=[ pLanguageCode UTF8String ] };
+//////////////////////////////////////////////////////////////////////////
 
-#elif defined( XY_OS_ANDROID ) // XY_OS_MACOS
+size_t xyLocalizationCatalog::GetEntriesOffset( uint32_t BucketCount )
+{
+	return ( sizeof( FileHeader ) + BucketCount * sizeof( uint32_t ) + alignof( Entry ) - 1 ) & ~( alignof( Entry ) - 1 );
 
-	xyContext& rContext = xyGetContext();
-	char       LanguageCode[ 2 ];
-	AConfiguration_getLanguage( rContext.pPlatformImpl->pConfiguration, LanguageCode );
+} // GetEntriesOffset
 
-	return { .LocaleName=std::string( LanguageCode, 2 ) };
+//////////////////////////////////////////////////////////////////////////
 
-#elif defined( XY_OS_IOS ) // XY_OS_ANDROID
+std::optional< std::string_view > xyLocalizationCatalog::Find( uint64_t Hash ) const
+{
+	if( EntryCount == 0 )
+		return std::nullopt;
 
-	NSString* pLanguage = [ [ NSLocale preferredLanguages ] firstObject ];
+	const uint32_t Displacement = pDisplacements[ ( Hash >> 32 ) % BucketCount ];
+	const Entry&   rEntry       = pEntries[ GetSlot( Hash, Displacement ) % EntryCount ];
 
-	return { .LocaleName=[ pLanguage UTF8String ] };
+	if( rEntry.Hash != Hash || uint64_t( rEntry.Offset ) + rEntry.Size >= StringsSize )
+		return std::nullopt;
 
-#endif // XY_OS_IOS
+	return std::string_view( pStrings + rEntry.Offset, rEntry.Size );
 
-} // xyGetLanguage
+} // Find
 
 //////////////////////////////////////////////////////////////////////////
 
-xyBatteryState xyGetBatteryState( void )
+void xyLocalization::OnConfigurationChanged( const xyConfigurationEvent& rEvent, void* pUserData )
 {
-	xyBatteryState BatteryState;
+	if( rEvent.Type != xyConfigurationChange::Language )
+		return;
 
-#if defined( XY_OS_WINDOWS )
+	xyLocalization&               rLocalization = *static_cast< xyLocalization* >( pUserData );
+	std::lock_guard< std::mutex > Lock( rLocalization.Mutex );
 
-	SYSTEM_POWER_STATUS SystemPowerStatus;
-	if( GetSystemPowerStatus( &SystemPowerStatus ) && SystemPowerStatus.BatteryFlag ^ 128 )
-	{
-		BatteryState.CapacityPercentage = SystemPowerStatus.BatteryLifePercent;
-		BatteryState.Charging           = SystemPowerStatus.BatteryFlag & 8;
-		BatteryState.Valid              = true;
-	}
+	rLocalization.Load( xyGetLanguage().LocaleName );
 
-#elif defined( XY_OS_MACOS ) // XY_OS_WINDOWS
+} // OnConfigurationChanged
 
-	CFMutableDictionaryRef Service = IOServiceMatching( "IOPMPowerSource" );
-	if( io_registry_entry_t Entry = IOServiceGetMatchingService( kIOMasterPortDefault, Service ) )
-	{
-		CFMutableDictionaryRef Properties = nullptr;
-		if( IORegistryEntryCreateCFProperties( Entry, &Properties, nullptr, 0 ) == kIOReturnSuccess )
-		{
-			NSDictionary* pRawProperties = ( NSDictionary* )Properties;
-			bool          IsCharging     = [ [ pRawProperties objectForKey:@"IsCharging" ]      boolValue ];
-			double        Capacity       = [ [ pRawProperties objectForKey:@"CurrentCapacity" ] doubleValue ];
-			double        MaxCapacity    = [ [ pRawProperties objectForKey:@"MaxCapacity" ]     doubleValue ];
+//////////////////////////////////////////////////////////////////////////
 
-			BatteryState.CapacityPercentage = static_cast< uint8_t >( 100.0 * Capacity / MaxCapacity );
-			BatteryState.Charging           = IsCharging;
-			BatteryState.Valid              = true;
-		}
+bool xyLocalization::Load( std::string_view LocaleName )
+{
+	// "sv_SE.UTF-8" and "sv-SE" both look for "sv-SE" first and "sv" second
+	std::string Locale( LocaleName.substr( 0, LocaleName.find_first_of( ".@" ) ) );
+	std::replace( Locale.begin(), Locale.end(), '_', '-' );
 
-		IOObjectRelease( Entry );
-	}
+	std::array< std::string, 2 > Candidates = { Locale, Locale.substr( 0, Locale.find( '-' ) ) };
 
-#elif defined( XY_OS_ANDROID ) // XY_OS_MACOS
+	for( const std::string& rCandidate : Candidates )
+	{
+		if( rCandidate.empty() )
+			continue;
 
-	xyContext& rContext = xyGetContext();
-	JNIEnv*    pEnv;
-	rContext.pPlatformImpl->pNativeActivity->vm->AttachCurrentThread( &pEnv, nullptr );
-
-	jobject   Activity            = rContext.pPlatformImpl->pNativeActivity->clazz;
-	jclass    ActivityClass       = pEnv->GetObjectClass( Activity );
-	jstring   BatteryService      = ( jstring )pEnv->GetStaticObjectField( ActivityClass, pEnv->GetStaticFieldID( ActivityClass, "BATTERY_SERVICE", "Ljava/lang/String;" ) );
-	jobject   BatteryManager      = pEnv->CallObjectMethod( Activity, pEnv->GetMethodID( ActivityClass, "getSystemService", "(Ljava/lang/String;)Ljava/lang/Object;" ), BatteryService );
-	jclass    BatteryManagerClass = pEnv->GetObjectClass( BatteryManager );
-	jint      PropertyCapacity    = pEnv->GetStaticIntField( BatteryManagerClass, pEnv->GetStaticFieldID( BatteryManagerClass, "BATTERY_PROPERTY_CAPACITY", "I" ) );
-	jint      PropertyStatus      = pEnv->GetStaticIntField( BatteryManagerClass, pEnv->GetStaticFieldID( BatteryManagerClass, "BATTERY_PROPERTY_STATUS",   "I" ) );
-	jint      StatusCharging      = pEnv->GetStaticIntField( BatteryManagerClass, pEnv->GetStaticFieldID( BatteryManagerClass, "BATTERY_STATUS_CHARGING",   "I" ) );
-	jmethodID GetIntProperty      = pEnv->GetMethodID( BatteryManagerClass, "getIntProperty", "(I)I" );
-	jint      Capacity            = pEnv->CallIntMethod( BatteryManager, GetIntProperty, PropertyCapacity );
-	jint      Status              = pEnv->CallIntMethod( BatteryManager, GetIntProperty, PropertyStatus );
-
-	BatteryState.CapacityPercentage = static_cast< uint8_t >( Capacity );
-	BatteryState.Charging           = Status == StatusCharging;
-	BatteryState.Valid              = true;
-
-	rContext.pPlatformImpl->pNativeActivity->vm->DetachCurrentThread();
+		const std::string Path = Directory + '/' + rCandidate + ".xyloc";
 
-#elif defined( XY_OS_IOS ) // XY_OS_ANDROID
-	
-	UIDevice*   pDevice = [ UIDevice currentDevice ];
-	const float Level   = [ pDevice batteryLevel ];
-	
-	if( BatteryState.Valid = ( Level >= 0.0f ) )
-	{
-		BatteryState.CapacityPercentage = static_cast< uint8_t >( 100.0f * Level );
-		BatteryState.Charging           = [ pDevice batteryState ] == UIDeviceBatteryStateCharging;
+		// Catalogs that have been used before are still mapped
+		auto It = std::find_if( Catalogs.begin(), Catalogs.end(), [ & ]( const std::unique_ptr< xyLocalizationCatalog >& rpCatalog ) { return rpCatalog->Path == Path; } );
+		if( It != Catalogs.end() )
+		{
+			pActive.store( It->get(), std::memory_order_release );
+			return true;
+		}
+
+		xyMappedFile File = xyMapFile( Path, xyAccessPattern::Random );
+		if( !File || File.Data.size() < sizeof( xyLocalizationCatalog::FileHeader ) )
+			continue;
+
+		xyLocalizationCatalog::FileHeader Header;
+		std::memcpy( &Header, File.Data.data(), sizeof( Header ) );
+
+		const size_t EntriesOffset = xyLocalizationCatalog::GetEntriesOffset( Header.BucketCount );
+		const size_t StringsOffset = EntriesOffset + size_t( Header.EntryCount ) * sizeof( xyLocalizationCatalog::Entry );
+		if( Header.Magic != xyLocalizationCatalog::Magic || Header.Version != xyLocalizationCatalog::Version || Header.BucketCount == 0 || StringsOffset > File.Data.size() )
+			continue;
+
+		auto        pCatalog        = std::make_unique< xyLocalizationCatalog >();
+		const auto* pData           = reinterpret_cast< const char* >( File.Data.data() );
+		pCatalog->pDisplacements    = reinterpret_cast< const uint32_t* >( pData + sizeof( Header ) );
+		pCatalog->pEntries          = reinterpret_cast< const xyLocalizationCatalog::Entry* >( pData + EntriesOffset );
+		pCatalog->pStrings          = pData + StringsOffset;
+		pCatalog->StringsSize       = File.Data.size() - StringsOffset;
+		pCatalog->EntryCount        = Header.EntryCount;
+		pCatalog->BucketCount       = Header.BucketCount;
+		pCatalog->Path              = Path;
+		pCatalog->File              = std::move( File );
+
+		pActive.store( pCatalog.get(), std::memory_order_release );
+		Catalogs.push_back( std::move( pCatalog ) );
+
+		return true;
 	}
 
-#endif // XY_OS_IOS
+	// Keys fall back to their names rather than to the texts of the previous language
+	pActive.store( nullptr, std::memory_order_release );
 
-	return BatteryState;
+	return false;
 
-} // xyGetBatteryState
+} // Load
 
 //////////////////////////////////////////////////////////////////////////
 
-std::vector< xyDisplayAdapter > xyGetDisplayAdapters( void )
+bool xyLoadLocalization( std::string_view Directory, std::string_view LocaleName )
 {
-	std::vector< xyDisplayAdapter > DisplayAdapters;
+	xyLocalization&               rLocalization = xyGetLocalization();
+	std::lock_guard< std::mutex > Lock( rLocalization.Mutex );
 
-#if defined( XY_OS_WINDOWS )
+	rLocalization.Directory = Directory;
 
-	auto EnumProc = []( HMONITOR MonitorHandle, HDC /*DeviceContextHandle*/, LPRECT /*pRect*/, LPARAM UserData ) -> BOOL
+	if( LocaleName.empty() )
 	{
-		auto& rMonitors = *reinterpret_cast< std::vector< xyDisplayAdapter >* >( UserData );
-
-		MONITORINFOEXA Info = { sizeof( MONITORINFOEXA ) };
-		if( GetMonitorInfoA( MonitorHandle, &Info ) )
-		{
-			xyDisplayAdapter Adapter = { .Name     = Info.szDevice,
-			                             .FullRect = { .Left=Info.rcMonitor.left, .Top=Info.rcMonitor.top, .Right=Info.rcMonitor.right, .Bottom=Info.rcMonitor.bottom },
-			                             .WorkRect = { .Left=Info.rcWork   .left, .Top=Info.rcWork   .top, .Right=Info.rcWork   .right, .Bottom=Info.rcWork   .bottom } };
+		if( !rLocalization.Subscription )
+			rLocalization.Subscription = xySubscribeConfigurationChanges( xyLocalization::OnConfigurationChanged, &rLocalization );
 
-			DISPLAY_DEVICEA DisplayDevice = { .cb=sizeof( DISPLAY_DEVICEA ) };
-			if( EnumDisplayDevicesA( Adapter.Name.c_str(), 0, &DisplayDevice, 0 ) )
-				Adapter.Name = DisplayDevice.DeviceString;
+		return rLocalization.Load( xyGetLanguage().LocaleName );
+	}
 
-			rMonitors.emplace_back( std::move( Adapter ) );
-		}
+	rLocalization.Subscription = { };
 
-		// Always continue
-		return TRUE;
-	};
+	return rLocalization.Load( LocaleName );
 
-	EnumDisplayMonitors( NULL, NULL, EnumProc, reinterpret_cast< LPARAM >( &DisplayAdapters ) );
+} // xyLoadLocalization
 
-#elif defined( XY_OS_MACOS ) // XY_OS_WINDOWS
+//////////////////////////////////////////////////////////////////////////
 
-	for( NSScreen* pScreen in [ NSScreen screens ] )
+std::string_view xyLocalize( xyLocalizationKey Key )
+{
+	if( const xyLocalizationCatalog* pCatalog = xyGetLocalization().pActive.load( std::memory_order_acquire ) )
 	{
-		xyDisplayAdapter Adapter = { .Name     = [ [ pScreen localizedName ] UTF8String ],
-		                             .FullRect = { .Left=NSMinX( pScreen.frame ),        .Top=NSMinY( pScreen.frame ),        .Right=NSMaxX( pScreen.frame ),        .Bottom=NSMaxY( pScreen.frame ) },
-		                             .WorkRect = { .Left=NSMinX( pScreen.visibleFrame ), .Top=NSMinY( pScreen.visibleFrame ), .Right=NSMaxX( pScreen.visibleFrame ), .Bottom=NSMaxY( pScreen.visibleFrame ) } };
-
-		DisplayAdapters.emplace_back( std::move( Adapter ) );
+		if( std::optional< std::string_view > Text = pCatalog->Find( Key.Hash ) )
+			return *Text;
 	}
 
-#elif defined( XY_OS_ANDROID ) // XY_OS_MACOS
+	return Key.Name;
 
-	xyContext& rContext = xyGetContext();
-	JNIEnv*    pJNI;
-	rContext.pPlatformImpl->pNativeActivity->vm->AttachCurrentThread( &pJNI, nullptr );
+} // xyLocalize
 
-	jobject      Activity       = rContext.pPlatformImpl->pNativeActivity->clazz;
-	jclass       ActivityClass  = pJNI->GetObjectClass( Activity );
-	jstring      DisplayService = ( jstring )pJNI->GetStaticObjectField( ActivityClass, pJNI->GetStaticFieldID( ActivityClass, "DISPLAY_SERVICE", "Ljava/lang/String;" ) );
-	jobject      DisplayManager = pJNI->CallObjectMethod( Activity, pJNI->GetMethodID( ActivityClass, "getSystemService", "(Ljava/lang/String;)Ljava/lang/Object;" ), DisplayService );
-	jobjectArray Displays       = ( jobjectArray )pJNI->CallObjectMethod( DisplayManager, pJNI->GetMethodID( pJNI->GetObjectClass( DisplayManager ), "getDisplays", "()[Landroid/view/Display;" ) );
-	jsize        DisplayCount   = pJNI->GetArrayLength( Displays );
+//////////////////////////////////////////////////////////////////////////
 
-	for( jsize i = 0; i < DisplayCount; ++i )
-	{
-		jobject     Display      = pJNI->GetObjectArrayElement( Displays, i );
-		jclass      DisplayClass = pJNI->GetObjectClass( Display );
-		jstring     Name         = ( jstring )pJNI->CallObjectMethod( Display, pJNI->GetMethodID( DisplayClass, "getName", "()Ljava/lang/String;" ) );
-		const char* pNameUTF     = pJNI->GetStringUTFChars( Name, nullptr );
-		jclass      RectClass    = pJNI->FindClass( "android/graphics/Rect" );
-		jobject     Bounds       = pJNI->AllocObject( RectClass );
+std::vector< std::byte > xyCompileLocalizationCatalog( std::span< const xyLocalizationEntry > Entries )
+{
+	using Catalog = xyLocalizationCatalog;
 
-		xyDisplayAdapter Adapter = { .Name=pNameUTF };
+	const uint32_t EntryCount  = static_cast< uint32_t >( Entries.size() );
+	const uint32_t BucketCount = std::max( 1u, ( EntryCount + 3 ) / 4 );
 
-		// NOTE: "getRectSize" is deprecated as of SDK v30.
-		// The documentation suggests using WindowMetric#getBounds(), but there seems to be no way of obtaining the bounds of a specific Display object.
-		pJNI->CallVoidMethod( Display, pJNI->GetMethodID( DisplayClass, "getRectSize", "(Landroid/graphics/Rect;)V" ), Bounds );
-		Adapter.FullRect.Left   = pJNI->GetIntField( Bounds, pJNI->GetFieldID( RectClass, "left",   "I" ) );
-		Adapter.FullRect.Top    = pJNI->GetIntField( Bounds, pJNI->GetFieldID( RectClass, "top",    "I" ) );
-		Adapter.FullRect.Right  = pJNI->GetIntField( Bounds, pJNI->GetFieldID( RectClass, "right",  "I" ) );
-		Adapter.FullRect.Bottom = pJNI->GetIntField( Bounds, pJNI->GetFieldID( RectClass, "bottom", "I" ) );
+	std::vector< uint64_t > Hashes( EntryCount );
+	std::transform( Entries.begin(), Entries.end(), Hashes.begin(), []( const xyLocalizationEntry& rEntry ) { return xyHashString( rEntry.Key ); } );
 
-		if( jobject DisplayCutout = pJNI->CallObjectMethod( Display, pJNI->GetMethodID( DisplayClass, "getCutout", "()Landroid/view/DisplayCutout;" ) ) )
-		{
-			jclass DisplayCutoutClass = pJNI->GetObjectClass( DisplayCutout );
+	// Keys are only ever compared by hash
+	std::vector< uint64_t > SortedHashes = Hashes;
+	std::sort( SortedHashes.begin(), SortedHashes.end() );
+	if( std::adjacent_find( SortedHashes.begin(), SortedHashes.end() ) != SortedHashes.end() )
+		return { };
 
-			Adapter.WorkRect.Left   = pJNI->CallIntMethod( DisplayCutout, pJNI->GetMethodID( DisplayCutoutClass, "getSafeInsetLeft",   "()I" ) );
-			Adapter.WorkRect.Top    = pJNI->CallIntMethod( DisplayCutout, pJNI->GetMethodID( DisplayCutoutClass, "getSafeInsetTop",    "()I" ) );
-			Adapter.WorkRect.Right  = pJNI->CallIntMethod( DisplayCutout, pJNI->GetMethodID( DisplayCutoutClass, "getSafeInsetRight",  "()I" ) );
-			Adapter.WorkRect.Bottom = pJNI->CallIntMethod( DisplayCutout, pJNI->GetMethodID( DisplayCutoutClass, "getSafeInsetBottom", "()I" ) );
-		}
-		else
+	std::vector< std::vector< uint32_t > > Buckets( BucketCount );
+	for( uint32_t Index = 0; Index < EntryCount; ++Index )
+		Buckets[ ( Hashes[ Index ] >> 32 ) % BucketCount ].push_back( Index );
+
+	// Hash and displace: place the largest buckets first, while most slots are still free
+	std::vector< uint32_t > Order( BucketCount );
+	std::iota( Order.begin(), Order.end(), 0u );
+	std::stable_sort( Order.begin(), Order.end(), [ & ]( uint32_t Left, uint32_t Right ) { return Buckets[ Left ].size() > Buckets[ Right ].size(); } );
+
+	std::vector< uint32_t > Displacements( BucketCount, 0 );
+	std::vector< int64_t >  Slots( EntryCount, -1 );
+	std::vector< uint64_t > Candidates;
+
+	for( uint32_t Bucket : Order )
+	{
+		if( Buckets[ Bucket ].empty() )
+			break;
+
+		for( uint32_t Displacement = 0;; ++Displacement )
 		{
-			// TODO: There are other ways to obtain the safe area
-			Adapter.WorkRect = Adapter.FullRect;
-		}
+			if( Displacement == UINT32_MAX )
+				return { };
 
-		DisplayAdapters.emplace_back( std::move( Adapter ) );
+			Candidates.clear();
+			for( uint32_t Index : Buckets[ Bucket ] )
+				Candidates.push_back( Catalog::GetSlot( Hashes[ Index ], Displacement ) % EntryCount );
 
-		pJNI->ReleaseStringUTFChars( Name, pNameUTF );
+			const bool Free = std::all_of( Candidates.begin(), Candidates.end(), [ & ]( uint64_t Slot ) { return Slots[ Slot ] < 0; } );
+			std::sort( Candidates.begin(), Candidates.end() );
+
+			if( Free && std::adjacent_find( Candidates.begin(), Candidates.end() ) == Candidates.end() )
+			{
+				for( uint32_t Index : Buckets[ Bucket ] )
+					Slots[ Catalog::GetSlot( Hashes[ Index ], Displacement ) % EntryCount ] = Index;
+
+				Displacements[ Bucket ] = Displacement;
+				break;
+			}
+		}
 	}
 
-	rContext.pPlatformImpl->pNativeActivity->vm->DetachCurrentThread();
+	const size_t             EntriesOffset = Catalog::GetEntriesOffset( BucketCount );
+	const size_t             StringsOffset = EntriesOffset + size_t( EntryCount ) * sizeof( Catalog::Entry );
+	std::vector< std::byte > Result( StringsOffset );
 
-#elif defined( XY_OS_IOS ) // XY_OS_ANDROID
-	
-	NSArray< UIScreen* >* pScreens = [ UIScreen screens ];
+	const Catalog::FileHeader Header = { .Magic=Catalog::Magic, .Version=Catalog::Version, .EntryCount=EntryCount, .BucketCount=BucketCount };
+	std::memcpy( Result.data(), &Header, sizeof( Header ) );
+	std::memcpy( Result.data() + sizeof( Header ), Displacements.data(), Displacements.size() * sizeof( uint32_t ) );
 
-	for( UIScreen* pScreen in pScreens )
+	for( uint32_t Slot = 0; Slot < EntryCount; ++Slot )
 	{
-		NSString*        pScreenName = ( pScreen == [ UIScreen mainScreen ] ) ? @"Main Display" : [ NSString stringWithFormat:@"External Display #%d", [ pScreens indexOfObject:pScreen ] ];
-		CGRect           Bounds      = [ pScreen bounds ];
-		xyDisplayAdapter MainDisplay = { .Name     = [ pScreenName UTF8String ],
-		                                 .FullRect = { .Left=CGRectGetMinX( Bounds ), .Top=CGRectGetMinY( Bounds ), .Right=CGRectGetMaxX( Bounds ), .Bottom=CGRectGetMaxY( Bounds ) } };
+		const xyLocalizationEntry& rEntry = Entries[ Slots[ Slot ] ];
+		const Catalog::Entry       Entry  = { .Hash=Hashes[ Slots[ Slot ] ], .Offset=static_cast< uint32_t >( Result.size() - StringsOffset ), .Size=static_cast< uint32_t >( rEntry.Text.size() ) };
 
-		// TODO: Obtain the safe area
+		std::memcpy( Result.data() + EntriesOffset + Slot * sizeof( Entry ), &Entry, sizeof( Entry ) );
 
-		DisplayAdapters.emplace_back( std::move( MainDisplay ) );
+		const auto* pText = reinterpret_cast< const std::byte* >( rEntry.Text.data() );
+		Result.insert( Result.end(), pText, pText + rEntry.Text.size() );
+		Result.push_back( std::byte{ 0 } );
 	}
 
-#endif // XY_OS_IOS
-
-	return DisplayAdapters;
+	return Result;
 
-} // xyGetDisplayAdapters
+} // xyCompileLocalizationCatalog
 
 
 #endif // XY_IMPLEMENT
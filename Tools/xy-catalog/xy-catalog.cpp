@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2021 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * xy-catalog: Compiles a text file of localized strings into a catalog for xyLoadLocalization.
+ *
+ * Usage: xy-catalog <input> <output>
+ * Each line of the input reads "key = text". Blank lines and lines starting with '#' are ignored.
+ * Texts may contain the escape sequences \n, \t and \\. The output is conventionally named after its locale, such as "sv-SE.xyloc".
+ */
+
+#define XY_IMPLEMENT
+#include <xy-main.h>
+
+#include <cstdio>
+#include <deque>
+#include <fstream>
+
+//////////////////////////////////////////////////////////////////////////
+
+static std::string_view Trim( std::string_view String )
+{
+	const size_t First = String.find_first_not_of( " \t\r" );
+	if( First == std::string_view::npos )
+		return { };
+
+	return String.substr( First, String.find_last_not_of( " \t\r" ) - First + 1 );
+
+} // Trim
+
+//////////////////////////////////////////////////////////////////////////
+
+static std::string Unescape( std::string_view String )
+{
+	std::string Result;
+	Result.reserve( String.size() );
+
+	for( size_t Index = 0; Index < String.size(); ++Index )
+	{
+		if( String[ Index ] != '\\' || Index + 1 == String.size() )
+		{
+			Result += String[ Index ];
+			continue;
+		}
+
+		switch( String[ ++Index ] )
+		{
+			case 'n': { Result += '\n'; } break;
+			case 't': { Result += '\t'; } break;
+			default:  { Result += String[ Index ]; } break;
+		}
+	}
+
+	return Result;
+
+} // Unescape
+
+//////////////////////////////////////////////////////////////////////////
+
+int xyMain( void )
+{
+	const std::span< char* > Args = xyGetContext().CommandLineArgs;
+
+	if( Args.size() < 3 )
+	{
+		std::fprintf( stderr, "Usage: xy-catalog <input> <output>\n" );
+		return 1;
+	}
+
+	std::ifstream Input( Args[ 1 ] );
+	if( !Input )
+	{
+		std::fprintf( stderr, "Could not open '%s'\n", Args[ 1 ] );
+		return 1;
+	}
+
+	// The entries view these, so they must not move
+	std::deque< std::pair< std::string, std::string > > Strings;
+	std::vector< xyLocalizationEntry >                  Entries;
+	std::string                                         Line;
+
+	for( size_t LineNumber = 1; std::getline( Input, Line ); ++LineNumber )
+	{
+		const std::string_view Trimmed = Trim( Line );
+		if( Trimmed.empty() || Trimmed[ 0 ] == '#' )
+			continue;
+
+		const size_t Separator = Trimmed.find( '=' );
+		if( Separator == std::string_view::npos || Trim( Trimmed.substr( 0, Separator ) ).empty() )
+		{
+			std::fprintf( stderr, "%s:%zu: Expected 'key = text'\n", Args[ 1 ], LineNumber );
+			return 1;
+		}
+
+		auto& rString = Strings.emplace_back( Trim( Trimmed.substr( 0, Separator ) ), Unescape( Trim( Trimmed.substr( Separator + 1 ) ) ) );
+		Entries.push_back( { .Key=rString.first, .Text=rString.second } );
+	}
+
+	const std::vector< std::byte > Catalog = xyCompileLocalizationCatalog( Entries );
+	if( Catalog.empty() )
+	{
+		std::fprintf( stderr, "%s: Duplicate keys\n", Args[ 1 ] );
+		return 1;
+	}
+
+	std::ofstream Output( Args[ 2 ], std::ios::binary );
+	if( !Output.write( reinterpret_cast< const char* >( Catalog.data() ), static_cast< std::streamsize >( Catalog.size() ) ) )
+	{
+		std::fprintf( stderr, "Could not write '%s'\n", Args[ 2 ] );
+		return 1;
+	}
+
+	std::printf( "%zu strings\n", Entries.size() );
+
+	return 0;
+
+} // xyMain
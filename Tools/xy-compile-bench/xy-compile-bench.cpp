@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2021 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * xy-compile-bench: Compares how long a source file takes to compile when it includes xy.h and when it imports the xy module,
+ * and how long the one-off units (xy-implement.cpp and xy.cppm) take. Checks that the module links against xy-implement.cpp.
+ *
+ * Build: c++ -std=c++20 -I<xy>/Include Tools/xy-compile-bench/xy-compile-bench.cpp -o xy-compile-bench
+ * Usage: xy-compile-bench <g++ or clang++> <path to xy/Include> [number of runs]
+ */
+
+#define XY_IMPLEMENT
+#include <xy-main.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+//////////////////////////////////////////////////////////////////////////
+
+// The same body is compiled after either '#include <xy.h>' or 'import xy;', so the only difference is how the declarations are obtained
+static const char* pConsumerBody = R"(
+int Consume( void )
+{
+	xySmallVector< int, 8 > Values = { 1, 2, 3 };
+	xyLog( xyLogLevel::Info, "%d values, %zu arguments\n", static_cast< int >( Values.size() ), xyGetContext().CommandLineArgs.size() );
+	return static_cast< int >( xyGetStartupProfile().ToMain.count() );
+}
+)";
+
+// Only used for the link check, so that the consumer has an entry point without pulling in xy-main.h
+static const char* pLinkMain = R"(
+int main( void )
+{
+	return Consume() < 0;
+}
+)";
+
+struct Toolchain
+{
+	std::string Command;
+	std::string ModuleFlags;       // Added when compiling the module interface and the units that import it
+	std::string InterfaceFlags;    // Added when compiling the module interface
+	std::string InterfaceOutput;   // What the module interface compiles to, which is also linked in
+	std::string ImportFlags;       // Added when importing the module
+
+}; // Toolchain
+
+//////////////////////////////////////////////////////////////////////////
+
+static Toolchain DetectToolchain( const std::string& rCommand )
+{
+	Toolchain Result;
+	Result.Command = rCommand;
+
+	if( rCommand.find( "clang" ) != std::string::npos )
+	{
+		Result.InterfaceFlags  = "--precompile";
+		Result.InterfaceOutput = "xy.pcm";
+		Result.ImportFlags     = "-fmodule-file=xy=xy.pcm";
+	}
+	else
+	{
+		// GCC writes the compiled module interface to gcm.cache/ in the working directory, next to the object file. It does not recognize the .cppm extension.
+		Result.ModuleFlags     = "-fmodules-ts";
+		Result.InterfaceFlags  = "-c -x c++";
+		Result.InterfaceOutput = "xy-module.o";
+	}
+
+	return Result;
+
+} // DetectToolchain
+
+//////////////////////////////////////////////////////////////////////////
+
+// Runs a command in the scratch directory and returns the average wall time of the runs, or nothing if any of them failed. The output goes to <pName>.log.
+static std::optional< std::chrono::duration< double > > Measure( const std::filesystem::path& rDirectory, const char* pName, const std::string& rCommand, int Runs )
+{
+	const std::string Command = "cd \"" + rDirectory.string() + "\" && " + rCommand + " > " + pName + ".log 2>&1";
+	auto              Total   = std::chrono::steady_clock::duration::zero();
+
+	for( int Run = 0; Run < Runs; ++Run )
+	{
+		const auto Start = std::chrono::steady_clock::now();
+
+		if( std::system( Command.c_str() ) != 0 )
+			return std::nullopt;
+
+		Total += std::chrono::steady_clock::now() - Start;
+	}
+
+	return std::chrono::duration< double >( Total ) / Runs;
+
+} // Measure
+
+//////////////////////////////////////////////////////////////////////////
+
+static void Report( const char* pDescription, const std::filesystem::path& rDirectory, const char* pName, const std::optional< std::chrono::duration< double > >& rTime )
+{
+	if( rTime )
+	{
+		std::printf( "  %-34s %8.3f s\n", pDescription, rTime->count() );
+		return;
+	}
+
+	std::printf( "  %-34s   failed\n", pDescription );
+
+	// Show the first few errors, which is usually enough to tell why
+	std::ifstream Log( rDirectory / ( std::string( pName ) + ".log" ) );
+	std::string   Line;
+	for( int Count = 0; Count < 3 && std::getline( Log, Line ); )
+	{
+		if( Line.find( "error:" ) != std::string::npos )
+		{
+			std::printf( "    %s\n", Line.c_str() );
+			++Count;
+		}
+	}
+
+} // Report
+
+//////////////////////////////////////////////////////////////////////////
+
+int xyMain( void )
+{
+	const std::span< char* > Args = xyGetContext().CommandLineArgs;
+
+	if( Args.size() < 3 )
+	{
+		std::fprintf( stderr, "Usage: xy-compile-bench <g++ or clang++> <path to xy/Include> [number of runs]\n" );
+		return 1;
+	}
+
+	const Toolchain             Tools     = DetectToolchain( Args[ 1 ] );
+	const std::filesystem::path Include   = std::filesystem::absolute( Args[ 2 ] );
+	const int                   Runs      = Args.size() > 3 ? std::max( std::atoi( Args[ 3 ] ), 1 ) : 5;
+	const std::filesystem::path Directory = std::filesystem::temp_directory_path() / "xy-compile-bench";
+	const std::string           Base      = Tools.Command + " -std=c++20 -O0 -I\"" + Include.string() + "\"";
+
+	std::filesystem::remove_all( Directory );
+	std::filesystem::create_directories( Directory );
+
+	std::ofstream( Directory / "include.cpp" ) << "#include <xy.h>\n" << pConsumerBody;
+	std::ofstream( Directory / "import.cpp" ) << "import xy;\n" << pConsumerBody << pLinkMain;
+
+	std::printf( "Average of %d runs with %s:\n", Runs, Tools.Command.c_str() );
+
+	// Header-only and standalone-implementation mode compile every consumer the same way. They differ in whether XY_IMPLEMENT is defined in one of the app's own files, which then pays the implementation cost each time it changes, or in xy-implement.cpp, which is built once.
+	const auto IncludeTime   = Measure( Directory, "include", Base + " -c include.cpp -o include.o", Runs );
+	const auto ImplementTime = Measure( Directory, "implement", Base + " -c -x c++ \"" + ( Include / "xy-implement.cpp" ).string() + "\" -o implement.o", Runs );
+	const auto InterfaceTime = Measure( Directory, "interface", Base + " " + Tools.ModuleFlags + " " + Tools.InterfaceFlags + " \"" + ( Include / "xy.cppm" ).string() + "\" -o " + Tools.InterfaceOutput, 1 );
+	const auto ImportTime    = InterfaceTime ? Measure( Directory, "import", Base + " " + Tools.ModuleFlags + " " + Tools.ImportFlags + " -c import.cpp -o import.o", Runs ) : std::nullopt;
+
+	Report( "Consumer, #include <xy.h>", Directory, "include", IncludeTime );
+	Report( "Consumer, import xy", Directory, InterfaceTime ? "import" : "interface", ImportTime );
+	Report( "Implementation (xy-implement.cpp)", Directory, "implement", ImplementTime );
+	Report( "Module interface (xy.cppm), once", Directory, "interface", InterfaceTime );
+
+	if( IncludeTime && ImportTime )
+		std::printf( "Importing saves %.3f s per consumer\n", ( *IncludeTime - *ImportTime ).count() );
+
+	// The names that the module exports have to resolve to the definitions in xy-implement.cpp
+	if( ImplementTime && ImportTime )
+	{
+		const bool Links = Measure( Directory, "link", Base + " import.o implement.o " + Tools.InterfaceOutput + " -o linked -pthread", 1 ).has_value();
+
+		std::printf( "The module %s against xy-implement.cpp\n", Links ? "links" : "does not link" );
+
+		if( !Links )
+			return 1;
+	}
+
+	return IncludeTime ? 0 : 1;
+
+} // xyMain
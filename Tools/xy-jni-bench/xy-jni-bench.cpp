@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2021 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+/*
+ * xy-jni-bench: Runs the JNI cache against a mock JNI environment, so that it can be checked and measured without a device.
+ *
+ * Usage: xy-jni-bench [iterations] [lookup cost in nanoseconds] [call cost in nanoseconds]
+ * Build against the jni.h of any desktop JDK, e.g.:
+ *   c++ -std=c++20 -O2 -I../../Include -I"$JAVA_HOME/include" -I"$JAVA_HOME/include/linux" xy-jni-bench.cpp -o xy-jni-bench -pthread
+ *
+ * First verifies that xyLoadJNICache resolves every member, and that it leaves the members of a missing class null without leaving an exception pending.
+ * Then compares a battery query that looks everything up on each call, as the Android getters used to, with one that goes through the cache.
+ * The mock makes each class, method and field lookup take the given time, so the result scales with what is measured on a real device.
+ */
+
+#define XY_IMPLEMENT
+#include <xy-main.h>
+#include <xy-platforms/xy-jni.h>
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <unordered_map>
+
+//////////////////////////////////////////////////////////////////////////
+
+struct MockJVM
+{
+	std::deque< std::string >                 Names;   // Every handle and ID is the index of its name, plus one
+	std::unordered_map< std::string, size_t > Indices;
+	std::string                               MissingClass;
+	std::chrono::nanoseconds                  LookupCost = { };
+	std::chrono::nanoseconds                  CallCost   = { };
+	uint64_t                                  Lookups    = 0;
+	uint64_t                                  Calls      = 0;
+	uint64_t                                  Misuses    = 0; // Calls made while an exception was pending, which JNI does not allow
+	bool                                      Pending    = false;
+
+}; // MockJVM
+
+static MockJVM JVM;
+
+//////////////////////////////////////////////////////////////////////////
+
+template< typename Handle >
+static Handle Intern( std::string Name )
+{
+	auto [ It, Inserted ] = JVM.Indices.try_emplace( std::move( Name ), JVM.Names.size() );
+	if( Inserted )
+		JVM.Names.push_back( It->first );
+
+	return reinterpret_cast< Handle >( static_cast< uintptr_t >( It->second + 1 ) );
+
+} // Intern
+
+//////////////////////////////////////////////////////////////////////////
+
+template< typename Handle >
+static const std::string& NameOf( Handle Value )
+{
+	return JVM.Names[ reinterpret_cast< uintptr_t >( Value ) - 1 ];
+
+} // NameOf
+
+//////////////////////////////////////////////////////////////////////////
+
+static void Spend( std::chrono::nanoseconds Cost, uint64_t& rCounter )
+{
+	if( JVM.Pending )
+		++JVM.Misuses;
+
+	++rCounter;
+
+	const auto Until = std::chrono::steady_clock::now() + Cost;
+	while( std::chrono::steady_clock::now() < Until ) { }
+
+} // Spend
+
+//////////////////////////////////////////////////////////////////////////
+
+static jclass JNICALL FindClass( JNIEnv*, const char* pName )
+{
+	Spend( JVM.LookupCost, JVM.Lookups );
+
+	if( pName == JVM.MissingClass )
+	{
+		JVM.Pending = true;
+		return nullptr;
+	}
+
+	return Intern< jclass >( std::string( "class:" ) + pName );
+
+} // FindClass
+
+//////////////////////////////////////////////////////////////////////////
+
+static jclass JNICALL GetObjectClass( JNIEnv*, jobject Object )
+{
+	Spend( JVM.CallCost, JVM.Calls );
+
+	// Services are named after the class that implements them
+	const std::string& rName = NameOf( Object );
+	if( rName == "service:batterymanager" ) return Intern< jclass >( "class:android/os/BatteryManager" );
+	else                                    return Intern< jclass >( "class:android/app/NativeActivity" );
+
+} // GetObjectClass
+
+//////////////////////////////////////////////////////////////////////////
+
+static std::string MemberName( const char* pKind, jclass Class, const char* pName )
+{
+	return pKind + NameOf( Class ).substr( 6 ) + "." + pName;
+
+} // MemberName
+
+static jmethodID JNICALL GetMethodID      ( JNIEnv*, jclass Class, const char* pName, const char* ) { Spend( JVM.LookupCost, JVM.Lookups ); return Intern< jmethodID >( MemberName( "method:", Class, pName ) ); }
+static jfieldID  JNICALL GetFieldID       ( JNIEnv*, jclass Class, const char* pName, const char* ) { Spend( JVM.LookupCost, JVM.Lookups ); return Intern< jfieldID >( MemberName( "field:", Class, pName ) ); }
+static jfieldID  JNICALL GetStaticFieldID ( JNIEnv*, jclass Class, const char* pName, const char* ) { Spend( JVM.LookupCost, JVM.Lookups ); return Intern< jfieldID >( MemberName( "field:", Class, pName ) ); }
+static jstring   JNICALL NewStringUTF     ( JNIEnv*, const char* pString )                           { Spend( JVM.CallCost, JVM.Calls ); return Intern< jstring >( std::string( "string:" ) + pString ); }
+static jobject   JNICALL NewGlobalRef     ( JNIEnv*, jobject Object )                                { Spend( JVM.CallCost, JVM.Calls ); return Object; }
+static jint      JNICALL PushLocalFrame   ( JNIEnv*, jint )                                          { Spend( JVM.CallCost, JVM.Calls ); return 0; }
+static jobject   JNICALL PopLocalFrame    ( JNIEnv*, jobject Result )                                { Spend( JVM.CallCost, JVM.Calls ); return Result; }
+static void      JNICALL ExceptionClear   ( JNIEnv* )                                                { JVM.Pending = false; }
+
+//////////////////////////////////////////////////////////////////////////
+
+static jint JNICALL GetStaticIntField( JNIEnv*, jclass, jfieldID Field )
+{
+	Spend( JVM.CallCost, JVM.Calls );
+
+	const std::string& rName = NameOf( Field );
+	if( rName.ends_with( ".BATTERY_PROPERTY_CAPACITY" ) ) return 4;
+	if( rName.ends_with( ".BATTERY_PROPERTY_STATUS" ) )   return 6;
+	if( rName.ends_with( ".BATTERY_STATUS_CHARGING" ) )   return 2;
+
+	return 0;
+
+} // GetStaticIntField
+
+//////////////////////////////////////////////////////////////////////////
+
+static jobject JNICALL GetStaticObjectField( JNIEnv*, jclass, jfieldID Field )
+{
+	Spend( JVM.CallCost, JVM.Calls );
+
+	return NameOf( Field ).ends_with( ".BATTERY_SERVICE" ) ? Intern< jobject >( "string:batterymanager" ) : nullptr;
+
+} // GetStaticObjectField
+
+//////////////////////////////////////////////////////////////////////////
+
+static jobject JNICALL CallObjectMethodV( JNIEnv*, jobject, jmethodID Method, va_list Arguments )
+{
+	Spend( JVM.CallCost, JVM.Calls );
+
+	if( !NameOf( Method ).ends_with( ".getSystemService" ) )
+		return nullptr;
+
+	const jstring Service = va_arg( Arguments, jstring );
+	return Intern< jobject >( "service:" + NameOf( Service ).substr( 7 ) );
+
+} // CallObjectMethodV
+
+//////////////////////////////////////////////////////////////////////////
+
+static jint JNICALL CallIntMethodV( JNIEnv*, jobject, jmethodID Method, va_list Arguments )
+{
+	Spend( JVM.CallCost, JVM.Calls );
+
+	if( !NameOf( Method ).ends_with( ".getIntProperty" ) )
+		return 0;
+
+	// Reports 80 percent, charging
+	return va_arg( Arguments, jint ) == 4 ? 80 : 2;
+
+} // CallIntMethodV
+
+//////////////////////////////////////////////////////////////////////////
+
+static JNIEnv* MakeMockEnv( void )
+{
+	using FunctionTable = std::remove_cv_t< std::remove_pointer_t< decltype( JNIEnv::functions ) > >;
+
+	static FunctionTable Table = [ ]
+	{
+		FunctionTable Functions;
+		std::memset( &Functions, 0, sizeof( Functions ) );
+
+		Functions.FindClass            = FindClass;
+		Functions.GetObjectClass       = GetObjectClass;
+		Functions.GetMethodID          = GetMethodID;
+		Functions.GetFieldID           = GetFieldID;
+		Functions.GetStaticFieldID     = GetStaticFieldID;
+		Functions.GetStaticIntField    = GetStaticIntField;
+		Functions.GetStaticObjectField = GetStaticObjectField;
+		Functions.CallObjectMethodV    = CallObjectMethodV;
+		Functions.CallIntMethodV       = CallIntMethodV;
+		Functions.NewStringUTF         = NewStringUTF;
+		Functions.NewGlobalRef         = NewGlobalRef;
+		Functions.PushLocalFrame       = PushLocalFrame;
+		Functions.PopLocalFrame        = PopLocalFrame;
+		Functions.ExceptionClear       = ExceptionClear;
+
+		return Functions;
+	}( );
+
+	static JNIEnv Env;
+	Env.functions = &Table;
+
+	return &Env;
+
+} // MakeMockEnv
+
+//////////////////////////////////////////////////////////////////////////
+
+// How xyGetBatteryState queried the battery before the cache existed
+static bool QueryBatteryUncached( JNIEnv* pEnv, jobject Activity, uint8_t& rCapacity )
+{
+	jclass    ActivityClass       = pEnv->GetObjectClass( Activity );
+	jstring   BatteryService      = ( jstring )pEnv->GetStaticObjectField( ActivityClass, pEnv->GetStaticFieldID( ActivityClass, "BATTERY_SERVICE", "Ljava/lang/String;" ) );
+	jobject   BatteryManager      = pEnv->CallObjectMethod( Activity, pEnv->GetMethodID( ActivityClass, "getSystemService", "(Ljava/lang/String;)Ljava/lang/Object;" ), BatteryService );
+	jclass    BatteryManagerClass = pEnv->GetObjectClass( BatteryManager );
+	jint      PropertyCapacity    = pEnv->GetStaticIntField( BatteryManagerClass, pEnv->GetStaticFieldID( BatteryManagerClass, "BATTERY_PROPERTY_CAPACITY", "I" ) );
+	jint      PropertyStatus      = pEnv->GetStaticIntField( BatteryManagerClass, pEnv->GetStaticFieldID( BatteryManagerClass, "BATTERY_PROPERTY_STATUS",   "I" ) );
+	jint      StatusCharging      = pEnv->GetStaticIntField( BatteryManagerClass, pEnv->GetStaticFieldID( BatteryManagerClass, "BATTERY_STATUS_CHARGING",   "I" ) );
+	jmethodID GetIntProperty      = pEnv->GetMethodID( BatteryManagerClass, "getIntProperty", "(I)I" );
+
+	rCapacity = static_cast< uint8_t >( pEnv->CallIntMethod( BatteryManager, GetIntProperty, PropertyCapacity ) );
+	return pEnv->CallIntMethod( BatteryManager, GetIntProperty, PropertyStatus ) == StatusCharging;
+
+} // QueryBatteryUncached
+
+//////////////////////////////////////////////////////////////////////////
+
+// How xyGetBatteryState queries the battery through the cache
+static bool QueryBatteryCached( JNIEnv* pEnv, const xyJNICache& rCache, uint8_t& rCapacity )
+{
+	rCapacity = static_cast< uint8_t >( pEnv->CallIntMethod( rCache.BatteryManager, rCache.BatteryManagerGetIntProperty, rCache.BatteryPropertyCapacity ) );
+	return pEnv->CallIntMethod( rCache.BatteryManager, rCache.BatteryManagerGetIntProperty, rCache.BatteryPropertyStatus ) == rCache.BatteryStatusCharging;
+
+} // QueryBatteryCached
+
+//////////////////////////////////////////////////////////////////////////
+
+static bool Check( bool Condition, const char* pWhat )
+{
+	if( !Condition )
+		std::fprintf( stderr, "FAILED: %s\n", pWhat );
+
+	return Condition;
+
+} // Check
+
+//////////////////////////////////////////////////////////////////////////
+
+template< typename Query >
+static double Measure( size_t Iterations, Query&& rrQuery )
+{
+	JVM.Lookups = 0;
+	JVM.Calls   = 0;
+
+	const auto Start = std::chrono::steady_clock::now();
+
+	for( size_t i = 0; i < Iterations; ++i )
+		rrQuery();
+
+	return std::chrono::duration< double, std::nano >( std::chrono::steady_clock::now() - Start ).count() / static_cast< double >( Iterations );
+
+} // Measure
+
+//////////////////////////////////////////////////////////////////////////
+
+int xyMain( void )
+{
+	const std::span< char* > Args       = xyGetContext().CommandLineArgs;
+	const size_t             Iterations = Args.size() > 1 ? std::strtoull( Args[ 1 ], nullptr, 10 ) : 100000;
+	JNIEnv*                  pEnv       = MakeMockEnv();
+	const jobject            Activity   = Intern< jobject >( "activity" );
+	bool                     Passed     = true;
+
+	// Every member resolves while all classes exist
+	xyJNICache Cache;
+	xyLoadJNICache( pEnv, Activity, Cache );
+
+	Passed &= Check( Cache.BatteryManager && Cache.BatteryManagerGetIntProperty && Cache.BatteryPropertyCapacity == 4 && Cache.BatteryStatusCharging == 2, "battery members resolve" );
+	Passed &= Check( Cache.DisplayGetCutout && Cache.DisplayCutoutGetSafeInsetLeft && Cache.RectClass && Cache.RectBottom && Cache.FutureTaskGet, "display and other members resolve" );
+	Passed &= Check( JVM.Misuses == 0 && !JVM.Pending, "no exception is left pending" );
+
+	// A class that the API level lacks leaves its members null, and its exception cleared
+	JVM.MissingClass = "android/view/DisplayCutout";
+
+	xyJNICache Partial;
+	xyLoadJNICache( pEnv, Activity, Partial );
+
+	Passed &= Check( !Partial.DisplayCutoutGetSafeInsetLeft && !Partial.DisplayCutoutGetSafeInsetBottom, "members of a missing class are null" );
+	Passed &= Check( Partial.DisplayGetCutout && Partial.BatteryManager && Partial.FutureTaskGet, "members of other classes still resolve" );
+	Passed &= Check( JVM.Misuses == 0 && !JVM.Pending, "the missing class does not leave an exception pending" );
+
+	JVM.MissingClass.clear();
+
+	// Both queries must agree before their timings mean anything
+	uint8_t    UncachedCapacity = 0;
+	uint8_t    CachedCapacity   = 0;
+	const bool UncachedCharging = QueryBatteryUncached( pEnv, Activity, UncachedCapacity );
+	const bool CachedCharging   = QueryBatteryCached( pEnv, Cache, CachedCapacity );
+
+	Passed &= Check( UncachedCapacity == 80 && CachedCapacity == 80 && UncachedCharging && CachedCharging, "both queries report 80 percent, charging" );
+
+	if( !Passed )
+		return 1;
+
+	JVM.LookupCost = std::chrono::nanoseconds( Args.size() > 2 ? std::strtoll( Args[ 2 ], nullptr, 10 ) : 1000 );
+	JVM.CallCost   = std::chrono::nanoseconds( Args.size() > 3 ? std::strtoll( Args[ 3 ], nullptr, 10 ) : 100 );
+
+	uint8_t Capacity;
+
+	const double   UncachedTime    = Measure( Iterations, [ & ] { QueryBatteryUncached( pEnv, Activity, Capacity ); } );
+	const uint64_t UncachedLookups = JVM.Lookups;
+	const uint64_t UncachedCalls   = JVM.Calls;
+	const double   CachedTime      = Measure( Iterations, [ & ] { QueryBatteryCached( pEnv, Cache, Capacity ); } );
+	const uint64_t CachedLookups   = JVM.Lookups;
+	const uint64_t CachedCalls     = JVM.Calls;
+
+	std::printf( "Lookup cost %lld ns, call cost %lld ns, %zu iterations\n", static_cast< long long >( JVM.LookupCost.count() ), static_cast< long long >( JVM.CallCost.count() ), Iterations );
+	std::printf( "%-10s %12s %12s %12s\n", "Battery", "ns/query", "lookups", "calls" );
+	std::printf( "%-10s %12.0f %12.1f %12.1f\n", "Uncached", UncachedTime, static_cast< double >( UncachedLookups ) / Iterations, static_cast< double >( UncachedCalls ) / Iterations );
+	std::printf( "%-10s %12.0f %12.1f %12.1f\n", "Cached",   CachedTime,   static_cast< double >( CachedLookups ) / Iterations,   static_cast< double >( CachedCalls ) / Iterations );
+
+	return 0;
+
+} // xyMain
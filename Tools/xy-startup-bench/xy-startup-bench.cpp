@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2021 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * xy-startup-bench: Launches itself repeatedly and checks the time it takes to reach xyMain against a budget, using xyGetStartupProfile.
+ * Exits with 1 if the median startup time is over budget, so that it can fail a build.
+ *
+ * Usage: xy-startup-bench [budget in milliseconds] [number of launches]
+ * The budget covers the time before the entry point as well, on platforms that report it.
+ */
+
+#define XY_IMPLEMENT
+#include <xy-main.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined( XY_OS_WINDOWS )
+#define popen  _popen
+#define pclose _pclose
+#endif // XY_OS_WINDOWS
+
+// Passed to the launched copies, which only report their own profile
+static const char* pChildArgument = "--child";
+
+struct Sample
+{
+	std::chrono::nanoseconds BeforeEntry;
+	std::chrono::nanoseconds ToMain;
+
+}; // Sample
+
+//////////////////////////////////////////////////////////////////////////
+
+static double Milliseconds( std::chrono::nanoseconds Time )
+{
+	return std::chrono::duration< double, std::milli >( Time ).count();
+
+} // Milliseconds
+
+//////////////////////////////////////////////////////////////////////////
+
+static std::chrono::nanoseconds Median( std::vector< std::chrono::nanoseconds > Times )
+{
+	std::nth_element( Times.begin(), Times.begin() + Times.size() / 2, Times.end() );
+
+	return Times[ Times.size() / 2 ];
+
+} // Median
+
+//////////////////////////////////////////////////////////////////////////
+
+static std::optional< Sample > Launch( const char* pExecutable )
+{
+	const std::string Command = std::string( "\"" ) + pExecutable + "\" " + pChildArgument;
+	FILE*             pPipe   = popen( Command.c_str(), "r" );
+	if( !pPipe )
+		return std::nullopt;
+
+	long long BeforeEntry = 0;
+	long long ToMain      = 0;
+	const int Fields      = std::fscanf( pPipe, "%lld %lld", &BeforeEntry, &ToMain );
+
+	if( pclose( pPipe ) != 0 || Fields != 2 )
+		return std::nullopt;
+
+	return Sample{ .BeforeEntry=std::chrono::nanoseconds( BeforeEntry ), .ToMain=std::chrono::nanoseconds( ToMain ) };
+
+} // Launch
+
+//////////////////////////////////////////////////////////////////////////
+
+int xyMain( void )
+{
+	const std::span< char* > Args = xyGetContext().CommandLineArgs;
+
+	if( Args.size() > 1 && std::strcmp( Args[ 1 ], pChildArgument ) == 0 )
+	{
+		const xyStartupProfile Profile = xyGetStartupProfile();
+
+		// Platforms that don't report the process creation time contribute nothing before the entry point
+		std::printf( "%lld %lld\n", static_cast< long long >( Profile.BeforeEntry.value_or( std::chrono::nanoseconds( 0 ) ).count() ), static_cast< long long >( Profile.ToMain.count() ) );
+		return 0;
+	}
+
+	const auto Budget   = std::chrono::microseconds( static_cast< int64_t >( ( Args.size() > 1 ? std::atof( Args[ 1 ] ) : 50.0 ) * 1000.0 ) );
+	const int  Launches = Args.size() > 2 ? std::max( std::atoi( Args[ 2 ] ), 1 ) : 20;
+
+	std::vector< std::chrono::nanoseconds > BeforeEntry;
+	std::vector< std::chrono::nanoseconds > ToMain;
+	std::vector< std::chrono::nanoseconds > Total;
+
+	for( int Index = 0; Index < Launches; ++Index )
+	{
+		const std::optional< Sample > Result = Launch( Args[ 0 ] );
+		if( !Result )
+		{
+			std::fprintf( stderr, "Could not launch '%s'\n", Args[ 0 ] );
+			return 1;
+		}
+
+		BeforeEntry.push_back( Result->BeforeEntry );
+		ToMain.push_back( Result->ToMain );
+		Total.push_back( Result->BeforeEntry + Result->ToMain );
+	}
+
+	const std::chrono::nanoseconds MedianTotal = Median( Total );
+
+	std::printf( "Median of %d launches:\n", Launches );
+	std::printf( "  Before the entry point %8.3f ms\n", Milliseconds( Median( BeforeEntry ) ) );
+	std::printf( "  Entry point to xyMain  %8.3f ms\n", Milliseconds( Median( ToMain ) ) );
+	std::printf( "  Total                  %8.3f ms (budget %.3f ms)\n", Milliseconds( MedianTotal ), Milliseconds( Budget ) );
+
+	if( MedianTotal > Budget )
+	{
+		std::printf( "Over budget\n" );
+		return 1;
+	}
+
+	return 0;
+
+} // xyMain
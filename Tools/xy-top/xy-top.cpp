@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2021 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * xy-top: Displays the live telemetry of a process that called xyStartTelemetry.
+ *
+ * Usage: xy-top [name or process ID] [refresh interval in milliseconds]
+ * Without arguments, the available segments are listed.
+ */
+
+#define XY_IMPLEMENT
+#include <xy-main.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+//////////////////////////////////////////////////////////////////////////
+
+static const char* TierName( xyPerformanceTier Tier )
+{
+	switch( Tier )
+	{
+		case xyPerformanceTier::Full:     return "Full";
+		case xyPerformanceTier::Balanced: return "Balanced";
+		case xyPerformanceTier::Reduced:  return "Reduced";
+		case xyPerformanceTier::Minimal:  return "Minimal";
+		default:                          return "?";
+	}
+
+} // TierName
+
+//////////////////////////////////////////////////////////////////////////
+
+static void Print( const xyTelemetrySnapshot& rSnapshot, const xyTelemetrySnapshot& rPrevious )
+{
+	const double Seconds = std::chrono::duration< double >( rSnapshot.Uptime ).count();
+	const double Elapsed = std::chrono::duration< double >( rSnapshot.Uptime - rPrevious.Uptime ).count();
+
+	// Clear the screen and move the cursor home
+	std::printf( "\x1B[2J\x1B[H" );
+	std::printf( "Process %u    Uptime %.1f s    Updates %llu\n\n", rSnapshot.ProcessID, Seconds, static_cast< unsigned long long >( rSnapshot.Updates ) );
+
+	if( rSnapshot.Battery ) std::printf( "Battery      %u%%%s\n", rSnapshot.Battery.CapacityPercentage, rSnapshot.Battery.Charging ? " (charging)" : "" );
+	else                    std::printf( "Battery      -\n" );
+
+	if( rSnapshot.Temperature ) std::printf( "Temperature  %.1f C (status %d)\n", *rSnapshot.Temperature, static_cast< int >( rSnapshot.ThermalStatus ) );
+	else                        std::printf( "Temperature  -\n" );
+
+	std::printf( "Tier         %s\n\n", TierName( rSnapshot.Tier ) );
+	std::printf( "Log backlog  %llu bytes, %llu dropped\n", static_cast< unsigned long long >( rSnapshot.LogBacklog ), static_cast< unsigned long long >( rSnapshot.LogDropped ) );
+	std::printf( "File I/O     %u pending\n", rSnapshot.PendingFileRequests );
+	std::printf( "Config       %u pending\n", rSnapshot.PendingConfigurationChanges );
+
+	if( !rSnapshot.Counters.empty() )
+	{
+		std::printf( "\n%-32s %16s %12s\n", "COUNTER", "VALUE", "PER SECOND" );
+
+		for( const xyTelemetryCounter& rCounter : rSnapshot.Counters )
+		{
+			auto   It   = std::find_if( rPrevious.Counters.begin(), rPrevious.Counters.end(), [ & ]( const xyTelemetryCounter& rOther ) { return rOther.Name == rCounter.Name; } );
+			double Rate = ( It != rPrevious.Counters.end() && Elapsed > 0.0 ) ? ( rCounter.Value - It->Value ) / Elapsed : 0.0;
+
+			std::printf( "%-32s %16lld %12.1f\n", rCounter.Name.c_str(), static_cast< long long >( rCounter.Value ), Rate );
+		}
+	}
+
+	if( !rSnapshot.Threads.empty() )
+	{
+		std::printf( "\n%8s %-16s %5s %10s %6s\n", "TID", "THREAD", "STATE", "CPU (s)", "CPU %" );
+
+		for( const xyTelemetryThread& rThread : rSnapshot.Threads )
+		{
+			auto   It    = std::find_if( rPrevious.Threads.begin(), rPrevious.Threads.end(), [ & ]( const xyTelemetryThread& rOther ) { return rOther.ID == rThread.ID; } );
+			double Usage = ( It != rPrevious.Threads.end() && Elapsed > 0.0 ) ? 100.0 * std::chrono::duration< double >( rThread.CpuTime - It->CpuTime ).count() / Elapsed : 0.0;
+
+			std::printf( "%8u %-16s %5c %10.2f %6.1f\n", rThread.ID, rThread.Name.c_str(), rThread.State, std::chrono::duration< double >( rThread.CpuTime ).count(), Usage );
+		}
+	}
+
+	std::fflush( stdout );
+
+} // Print
+
+//////////////////////////////////////////////////////////////////////////
+
+int xyMain( void )
+{
+	const std::span< char* > Args = xyGetContext().CommandLineArgs;
+
+	if( Args.size() < 2 )
+	{
+		const std::vector< std::string > Names = xyListTelemetry();
+
+		std::printf( Names.empty() ? "No telemetry segments found\n" : "Telemetry segments:\n" );
+		for( const std::string& rName : Names )
+			std::printf( "  %s\n", rName.c_str() );
+
+		return 0;
+	}
+
+	xyTelemetryView View = xyOpenTelemetry( Args[ 1 ] );
+	if( !View )
+	{
+		std::fprintf( stderr, "Could not open telemetry segment '%s'\n", Args[ 1 ] );
+		return 1;
+	}
+
+	const auto          Interval = std::chrono::milliseconds( Args.size() > 2 ? std::atoi( Args[ 2 ] ) : 1000 );
+	xyTelemetrySnapshot Previous;
+	xyTelemetrySnapshot Snapshot;
+
+	// The process removes the segment when it stops, but a mapping that is already open stays valid. Give up once the updates stop for a while.
+	auto LastChange = std::chrono::steady_clock::now();
+
+	while( xyReadTelemetry( View, Snapshot ) && std::chrono::steady_clock::now() - LastChange < std::chrono::seconds( 10 ) )
+	{
+		if( Snapshot.Updates != Previous.Updates )
+		{
+			Print( Snapshot, Previous );
+
+			LastChange = std::chrono::steady_clock::now();
+			Previous   = Snapshot;
+		}
+
+		std::this_thread::sleep_for( std::max( Interval, std::chrono::milliseconds( 100 ) ) );
+	}
+
+	std::printf( "\nProcess %u stopped publishing\n", Snapshot.ProcessID );
+
+	return 0;
+
+} // xyMain